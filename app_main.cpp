@@ -25,22 +25,28 @@ Toute la logique input est dans task_input.cpp
 #include "lib/audio_sfx.h"
 #include "lib/audio_player.h"
 #include "lib/audio_sfx_cache.h"
+#ifdef USE_WIFI
+#include "lib/app_wifi.h"
+#endif
 
 // Core
 #include "core/input.h"
 #include "core/graphics.h"
 #include "core/audio.h"
 #include "core/persist.h"
+#include "core/telemetry.h"
 
 // Game
 #include "game/game.h"
 #include "game/level.h"
+#include "game/level_pack.h"
 #include "assets/assets.h"
 
 // Tasks
 #include "tasks/task_game.h"
 #include "tasks/task_audio.h"
 #include "tasks/task_input.h"
+#include "tasks/task_telemetry.h"
 
 // Tests (optionnel)
 #include "tests/tests.h"
@@ -67,6 +73,7 @@ static void hardware_init()
 
     input_init();
     assets_init();
+    level_pack_open();
     highscores_init();
 }
 
@@ -82,7 +89,14 @@ extern "C" void app_main(void)
     // --- Création des tâches ---
     xTaskCreatePinnedToCore(task_game,  "GameTask",  8192, NULL, 5, NULL, 1);
     // xTaskCreatePinnedToCore(task_audio, "AudioTask", 8192, NULL, 6, NULL, 0);
-    xTaskCreatePinnedToCore(task_input, "InputTask", 2048, NULL, 4, NULL, 1);
+    xTaskCreatePinnedToCore(task_input, "InputTask", 3072, NULL, 4, NULL, 1);
+
+#if defined(USE_WIFI) && defined(USE_TELEMETRY)
+    // Télémétrie : point d'accès WiFi + mesures UDP (tools/telemetry_viewer.cpp)
+    wifi_init_softap();
+    if (telemetry_start(nullptr, TelemetryFormat::Binary))
+        xTaskCreatePinnedToCore(task_telemetry, "TelemetryTask", 3072, NULL, 1, NULL, 0);
+#endif
 
 #ifdef ENABLE_TESTS
     xTaskCreatePinnedToCore(task_tests, "TestsTask", 4096, NULL, 1, NULL, 1);
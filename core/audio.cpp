@@ -8,12 +8,15 @@
 #include "lib/audio_pmf.h"
 #include "lib/audio_track_sfx.h"
 #include "lib/audio_sfx_cache.h"
+#include "lib/audio_wav.h"
 
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/i2s_std.h"
 #include "esp_log.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -52,15 +55,14 @@ static void delay_ms(uint32_t milliseconds)
 
 static void audio_task(void* arg)
 {
-    const int period_ms =
-        (1000 * GB_AUDIO_BUFFER_SAMPLE_COUNT) / GB_AUDIO_SAMPLE_RATE;
-
-    TickType_t last = xTaskGetTickCount();
+    // Deux périodes DAC sans notification : on rend la main quand même
+    const uint32_t timeout_ms =
+        2 * (1000 * GB_AUDIO_BUFFER_SAMPLE_COUNT) / GB_AUDIO_SAMPLE_RATE;
 
     while (true)
     {
-        audio_update();
-        vTaskDelayUntil(&last, pdMS_TO_TICKS(period_ms));
+        audio_render_to_target();
+        audio_wait_fifo_space(timeout_ms);
     }
 }
 
@@ -94,8 +96,9 @@ static uint32_t g_fifo_read_index  = 0;
 static uint32_t g_fifo_write_index = 0;
 
 // Statistiques FIFO
-static uint16_t g_buffer_miss_count     = 0; // nombre de fois où la FIFO était vide
-static uint16_t g_buffer_overflow_count = 0; // nombre de fois où la FIFO était pleine
+static volatile uint32_t g_buffer_miss_count     = 0; // nombre de fois où la FIFO était vide
+static volatile uint32_t g_buffer_overflow_count = 0; // nombre de fois où la FIFO était pleine
+static volatile uint32_t g_fifo_hist[GB_AUDIO_BUFFER_FIFO_COUNT + 1]; // niveau vu par l'I2S
 
 // Etat du test audio (cos44100)
 static bool     g_audio_test_enabled = false;
@@ -104,7 +107,16 @@ static float    g_cos_pitch_factor   = 256.0f / 4.0f;
 static uint16_t g_cos_pitch_step     = 0; // pas de phase
 
 // Compteur I2S pour debug (nombre d’appels du callback)
-static int g_i2s_callback_count = 0;
+static volatile uint32_t g_i2s_callback_count = 0;
+
+// Coûts de audio_update() (écrits par la tâche audio uniquement)
+static uint32_t        g_update_count = 0;
+static AudioCycleStats g_update_cycles;
+static AudioCycleStats g_stage_cycles[AUDIO_STAGE_COUNT];
+
+// Tâche réveillée par i2s_callback quand la FIFO passe sous le niveau visé
+static TaskHandle_t      g_audio_task_handle = nullptr;
+static volatile uint32_t g_fifo_fill_target  = GB_AUDIO_FIFO_FILL_TARGET;
 
 // -----------------------------------------------------------------------------
 // Mixeur : audio_player + pistes internes
@@ -144,8 +156,8 @@ static inline uint32_t fifo_free_samples()
 void wav_pool_update()
 {
     // Anciennement : remplissage de la FIFO à partir d’un WAV “global”.
-    // Maintenant : chaque piste (notamment audio_track_wav) lit ses données
-    // directement depuis FILE* et le mixeur produit un buffer mixé unique.
+    // Maintenant : audio_track_wav consomme des blocs lus par sa tâche de
+    // streaming (audio_stream) et le mixeur produit un buffer mixé unique.
 }
 
 // Pousse un buffer mixé dans la FIFO
@@ -185,6 +197,141 @@ uint32_t audio_fifo_buffer_free(void)
     return audio_fifo_buffer_count() - audio_fifo_buffer_used();
 }
 
+void audio_set_fifo_fill_target(uint32_t buffers)
+{
+    if (buffers < 1) buffers = 1;
+    if (buffers > GB_AUDIO_BUFFER_FIFO_COUNT) buffers = GB_AUDIO_BUFFER_FIFO_COUNT;
+    g_fifo_fill_target = buffers;
+}
+
+uint32_t audio_get_fifo_fill_target(void)
+{
+    return g_fifo_fill_target;
+}
+
+uint32_t audio_render_to_target(void)
+{
+    uint32_t rendered = 0;
+
+    // Jamais plus que la place libre : audio_push_buffer ne perd rien
+    while (audio_fifo_buffer_used() < g_fifo_fill_target &&
+           audio_fifo_buffer_free() > 0)
+    {
+        audio_update();
+        rendered++;
+    }
+    return rendered;
+}
+
+void audio_wait_fifo_space(uint32_t timeout_ms)
+{
+    // La première tâche qui attend devient la tâche notifiée par l'I2S
+    if (!g_audio_task_handle)
+        g_audio_task_handle = xTaskGetCurrentTaskHandle();
+
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+}
+
+// -----------------------------------------------------------------------------
+// Statistiques du moteur audio
+// -----------------------------------------------------------------------------
+
+static inline void cycle_stats_add(AudioCycleStats& st, uint32_t cycles)
+{
+    st.last = cycles;
+    if (st.avg == 0)
+        st.avg = cycles;
+    else
+        st.avg += ((int32_t)(cycles - st.avg)) >> 4;   // moyenne glissante 1/16
+    if (cycles > st.max)
+        st.max = cycles;
+}
+
+void audio_get_stats(AudioStats* out)
+{
+    if (!out)
+        return;
+
+    // Lecture sans verrou : valeurs de debug, une incohérence d'un buffer
+    // entre deux champs est sans importance
+    out->update_count = g_update_count;
+    out->update = g_update_cycles;
+    for (int i = 0; i < AUDIO_STAGE_COUNT; i++)
+        out->stage[i] = g_stage_cycles[i];
+    out->budget_cycles = (uint32_t)((uint64_t)CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000ULL *
+                                    GB_AUDIO_BUFFER_SAMPLE_COUNT / GB_AUDIO_SAMPLE_RATE);
+
+    for (int i = 0; i <= GB_AUDIO_BUFFER_FIFO_COUNT; i++)
+        out->fifo_hist[i] = g_fifo_hist[i];
+    out->i2s_callbacks    = g_i2s_callback_count;
+    out->underruns        = g_buffer_miss_count;
+    out->overflows        = g_buffer_overflow_count;
+    out->stream_underruns = g_track_wav.underrun_count();
+
+    out->voices_sfx   = (uint8_t)g_track_sfx.active_count();
+    out->sfx_coalesced = g_track_sfx.coalesced_count();
+    out->sfx_stolen    = g_track_sfx.stolen_count();
+    out->sfx_dropped   = g_track_sfx.dropped_count();
+    out->voices_music = audioPMF.activeVoices();
+    out->voices_other = (uint8_t)(g_track_tone.is_active() +
+                                  g_track_noise.is_active() +
+                                  g_track_wav.is_active());
+}
+
+void audio_reset_stats(void)
+{
+    // Les maxima et l'histogramme repartent de zéro, les moyennes continuent
+    for (int i = 0; i < AUDIO_STAGE_COUNT; i++)
+        g_stage_cycles[i].max = 0;
+    g_update_cycles.max = 0;
+    for (int i = 0; i <= GB_AUDIO_BUFFER_FIFO_COUNT; i++)
+        g_fifo_hist[i] = 0;
+    g_buffer_miss_count     = 0;
+    g_buffer_overflow_count = 0;
+}
+
+const char* audio_stage_name(int stage)
+{
+    switch (stage)
+    {
+        case AUDIO_STAGE_SFX:  return "sfx";
+        case AUDIO_STAGE_PMF:  return "pmf";
+        case AUDIO_STAGE_POST: return "post";
+        default:               return "?";
+    }
+}
+
+void audio_log_stats(void)
+{
+    AudioStats st;
+    audio_get_stats(&st);
+
+    uint32_t budget = st.budget_cycles ? st.budget_cycles : 1;
+    printf("AUDIO: %lu updates, avg %lu cyc (%lu.%lu%%), max %lu cyc, fill target %lu\n",
+           (unsigned long)st.update_count, (unsigned long)st.update.avg,
+           (unsigned long)(st.update.avg * 100ULL / budget),
+           (unsigned long)(st.update.avg * 1000ULL / budget % 10),
+           (unsigned long)st.update.max, (unsigned long)audio_get_fifo_fill_target());
+
+    for (int i = 0; i < AUDIO_STAGE_COUNT; i++)
+        printf("AUDIO:   %-4s avg %7lu  max %7lu\n", audio_stage_name(i),
+               (unsigned long)st.stage[i].avg, (unsigned long)st.stage[i].max);
+
+    printf("AUDIO: FIFO");
+    for (int i = 0; i <= GB_AUDIO_BUFFER_FIFO_COUNT; i++)
+        printf(" %d:%lu", i, (unsigned long)st.fifo_hist[i]);
+    printf("\n");
+
+    printf("AUDIO: underruns %lu, overflows %lu, stream underruns %lu, i2s %lu\n",
+           (unsigned long)st.underruns, (unsigned long)st.overflows,
+           (unsigned long)st.stream_underruns, (unsigned long)st.i2s_callbacks);
+    printf("AUDIO: voices sfx %u, music %u, other %u\n",
+           st.voices_sfx, st.voices_music, st.voices_other);
+    printf("AUDIO: sfx coalesced %lu, stolen %lu, dropped %lu\n",
+           (unsigned long)st.sfx_coalesced, (unsigned long)st.sfx_stolen,
+           (unsigned long)st.sfx_dropped);
+}
+
 // -----------------------------------------------------------------------------
 // Mode test audio : activation/désactivation de la génération cos44100
 // -----------------------------------------------------------------------------
@@ -267,7 +414,18 @@ IRAM_ATTR bool i2s_callback(i2s_chan_handle_t handle,
         memset(samples, 0, sample_count * sizeof(int16_t));
     }
 
-    return true;
+    // Histogramme du niveau restant (en buffers entiers)
+    g_fifo_hist[fifo_used_samples() / GB_AUDIO_BUFFER_SAMPLE_COUNT]++;
+
+    // Réveil de la tâche audio seulement si un buffer manque
+    BaseType_t woken = pdFALSE;
+    if (g_audio_task_handle &&
+        fifo_used_samples() < g_fifo_fill_target * GB_AUDIO_BUFFER_SAMPLE_COUNT)
+    {
+        vTaskNotifyGiveFromISR(g_audio_task_handle, &woken);
+    }
+
+    return woken == pdTRUE;
 }
 
 // -----------------------------------------------------------------------------
@@ -468,6 +626,9 @@ int audio_init()
     g_track_wav.target_pitch = 1.0f;
     g_track_wav.pitch_smooth = 0.15f;
 
+    // Lecture SD des WAV en streaming : tâche dédiée, le mixeur ne lit jamais la carte
+    g_track_wav.init_streaming(4, 0);
+
     // Ordre des pistes dans TON moteur
     s_audio_player.add_track(&g_track_tone);
     s_audio_player.add_track(&g_track_noise);
@@ -509,25 +670,9 @@ int audio_init()
 
 
 // -----------------------------------------------------------------------------
-// Lecture de fichiers WAV (PCM 16 bits mono, 44.1 kHz) via audio_track_wav
+// Lecture de fichiers WAV (tout PCM, converti en 16 bits mono natif) via audio_track_wav
 // -----------------------------------------------------------------------------
 
-struct WavHeader {
-    char     riff[4];        // "RIFF"
-    uint32_t chunkSize;
-    char     wave[4];        // "WAVE"
-    char     fmt[4];         // "fmt "
-    uint32_t subchunk1Size;  // 16 pour PCM
-    uint16_t audioFormat;    // 1 = PCM
-    uint16_t numChannels;    // 1 = mono, 2 = stéréo
-    uint32_t sampleRate;     // ex: 44100
-    uint32_t byteRate;
-    uint16_t blockAlign;
-    uint16_t bitsPerSample;  // ex: 16
-    char     data[4];        // "data"
-    uint32_t dataSize;
-};
-
 void audio_play_wav(const char* path)
 {
     FILE* f = fopen(path, "rb");
@@ -536,47 +681,16 @@ void audio_play_wav(const char* path)
         return;
     }
 
-    WavHeader header{};
-    if (fread(&header, sizeof(WavHeader), 1, f) != 1) {
-        printf("Lecture entête WAV échouée\n");
-        fclose(f);
-        return;
-    }
-
-    // Vérifications de base
-    if (strncmp(header.riff, "RIFF", 4) != 0 || strncmp(header.wave, "WAVE", 4) != 0) {
-        printf("Fichier %s n’est pas un WAV valide\n", path);
-        fclose(f);
-        return;
-    }
-    if (header.audioFormat != 1) {
-        printf("Format non PCM (%u)\n", (unsigned)header.audioFormat);
-        fclose(f);
-        return;
-    }
-    if (header.numChannels != 1) {
-        printf("Seulement mono supporté (channels=%u)\n", (unsigned)header.numChannels);
-        fclose(f);
-        return;
-    }
-    if (header.bitsPerSample != 16) {
-        printf("Seulement 16 bits supportés (%u)\n", (unsigned)header.bitsPerSample);
-        fclose(f);
-        return;
-    }
-    if (header.sampleRate != GB_AUDIO_SAMPLE_RATE) {
-        printf("SampleRate %u non supporté (attendu %u)\n",
-               (unsigned)header.sampleRate,
-               (unsigned)GB_AUDIO_SAMPLE_RATE);
+    // Parcours des chunks RIFF ; 8/24 bits, stéréo et autres fréquences
+    // sont convertis par bloc par le décodeur de la piste
+    wav_info info;
+    if (!wav_parse_header(f, &info, path)) {
         fclose(f);
         return;
     }
 
-    // Nombre total d’échantillons 16 bits
-    uint32_t total_samples = header.dataSize / sizeof(int16_t);
-
     // Lancer le streaming WAV sur la piste dédiée
-    g_track_wav.start(f, total_samples);
+    g_track_wav.start(f, info);
 
     // Reset du pitch pour ce son
     g_track_wav.pitch        = 1.0f;
@@ -593,6 +707,8 @@ void audio_update(void)
     int16_t mix_sfx[GB_AUDIO_BUFFER_SAMPLE_COUNT];
     int16_t mix_music[GB_AUDIO_BUFFER_SAMPLE_COUNT];
 
+    const uint32_t t_start = esp_cpu_get_cycle_count();
+
     // 1) Mixeur interne (WAV + SFX)
     s_audio_player.mix(mix_sfx, GB_AUDIO_BUFFER_SAMPLE_COUNT);
 
@@ -601,6 +717,8 @@ void audio_update(void)
         mix_sfx[i] = (mix_sfx[i] * g_audio_settings.sfx_volume) >> 8;
 	}	
 
+	const uint32_t t_sfx = esp_cpu_get_cycle_count();
+
 	// 3) Musique PMF dans un buffer séparé
 	memset(mix_music, 0, sizeof(mix_music));
 	if (g_audio_settings.music_enabled){
@@ -608,6 +726,8 @@ void audio_update(void)
 	} else {
 		audioPMF.stop();
 	}
+
+	const uint32_t t_pmf = esp_cpu_get_cycle_count();
 	
 	// 3.B Lissage anti pops and crashs
 	static int16_t prev_sample = 0;
@@ -688,6 +808,14 @@ void audio_update(void)
 
     // 8) Envoi FIFO
     audio_push_buffer(mix_final);
+
+    // 9) Statistiques (cycles du core courant, la tâche audio est épinglée)
+    const uint32_t t_end = esp_cpu_get_cycle_count();
+    cycle_stats_add(g_stage_cycles[AUDIO_STAGE_SFX],  t_sfx - t_start);
+    cycle_stats_add(g_stage_cycles[AUDIO_STAGE_PMF],  t_pmf - t_sfx);
+    cycle_stats_add(g_stage_cycles[AUDIO_STAGE_POST], t_end - t_pmf);
+    cycle_stats_add(g_update_cycles, t_end - t_start);
+    g_update_count++;
 }
 
 
@@ -697,10 +825,9 @@ void audio_update(void)
 
 void audio_play_pacgomme()
 {
-    const int16_t* data;
-    uint32_t len;
-    if (sfx_cache_load("/sdcard/PAKAMAN/Sons/PACGOMME.wav", &data, &len))
-        g_track_sfx.play(data, len, 20, 1.0f, 1.0f);
+    sfx_source src;
+    if (sfx_cache_source(SFX_PACGOMME, &src))
+        g_track_sfx.play(src, 20, 1.0f, 1.0f, SFX_CAT_PELLET);
 
     g_music_duck_target = 0.80f;
 }
@@ -708,10 +835,9 @@ void audio_play_pacgomme()
 
 void audio_play_power()
 {
-    const int16_t* data;
-    uint32_t len;
-    if (sfx_cache_load("/sdcard/PAKAMAN/Sons/BONUS.wav", &data, &len))
-        g_track_sfx.play(data, len, 60, 1.0f, 1.0f);
+    sfx_source src;
+    if (sfx_cache_source(SFX_BONUS, &src))
+        g_track_sfx.play(src, 60, 1.0f, 1.0f, SFX_CAT_JINGLE);
 
     g_music_duck_target = 0.50f;
 }
@@ -719,10 +845,9 @@ void audio_play_power()
 
 void audio_play_eatghost()
 {
-    const int16_t* data;
-    uint32_t len;
-    if (sfx_cache_load("/sdcard/PAKAMAN/Sons/G_EATEN.wav", &data, &len))
-        g_track_sfx.play(data, len, 80, 1.0f, 1.0f);
+    sfx_source src;
+    if (sfx_cache_source(SFX_G_EATEN, &src))
+        g_track_sfx.play(src, 80, 1.0f, 1.0f, SFX_CAT_GHOST);
 
     g_music_duck_target = 0.35f; // baisse forte
 }
@@ -760,14 +885,31 @@ bool audio_wav_is_playing(void)
 
 void audio_sfx_play(const char* path, int priority)
 {
-    const int16_t* data = nullptr;
-    uint32_t len = 0;
+    // Hachage du chemin : préférer audio_sfx_play_id() sur le chemin critique
+    audio_sfx_play_id(sfx_cache_register(path), priority);
+}
+
+
+// Catégorie d'ordonnancement d'un SFX de la banque (UI par défaut)
+static SfxCategory sfx_category_of(int16_t id)
+{
+    switch (id)
+    {
+        case SFX_PACGOMME: return SFX_CAT_PELLET;
+        case SFX_BONUS:    return SFX_CAT_JINGLE;
+        case SFX_G_EATEN:  return SFX_CAT_GHOST;
+        default:           return SFX_CAT_UI;
+    }
+}
 
-    if (!sfx_cache_load(path, &data, &len))
+void audio_sfx_play_id(int16_t id, int priority)
+{
+    sfx_source src;
+    if (!sfx_cache_source(id, &src))
         return;
 
     // Volume et pitch neutres, priorité passée en paramètre
-    g_track_sfx.play(data, len, priority, 1.0f, 1.0f);
+    g_track_sfx.play(src, priority, 1.0f, 1.0f, sfx_category_of(id));
 }
 
 
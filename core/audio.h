@@ -18,6 +18,7 @@ extern "C" {
 #define GB_AUDIO_BUFFER_SAMPLE_COUNT    512    // taille d’un buffer (en samples 16 bits)
 // #define GB_AUDIO_SAMPLE_RATE            44100  // fréquence d’échantillonnage
 #define GB_AUDIO_SAMPLE_RATE            22050
+#define GB_AUDIO_FIFO_FILL_TARGET       3      // buffers gardés pleins d'avance (1..FIFO_COUNT)
 
 // -----------------------------------------------------------------------------
 // Configuration des réglages de volumr
@@ -54,6 +55,57 @@ uint32_t audio_fifo_buffer_count(void);            // nombre total de buffers FI
 uint32_t audio_fifo_buffer_used(void);             // nombre de buffers utilisés
 uint32_t audio_fifo_buffer_free(void);             // nombre de buffers libres
 
+// Niveau de remplissage visé par la tâche audio (en buffers, borné à
+// 1..GB_AUDIO_BUFFER_FIFO_COUNT). Plus haut = plus de marge, plus de latence.
+void audio_set_fifo_fill_target(uint32_t buffers);
+uint32_t audio_get_fifo_fill_target(void);
+
+// -----------------------------------------------------------------------------
+// Statistiques du moteur audio (page debug, console)
+// -----------------------------------------------------------------------------
+// Coûts en cycles CPU mesurés par audio_update() ; moyenne glissante (1/16)
+// et maximum depuis le dernier audio_reset_stats(). Histogramme FIFO relevé
+// à chaque callback I2S : fifo_hist[n] = nombre de fois où n buffers restaient.
+
+enum AudioStage {
+    AUDIO_STAGE_SFX = 0,    // mixeur interne (WAV + SFX) + volume SFX
+    AUDIO_STAGE_PMF,        // musique PMF (live ou copie du pré-rendu)
+    AUDIO_STAGE_POST,       // lissage, ducking, fusion, master, limiteur
+    AUDIO_STAGE_COUNT
+};
+
+struct AudioCycleStats {
+    uint32_t last;
+    uint32_t avg;
+    uint32_t max;
+};
+
+struct AudioStats {
+    uint32_t        update_count;                  // appels à audio_update()
+    AudioCycleStats update;                        // audio_update() complet
+    AudioCycleStats stage[AUDIO_STAGE_COUNT];
+    uint32_t        budget_cycles;                 // cycles disponibles par buffer
+
+    uint32_t fifo_hist[GB_AUDIO_BUFFER_FIFO_COUNT + 1];
+    uint32_t i2s_callbacks;
+    uint32_t underruns;                            // FIFO vide : silence envoyé au DAC
+    uint32_t overflows;                            // FIFO pleine : buffer perdu
+    uint32_t stream_underruns;                     // bloc WAV pas prêt (lecture SD)
+
+    uint8_t  voices_sfx;                           // SFX actifs
+    uint8_t  voices_music;                         // canaux PMF mixés (hors muets)
+    uint8_t  voices_other;                         // tone / noise / WAV
+
+    uint32_t sfx_coalesced;                        // redéclenchements regroupés
+    uint32_t sfx_stolen;                           // voix coupées pour une autre
+    uint32_t sfx_dropped;                          // SFX refusés (plafond, priorité)
+};
+
+void audio_get_stats(AudioStats* out);
+void audio_reset_stats(void);
+void audio_log_stats(void);                        // résumé sur la console
+const char* audio_stage_name(int stage);
+
 // -----------------------------------------------------------------------------
 // Lecture WAV (robuste, avec parsing d’entête)
 // -----------------------------------------------------------------------------
@@ -65,6 +117,11 @@ bool audio_wav_is_playing(void);
 // -----------------------------------------------------------------------------
 void audio_sfx_play(const char* path, int priority);
 
+// Variante par handle (cf. sfx_cache_register / SfxId) : aucun accès
+// par chemin, à utiliser pour les déclencheurs fréquents. La catégorie
+// (plafond de voix, regroupement) est déduite de l'identifiant.
+void audio_sfx_play_id(int16_t id, int priority);
+
 // -----------------------------------------------------------------------------
 // Fonctions utilitaires pour Pac-Man (s'appuient sur audio_play_wav)
 // -----------------------------------------------------------------------------
@@ -86,6 +143,15 @@ void audio_play_begin(void);
 // dans la FIFO via audio_push_buffer().
 void audio_update(void);
 
+// Boucle de la tâche audio, pilotée par l'horloge du DAC :
+// - audio_render_to_target() appelle audio_update() autant de fois que
+//   nécessaire pour atteindre le niveau de remplissage visé (retourne le
+//   nombre de buffers produits) ;
+// - audio_wait_fifo_space() endort la tâche appelante jusqu'à ce que
+//   i2s_callback libère un buffer sous ce niveau (notification de tâche).
+uint32_t audio_render_to_target(void);
+void audio_wait_fifo_space(uint32_t timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,180 @@
+#include "draw_list.h"
+#include "frame_arena.h"
+#include "game/config.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+/*
+============================================================
+  ÉTAT
+============================================================
+*/
+static DrawCmd* s_cmds    = nullptr;     // arena de frame
+static int      s_count   = 0;
+static int      s_culled  = 0;
+static int      s_dropped = 0;
+static GfxClip  s_clip    = { 0, 0, SCREEN_W, SCREEN_H };
+
+static const int TEXT_ADVANCE = 8;      // police 8×8 des backends
+
+void draw_list_begin()
+{
+    s_cmds  = (DrawCmd*)frame_arena_alloc(DRAW_LIST_MAX * sizeof(DrawCmd), alignof(DrawCmd));
+    s_count = 0;
+    s_clip  = { 0, 0, SCREEN_W, SCREEN_H };
+}
+
+void draw_list_set_clip(int x, int y, int w, int h)
+{
+    s_clip.x0 = std::max(x, 0);
+    s_clip.y0 = std::max(y, 0);
+    s_clip.x1 = std::min(x + w, (int)SCREEN_W);
+    s_clip.y1 = std::min(y + h, (int)SCREEN_H);
+}
+
+static DrawCmd* push(DrawLayer layer, DrawOp op, int x, int y, int w, int h)
+{
+    if (!s_cmds || s_count >= DRAW_LIST_MAX) {
+        if (s_dropped++ == 0)
+            printf("DRAW LIST: pleine (%d commandes), commandes ignorées\n", DRAW_LIST_MAX);
+        return nullptr;
+    }
+
+    DrawCmd& c = s_cmds[s_count];
+    c.key   = ((uint32_t)layer << 16) | (uint32_t)s_count;
+    c.op    = op;
+    c.color = 0;
+    c.x     = (int16_t)x;
+    c.y     = (int16_t)y;
+    c.w     = (int16_t)w;
+    c.h     = (int16_t)h;
+    c.data  = nullptr;
+    c.fn    = nullptr;
+    s_count++;
+    return &c;
+}
+
+/*
+============================================================
+  ÉMISSION
+============================================================
+*/
+void draw_list_sprite(DrawLayer layer, int x, int y, const uint16_t* pixels,
+                      int w, int h, uint16_t transparentColor)
+{
+    if (!pixels)
+        return;
+    if (DrawCmd* c = push(layer, DrawOp::Sprite, x, y, w, h)) {
+        c->data  = pixels;
+        c->color = transparentColor;
+    }
+}
+
+void draw_list_text(DrawLayer layer, int x, int y, const char* text, uint16_t color)
+{
+    if (!text || !*text)
+        return;
+    if (DrawCmd* c = push(layer, DrawOp::Text, x, y, (int)strlen(text) * TEXT_ADVANCE, 8)) {
+        c->data  = text;
+        c->color = color;
+    }
+}
+
+void draw_list_rect(DrawLayer layer, int x, int y, int w, int h, uint16_t color)
+{
+    if (DrawCmd* c = push(layer, DrawOp::Rect, x, y, w, h))
+        c->color = color;
+}
+
+void draw_list_fill(DrawLayer layer, int x, int y, int w, int h, uint16_t color)
+{
+    if (DrawCmd* c = push(layer, DrawOp::FillRect, x, y, w, h))
+        c->color = color;
+}
+
+void draw_list_call(DrawLayer layer, DrawCallFn fn, const void* ctx)
+{
+    if (DrawCmd* c = push(layer, DrawOp::Call, 0, 0, SCREEN_W, SCREEN_H)) {
+        c->fn   = fn;
+        c->data = ctx;
+    }
+}
+
+/*
+============================================================
+  EXÉCUTION
+============================================================
+*/
+static bool visible(const DrawCmd& c)
+{
+    return c.x < s_clip.x1 && c.x + c.w > s_clip.x0 &&
+           c.y < s_clip.y1 && c.y + c.h > s_clip.y0;
+}
+
+static void execute(const DrawCmd& c)
+{
+    switch (c.op)
+    {
+        case DrawOp::Sprite:
+            gfx_sprite_clip(c.x, c.y, (const uint16_t*)c.data, c.w, c.h, c.color, s_clip);
+            break;
+
+        case DrawOp::Text:
+            gfx_text_clip(c.x, c.y, (const char*)c.data, c.color, s_clip);
+            break;
+
+        case DrawOp::FillRect:
+            gfx_fill_rect_clip(c.x, c.y, c.w, c.h, c.color, s_clip);
+            break;
+
+        case DrawOp::Rect:
+            gfx_fill_rect_clip(c.x,           c.y,           c.w, 1,   c.color, s_clip);
+            gfx_fill_rect_clip(c.x,           c.y + c.h - 1, c.w, 1,   c.color, s_clip);
+            gfx_fill_rect_clip(c.x,           c.y,           1,   c.h, c.color, s_clip);
+            gfx_fill_rect_clip(c.x + c.w - 1, c.y,           1,   c.h, c.color, s_clip);
+            break;
+
+        case DrawOp::Call:
+            c.fn(c.data);
+            break;
+    }
+}
+
+void draw_list_submit()
+{
+    if (!s_cmds)
+        return;
+
+    // Clés uniques (ordre d'émission) : tri stable de fait
+    std::sort(s_cmds, s_cmds + s_count,
+              [](const DrawCmd& a, const DrawCmd& b) { return a.key < b.key; });
+
+    s_culled = 0;
+    for (int i = 0; i < s_count; i++)
+    {
+        const DrawCmd& c = s_cmds[i];
+        if (c.op != DrawOp::Call && !visible(c)) {
+            s_culled++;
+            continue;
+        }
+        execute(c);
+    }
+}
+
+int draw_list_count()
+{
+    return s_count;
+}
+
+const DrawCmd* draw_list_commands()
+{
+    return s_cmds;
+}
+
+void draw_list_stats(DrawListStats& out)
+{
+    out.commands = s_count;
+    out.culled   = s_culled;
+    out.dropped  = s_dropped;
+}
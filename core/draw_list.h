@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+#include "core/graphics.h"
+
+/*
+============================================================
+  draw_list.h — Liste de commandes de dessin de la frame
+------------------------------------------------------------
+Le jeu ne dessine plus directement : il émet des commandes
+(sprite, texte, rectangle, fond) avec une couche et une
+boîte englobante, puis draw_list_submit() :
+ 1. trie une fois par clé (couche, puis ordre d'émission) ;
+ 2. écarte les commandes hors du rectangle de découpe ;
+ 3. exécute le reste via les primitives gfx_*_clip (découpe
+    commune, calculée une fois par commande).
+
+Après submit, draw_list_commands() donne le flux trié de la
+frame : une étape suivante (zones modifiées, rastérisation
+sur l'autre cœur…) peut le lire sans toucher au jeu.
+
+Les commandes vivent dans l'arena de frame (frame_arena.h) :
+draw_list_begin() après frame_arena_reset(), submit avant
+le reset suivant. Les textes doivent vivre jusqu'au submit
+(littéraux ou frame_printf).
+
+Tâche jeu uniquement.
+============================================================
+*/
+
+enum class DrawLayer : uint8_t {
+    Background,      // labyrinthe (efface tout l'écran)
+    Actors,          // Pac-Man, fantômes
+    Effects,         // scores flottants
+    Hud,             // score, vies, messages
+    Count
+};
+
+enum class DrawOp : uint8_t {
+    Sprite,
+    Text,
+    Rect,            // contour
+    FillRect,
+    Call             // fonction de rendu (fond), plein écran
+};
+
+typedef void (*DrawCallFn)(const void* ctx);
+
+struct DrawCmd {
+    uint32_t    key;         // couche << 16 | ordre d'émission
+    DrawOp      op;
+    uint16_t    color;       // texte / rectangle ; transparence du sprite
+    int16_t     x, y, w, h;  // boîte englobante (écran)
+    const void* data;        // pixels, texte ou contexte de Call
+    DrawCallFn  fn;          // Call uniquement
+};
+
+static const int DRAW_LIST_MAX = 64;
+
+struct DrawListStats {
+    int commands;            // émises lors de la dernière frame
+    int culled;              // hors découpe
+    int dropped;             // liste pleine (depuis le démarrage)
+};
+
+// Début de frame : liste vide, découpe = écran
+void draw_list_begin();
+
+// Découpe commune à toutes les commandes (bornée à l'écran)
+void draw_list_set_clip(int x, int y, int w, int h);
+
+void draw_list_sprite(DrawLayer layer, int x, int y, const uint16_t* pixels,
+                      int w, int h, uint16_t transparentColor = COLOR_BLACK);
+void draw_list_text(DrawLayer layer, int x, int y, const char* text, uint16_t color);
+void draw_list_rect(DrawLayer layer, int x, int y, int w, int h, uint16_t color);
+void draw_list_fill(DrawLayer layer, int x, int y, int w, int h, uint16_t color);
+void draw_list_call(DrawLayer layer, DrawCallFn fn, const void* ctx);
+
+// Tri + exécution
+void draw_list_submit();
+
+// Flux trié de la dernière frame soumise
+int            draw_list_count();
+const DrawCmd* draw_list_commands();
+void           draw_list_stats(DrawListStats& out);
@@ -0,0 +1,120 @@
+#include "frame_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+#ifdef ESP_PLATFORM
+#include "core/mem_track.h"
+#endif
+
+/*
+============================================================
+  ÉTAT
+============================================================
+*/
+alignas(16) static uint8_t s_buf[FRAME_ARENA_BYTES];
+
+static size_t   s_top       = 0;
+static size_t   s_peak      = 0;
+static uint32_t s_overflows = 0;
+
+static bool in_arena(const void* p)
+{
+    return p >= (const void*)s_buf && p < (const void*)(s_buf + FRAME_ARENA_BYTES);
+}
+
+static void overflow(size_t bytes)
+{
+    if (s_overflows++ == 0)
+        printf("FRAME ARENA: pleine (%u octets demandés, %u/%u utilisés)\n",
+               (unsigned)bytes, (unsigned)s_top, (unsigned)FRAME_ARENA_BYTES);
+}
+
+/*
+============================================================
+  API
+============================================================
+*/
+void frame_arena_reset()
+{
+    s_top = 0;
+}
+
+void* frame_arena_alloc(size_t bytes, size_t align)
+{
+    size_t start = (s_top + align - 1) & ~(align - 1);
+    if (start + bytes > FRAME_ARENA_BYTES) {
+        overflow(bytes);
+        return nullptr;
+    }
+
+    s_top = start + bytes;
+    if (s_top > s_peak)
+        s_peak = s_top;
+    return s_buf + start;
+}
+
+// Repli de FrameAllocator (visible dans mem_track : étiquette game)
+void* frame_arena_heap_alloc(size_t bytes)
+{
+#ifdef ESP_PLATFORM
+    void* p = mem_alloc(MemTag::Game, bytes, MALLOC_CAP_DEFAULT);
+#else
+    void* p = malloc(bytes);
+#endif
+    if (!p)
+        abort();
+    return p;
+}
+
+void frame_arena_free(void* p, size_t bytes)
+{
+    if (!p)
+        return;
+
+    if (!in_arena(p)) {
+#ifdef ESP_PLATFORM
+        mem_free(p);
+#else
+        free(p);
+#endif
+        return;
+    }
+
+    // Dernier bloc : la place est rendue (vector qui se réalloue)
+    if ((uint8_t*)p + bytes == s_buf + s_top)
+        s_top = (uint8_t*)p - s_buf;
+}
+
+const char* frame_printf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(nullptr, 0, fmt, copy);
+    va_end(copy);
+
+    char* out = (char*)frame_arena_alloc(n > 0 ? n + 1 : 1, 1);
+    if (out)
+        vsnprintf(out, n > 0 ? n + 1 : 1, fmt, args);
+    va_end(args);
+    return out ? out : "";
+}
+
+void frame_arena_stats(FrameArenaStats& out)
+{
+    out.used      = s_top;
+    out.peak      = s_peak;
+    out.capacity  = FRAME_ARENA_BYTES;
+    out.overflows = s_overflows;
+}
+
+FrameArenaScope::FrameArenaScope() : m_mark(s_top)
+{
+}
+
+FrameArenaScope::~FrameArenaScope()
+{
+    s_top = m_mark;
+}
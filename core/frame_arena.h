@@ -0,0 +1,95 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/*
+============================================================
+  frame_arena.h — Mémoire temporaire d'une frame
+------------------------------------------------------------
+Allocateur linéaire (bump) pour les données qui ne vivent
+qu'une étape de la frame : listes de directions des
+fantômes, textes du HUD, draw list…
+
+ - frame_arena_reset() au début de game_update et de
+   game_draw : tout ce qui a été alloué avant est invalide ;
+ - allouer = avancer un pointeur (aligné) ; libérer ne fait
+   rien, sauf pour le dernier bloc (un vector qui grandit
+   récupère sa place) ;
+ - FrameArenaScope : rend à sa sortie tout ce qui a été
+   alloué dans la portée (tampons lourds appelés plusieurs
+   fois par frame) ;
+ - FrameAllocator<T> / FrameVector<T> : adaptateur STL ;
+ - arena pleine : frame_arena_alloc renvoie nullptr,
+   FrameAllocator se replie sur le tas ; compté et signalé
+   une fois (FRAME_ARENA_BYTES à agrandir).
+
+En régime établi, la frame de jeu ne fait plus aucun
+malloc / free (cf. MemNoAlloc, core/mem_track.h).
+
+Tâche jeu uniquement : aucun verrou.
+============================================================
+*/
+
+static const size_t FRAME_ARENA_BYTES = 4 * 1024;    // draw list : 64 × 24 octets
+
+struct FrameArenaStats {
+    size_t   used;
+    size_t   peak;          // depuis le démarrage
+    size_t   capacity;
+    uint32_t overflows;     // allocations renvoyées sur le tas
+};
+
+void  frame_arena_reset();
+void* frame_arena_alloc(size_t bytes, size_t align = alignof(max_align_t));   // nullptr si pleine
+void  frame_arena_free(void* p, size_t bytes);   // accepte aussi les blocs de repli
+
+// Repli sur le tas (FrameAllocator), libéré par frame_arena_free
+void* frame_arena_heap_alloc(size_t bytes);
+
+// Texte formaté valable jusqu'au prochain reset ("" si l'arena est pleine)
+const char* frame_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+void frame_arena_stats(FrameArenaStats& out);
+
+// Marque / retour arrière (RAII)
+class FrameArenaScope {
+public:
+    FrameArenaScope();
+    ~FrameArenaScope();
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+private:
+    size_t m_mark;
+};
+
+/*
+============================================================
+  ADAPTATEUR STL
+============================================================
+*/
+template <class T>
+struct FrameAllocator {
+    typedef T value_type;
+
+    FrameAllocator() noexcept {}
+    template <class U> FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        void* p = frame_arena_alloc(n * sizeof(T), alignof(T));
+        if (!p)
+            p = frame_arena_heap_alloc(n * sizeof(T));
+        return static_cast<T*>(p);
+    }
+    void deallocate(T* p, size_t n) noexcept
+    {
+        frame_arena_free(p, n * sizeof(T));
+    }
+
+    template <class U> bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+    template <class U> bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
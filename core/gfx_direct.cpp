@@ -55,6 +55,50 @@ void gfx_direct_text(int x, int y, const char* txt, uint16_t color) {
     lcd_draw_str((uint16_t)x, (uint16_t)y, txt);
 }
 
+// ============================================================================
+//  Découpe (draw list) : pixel par pixel, ce backend sert au debug
+// ============================================================================
+void gfx_direct_drawSpriteClip(int x, int y,
+                               const uint16_t* data,
+                               int w, int h,
+                               uint16_t transparentColor,
+                               const GfxClip& clip)
+{
+    for (int j = 0; j < h; ++j) {
+        int yy = y + j;
+        if (yy < clip.y0 || yy >= clip.y1) continue;
+        for (int i = 0; i < w; ++i) {
+            int xx = x + i;
+            uint16_t c = data[j * w + i];
+            if (xx >= clip.x0 && xx < clip.x1 && c != transparentColor)
+                gfx_direct_putpixel(xx, yy, c);
+        }
+    }
+}
+
+void gfx_direct_fillRectClip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip)
+{
+    for (int yy = y; yy < y + h; ++yy)
+        for (int xx = x; xx < x + w; ++xx)
+            if (xx >= clip.x0 && xx < clip.x1 && yy >= clip.y0 && yy < clip.y1)
+                gfx_direct_putpixel(xx, yy, color);
+}
+
+// Seuls les caractères entièrement visibles sont dessinés
+void gfx_direct_textClip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip)
+{
+    if (y < clip.y0 || y + 8 > clip.y1)
+        return;
+
+    char one[2] = { 0, 0 };
+    for (; *txt; ++txt, x += 8) {
+        if (x < clip.x0 || x + 8 > clip.x1)
+            continue;
+        one[0] = *txt;
+        gfx_direct_text(x, y, one, color);
+    }
+}
+
 void gfx_direct_flush() {
     // En mode direct, on considère que tout est visible immédiatement.
     // On peut forcer un rafraîchissement si nécessaire :
@@ -1,6 +1,8 @@
 #pragma once
 #include <stdint.h>
 
+struct GfxClip;
+
 /*
 ===============================================================================
   gfx_direct.h — Backend graphique DIRECT LCD
@@ -28,6 +30,15 @@ void gfx_direct_drawSprite(int x, int y,
 void gfx_direct_text(int x, int y, const char* txt, uint16_t color);
 void gfx_direct_flush(); // No-op en général
 
+// Découpe (draw list)
+void gfx_direct_drawSpriteClip(int x, int y,
+                               const uint16_t* data,
+                               int w, int h,
+                               uint16_t transparentColor,
+                               const GfxClip& clip);
+void gfx_direct_fillRectClip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip);
+void gfx_direct_textClip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip);
+
 // Primitives
 void gfx_direct_drawLine(int x0, int y0, int x1, int y1, uint16_t color);
 void gfx_direct_drawRect(int x, int y, int w, int h, uint16_t color);
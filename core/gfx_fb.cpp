@@ -417,6 +417,70 @@ void gfx_fb_blitTransparent(int dstX, int dstY,
 }
 
 
+// ============================================================================
+//  Découpe (draw list)
+// ============================================================================
+// Intersection [x, x+w[ × [y, y+h[ ∩ clip ; false si vide
+static inline bool clip_box(int x, int y, int w, int h, const GfxClip& clip,
+                            int& x0, int& y0, int& x1, int& y1)
+{
+    x0 = std::max(x, clip.x0);
+    y0 = std::max(y, clip.y0);
+    x1 = std::min(x + w, clip.x1);
+    y1 = std::min(y + h, clip.y1);
+    return x0 < x1 && y0 < y1;
+}
+
+void gfx_fb_drawSpriteClip(int x, int y,
+                           const uint16_t* data,
+                           int w, int h,
+                           uint16_t transparentColor,
+                           const GfxClip& clip)
+{
+    int x0, y0, x1, y1;
+    if (!clip_box(x, y, w, h, clip, x0, y0, x1, y1))
+        return;
+
+    for (int yy = y0; yy < y1; ++yy) {
+        const uint16_t* src = &data[(yy - y) * w + (x0 - x)];
+        uint16_t*       dst = &framebuffer[yy * SCREEN_W + x0];
+
+        for (int n = x1 - x0; n > 0; --n, ++src, ++dst) {
+            if (*src != transparentColor)
+                *dst = *src;
+        }
+    }
+}
+
+void gfx_fb_fillRectClip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip)
+{
+    int x0, y0, x1, y1;
+    if (!clip_box(x, y, w, h, clip, x0, y0, x1, y1))
+        return;
+
+    for (int yy = y0; yy < y1; ++yy)
+        std::fill(&framebuffer[yy * SCREEN_W + x0], &framebuffer[yy * SCREEN_W + x1], color);
+}
+
+void gfx_fb_textClip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip)
+{
+    for (; *txt; ++txt, x += 8)
+    {
+        int x0, y0, x1, y1;
+        if (!clip_box(x, y, 8, 8, clip, x0, y0, x1, y1))
+            continue;
+
+        const uint8_t* glyph = font8x8_basic[(uint8_t)*txt];
+        for (int yy = y0; yy < y1; ++yy) {
+            uint8_t bits = glyph[yy - y];
+            for (int xx = x0; xx < x1; ++xx)
+                if (bits & (1 << (xx - x)))
+                    framebuffer[yy * SCREEN_W + xx] = color;
+        }
+    }
+}
+
+
 // ============================================================================
 //  Framebuffer utils
 // ============================================================================
@@ -1,6 +1,8 @@
 #pragma once
 #include <stdint.h>
 
+struct GfxClip;
+
 /*
 ===============================================================================
   gfx_fb.h — Backend graphique FRAMEBUFFER (DMA → LCD)
@@ -128,6 +130,19 @@ void gfx_fb_textShadow(int x, int y,
                        int offsetX, int offsetY);
 
 
+// ============================================================================
+//  DÉCOUPE (draw list)
+// ============================================================================
+void gfx_fb_drawSpriteClip(int x, int y,
+                           const uint16_t* data,
+                           int w, int h,
+                           uint16_t transparentColor,
+                           const GfxClip& clip);
+
+void gfx_fb_fillRectClip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip);
+void gfx_fb_textClip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip);
+
+
 // ============================================================================
 //  FRAMEBUFFER UTILS
 // ============================================================================
@@ -169,6 +169,39 @@ void gfx_text_center(int y, const char* text, uint16_t color) {
 }
 
 
+// ============================================================================
+//  PRIMITIVES AVEC DÉCOUPE
+// ============================================================================
+/*
+    Utilisées par la draw list (core/draw_list.h) : un rectangle de
+    découpe commun à toute la frame, appliqué par le backend.
+*/
+void gfx_sprite_clip(int x, int y, const uint16_t* pixels, int w, int h,
+                     uint16_t transparentColor, const GfxClip& clip) {
+#if USE_FRAMEBUFFER
+    gfx_fb_drawSpriteClip(x, y, pixels, w, h, transparentColor, clip);
+#else
+    gfx_direct_drawSpriteClip(x, y, pixels, w, h, transparentColor, clip);
+#endif
+}
+
+void gfx_fill_rect_clip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip) {
+#if USE_FRAMEBUFFER
+    gfx_fb_fillRectClip(x, y, w, h, color, clip);
+#else
+    gfx_direct_fillRectClip(x, y, w, h, color, clip);
+#endif
+}
+
+void gfx_text_clip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip) {
+#if USE_FRAMEBUFFER
+    gfx_fb_textClip(x, y, txt, color, clip);
+#else
+    gfx_direct_textClip(x, y, txt, color, clip);
+#endif
+}
+
+
 // ============================================================================
 //  PIXELS
 // ============================================================================
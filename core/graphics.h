@@ -60,6 +60,21 @@ void gfx_text_center(int y, const char* text, uint16_t color);
 // Largeur d’un caractère (police monospaced)
 int gfx_char_width(char c);
 
+// ------------------------------------------------------------
+// Primitives avec découpe (exécution de la draw list)
+// ------------------------------------------------------------
+// Rectangle de découpe [x0, x1[ × [y0, y1[, déjà borné à l'écran.
+// La découpe est calculée une fois par appel : les boucles
+// internes ne testent plus chaque pixel.
+struct GfxClip {
+    int x0, y0, x1, y1;
+};
+
+void gfx_sprite_clip(int x, int y, const uint16_t* pixels, int w, int h,
+                     uint16_t transparentColor, const GfxClip& clip);
+void gfx_fill_rect_clip(int x, int y, int w, int h, uint16_t color, const GfxClip& clip);
+void gfx_text_clip(int x, int y, const char* txt, uint16_t color, const GfxClip& clip);
+
 // Instance héritée (compatibilité)
 extern graphics_basic gfx;
 
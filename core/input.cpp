@@ -1,39 +1,229 @@
 #include "input.h"
 #include "lib/expander.h"
-#include "driver/gpio.h"  
+#include "driver/gpio.h"
+#include <atomic>
+#include <stdio.h>
 
-static uint16_t prev=0;
-Keys g_keys;
+static uint32_t prev=0;
 
-void input_init(){ prev=0; }
+/*
+============================================================
+  JOYSTICK (valeurs filtrées par le DMA ADC, cf. lib/expander)
+============================================================
+*/
+static JoystickConfig s_joy_cfg;
+static int            s_joy_center_x = JOYX_MID;
+static int            s_joy_center_y = JOYX_MID;
+static int8_t         s_joy_x = 0;
+static int8_t         s_joy_y = 0;
 
-void input_poll(Keys& k) {
-    // lecture brute des touches
-    uint16_t raw = expander_read();
-    k.raw = raw;
+static const int JOY_CALIB_MAX = 600;   // écart max accepté au centre théorique (mV)
 
-    k.pressed  = raw & ~prev;   // nouvelles touches pressées
-    k.released = prev & ~raw;   // touches relâchées
-    prev       = raw;
+// Un axe : -1 / 0 / +1 avec hystérésis (état précédent dans state)
+static int8_t joy_axis(int v, int center, int8_t state)
+{
+    int d       = v - center;
+    int engage  = s_joy_cfg.deadzone + s_joy_cfg.hysteresis;
+    int release = s_joy_cfg.deadzone;
+
+    if (state > 0 && d > release)  return 1;
+    if (state < 0 && d < -release) return -1;
+    if (d >  engage) return 1;
+    if (d < -engage) return -1;
+    return 0;
+}
+
+void input_joystick_config(const JoystickConfig& cfg)
+{
+    s_joy_cfg = cfg;
+}
+
+void input_joystick_calibrate()
+{
+    if (adc_frame_count() == 0)
+        return;
+
+    int x = adc_read_joyx();
+    int y = adc_read_joyy();
+
+    // Stick tenu au démarrage : on garde le centre théorique
+    if (x < JOYX_MID - JOY_CALIB_MAX || x > JOYX_MID + JOY_CALIB_MAX ||
+        y < JOYX_MID - JOY_CALIB_MAX || y > JOYX_MID + JOY_CALIB_MAX) {
+        printf("INPUT: joystick non centré (%d, %d), calibration ignorée\n", x, y);
+        return;
+    }
+
+    s_joy_center_x = x;
+    s_joy_center_y = y;
+    printf("INPUT: centre joystick %d, %d mV\n", x, y);
+}
+
+/*
+============================================================
+  PHOTO PUBLIÉE (double tampon + numéro de séquence)
+------------------------------------------------------------
+Le producteur écrit le tampon que personne ne lit (seq + 1),
+puis publie seq + 1. Le lecteur recommence seulement si une
+publication complète a eu lieu pendant sa copie : jamais
+d'attente active sur un producteur préempté (tâche input moins
+prioritaire que la tâche jeu, même cœur).
+============================================================
+*/
+static Keys                  s_slot[2];
+static std::atomic<uint32_t> s_seq{0};
+
+/*
+============================================================
+  FILE D'ÉVÉNEMENTS (1 producteur / 1 consommateur, sans verrou)
+============================================================
+*/
+static const uint32_t EVENT_CAP = 32;     // puissance de 2
+
+static InputEvent            s_events[EVENT_CAP];
+static std::atomic<uint32_t> s_ev_head{0};    // écrit par la tâche input
+static std::atomic<uint32_t> s_ev_tail{0};    // écrit par la tâche jeu
+static uint32_t              s_ev_dropped = 0;
+
+static void push_event(int64_t time_us, uint32_t seq, uint32_t key, InputEventType type)
+{
+    uint32_t head = s_ev_head.load(std::memory_order_relaxed);
+    if (head - s_ev_tail.load(std::memory_order_acquire) >= EVENT_CAP) {
+        s_ev_dropped++;
+        return;
+    }
+    s_events[head & (EVENT_CAP - 1)] = { time_us, seq, key, type };
+    s_ev_head.store(head + 1, std::memory_order_release);
+}
+
+// Bitmask → booléens de direction / boutons
+static void map_keys(Keys& k, uint32_t bits)
+{
+    k.up    = bits & EXPANDER_KEY_UP;
+    k.down  = bits & EXPANDER_KEY_DOWN;
+    k.left  = bits & EXPANDER_KEY_LEFT;
+    k.right = bits & EXPANDER_KEY_RIGHT;
+
+    k.A   = bits & EXPANDER_KEY_A;
+    k.B   = bits & EXPANDER_KEY_B;
+    k.C   = bits & EXPANDER_KEY_C;
+    k.D   = bits & EXPANDER_KEY_D;
+    k.RUN = bits & EXPANDER_KEY_RUN;
+	k.MENU= bits & EXPANDER_KEY_MENU;
+	k.R1  = bits & EXPANDER_KEY_R1;
+	k.L1  = bits & EXPANDER_KEY_L1;
+}
+
+void input_init(){
+    prev = 0;
+    s_joy_x = 0;
+    s_joy_y = 0;
+    input_joystick_calibrate();
+    s_slot[0] = Keys{};
+    s_slot[1] = Keys{};
+    s_seq.store(0, std::memory_order_release);
+}
+
+void input_poll(Keys& k, bool read_keys) {
+    // lecture brute des touches (erreur I2C : état précédent conservé)
+    uint16_t raw = (uint16_t)prev;
+    if (read_keys)
+        expander_read_keys(&raw);
 
     // mapping des boutons
-    k.up    = raw & EXPANDER_KEY_UP;
-    k.down  = raw & EXPANDER_KEY_DOWN;
-    k.left  = raw & EXPANDER_KEY_LEFT;
-    k.right = raw & EXPANDER_KEY_RIGHT;
-
-    k.A   = raw & EXPANDER_KEY_A;
-    k.B   = raw & EXPANDER_KEY_B;
-    k.C   = raw & EXPANDER_KEY_C;
-    k.D   = raw & EXPANDER_KEY_D;
-    k.RUN = raw & EXPANDER_KEY_RUN;
-	k.MENU= raw & EXPANDER_KEY_MENU;
-	k.R1  = raw & EXPANDER_KEY_R1;
-	k.L1  = raw & EXPANDER_KEY_L1;
+    map_keys(k, raw);
 	k.joxx = adc_read_joyx();
     k.joxy = adc_read_joyy();
-	
-	g_keys = k;
+
+    s_joy_x = joy_axis(k.joxx, s_joy_center_x, s_joy_x);
+    s_joy_y = joy_axis(k.joxy, s_joy_center_y, s_joy_y);
+    k.joy_x = s_joy_x;
+    k.joy_y = s_joy_y;
+
+    // Directions du joystick → touches virtuelles
+    uint32_t bits = raw;
+    if (s_joy_x < 0) bits |= INPUT_JOY_LEFT;
+    if (s_joy_x > 0) bits |= INPUT_JOY_RIGHT;
+    if (s_joy_y > 0) bits |= INPUT_JOY_UP;
+    if (s_joy_y < 0) bits |= INPUT_JOY_DOWN;
+    k.raw = bits;
+
+    k.pressed  = bits & ~prev;  // nouvelles touches pressées
+    k.released = prev & ~bits;  // touches relâchées
+    prev       = bits;
+
+    k.time_us         = 0;
+    k.last_pressed    = 0;
+    k.last_pressed_us = 0;
+}
+
+void input_publish(const Keys& k, int64_t time_us)
+{
+    uint32_t next = s_seq.load(std::memory_order_relaxed) + 1;
+
+    s_slot[next & 1] = k;
+    s_slot[next & 1].time_us = time_us;
+    s_seq.store(next, std::memory_order_release);
+
+    // Un événement par touche qui change
+    for (uint32_t bits = k.pressed; bits; bits &= bits - 1)
+        push_event(time_us, next, bits & (~bits + 1), InputEventType::Press);
+    for (uint32_t bits = k.released; bits; bits &= bits - 1)
+        push_event(time_us, next, bits & (~bits + 1), InputEventType::Release);
+}
+
+uint32_t input_snapshot(Keys& k)
+{
+    for (;;)
+    {
+        uint32_t seq = s_seq.load(std::memory_order_acquire);
+        k = s_slot[seq & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s_seq.load(std::memory_order_relaxed) == seq)
+            return seq;
+    }
+}
+
+bool input_pop_event(InputEvent& e)
+{
+    uint32_t tail = s_ev_tail.load(std::memory_order_relaxed);
+    if (tail == s_ev_head.load(std::memory_order_acquire))
+        return false;
+
+    e = s_events[tail & (EVENT_CAP - 1)];
+    s_ev_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t input_read(Keys& k)
+{
+    uint32_t seq = input_snapshot(k);
+
+    uint32_t pressed = 0, released = 0;
+    k.last_pressed    = 0;
+    k.last_pressed_us = 0;
+
+    InputEvent e;
+    while (input_pop_event(e))
+    {
+        if (e.type == InputEventType::Press) {
+            pressed |= e.key;
+            k.last_pressed    = e.key;     // file dans l'ordre : le plus récent gagne
+            k.last_pressed_us = e.time_us;
+        }
+        else
+            released |= e.key;
+    }
+    k.pressed  = pressed;
+    k.released = released;
+
+    // Un appui déjà relâché compte pour cette frame
+    map_keys(k, k.raw | pressed);
+    return seq;
+}
+
+uint32_t input_dropped_events()
+{
+    return s_ev_dropped;
 }
 
 bool isLongPress(const Keys& k, int key) {
@@ -50,6 +240,3 @@ bool isLongPress(const Keys& k, int key) {
     }
     return false;
 }
-
-
-
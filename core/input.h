@@ -1,18 +1,89 @@
 #pragma once
-#include <cstdint> 
+#include <cstdint>
+
+/*
+============================================================
+  input.h — Entrées (boutons de l'expander + joystick ADC)
+------------------------------------------------------------
+Un seul producteur : la tâche input lit le matériel
+(input_poll : I2C + ADC) et publie le résultat
+(input_publish). Tous les autres lisent la dernière photo
+publiée, sans transaction sur le bus :
+
+ - input_snapshot : copie O(1) de l'état courant, numérotée
+   (numéro de séquence), jamais déchirée (double tampon +
+   séquence, sans verrou) ;
+ - input_read     : réservé à la tâche jeu (seul consommateur
+   des événements). pressed / released regroupent tous les
+   appuis / relâchements depuis la lecture précédente : un
+   appui plus court qu'une frame n'est pas perdu.
+============================================================
+*/
+
+// Directions du joystick en touches virtuelles (au-dessus des 16 bits
+// de l'expander) : mêmes événements Press / Release que les boutons
+constexpr uint32_t INPUT_JOY_LEFT  = 1u << 16;
+constexpr uint32_t INPUT_JOY_RIGHT = 1u << 17;
+constexpr uint32_t INPUT_JOY_UP    = 1u << 18;
+constexpr uint32_t INPUT_JOY_DOWN  = 1u << 19;
 
 struct Keys {
-    uint32_t raw;       // état brut des touches (bitmask)
+    uint32_t raw;       // état brut des touches (bitmask + INPUT_JOY_*)
     uint32_t pressed;   // touches actuellement pressées
     uint32_t released;  // touches relâchées
 
-    int joxx, joxy;
+    int64_t  time_us;          // instant de la photo (input_publish)
+    uint32_t last_pressed;     // input_read : dernière touche appuyée (0 = aucune)
+    int64_t  last_pressed_us;  //             et son horodatage
+
+    int joxx, joxy;     // joystick filtré (mV, cf. adc_read_joyx)
+    int8_t joy_x;       // -1 gauche / 0 / +1 droite (zone morte + hystérésis)
+    int8_t joy_y;       // -1 bas    / 0 / +1 haut
 	bool up, down, left, right;
     bool A, B, C, D, RUN, MENU, R1, L1;
 };
 
-extern Keys g_keys;
+// Événement de touche (un bit EXPANDER_KEY_* par événement)
+enum class InputEventType : uint8_t {
+    Press,
+    Release
+};
+
+struct InputEvent {
+    int64_t        time_us; // instant du changement (interruption ou lecture)
+    uint32_t       seq;     // numéro de la photo qui l'a produit
+    uint32_t       key;     // EXPANDER_KEY_*
+    InputEventType type;
+};
+
+// Joystick : seuils autour du centre calibré, en mV.
+// Une direction s'active au-delà de deadzone + hysteresis et se
+// relâche en deçà de deadzone : le bruit au seuil ne la fait
+// plus clignoter.
+struct JoystickConfig {
+    int deadzone   = 500;
+    int hysteresis = 150;
+};
 
 void input_init();
-void input_poll(Keys& k);
-bool isLongPress(const Keys& k, int key);
\ No newline at end of file
+
+void input_joystick_config(const JoystickConfig& cfg);
+void input_joystick_calibrate();     // centre = position actuelle (stick lâché)
+
+// Lecture matérielle (I2C + ADC) : tâche input uniquement.
+// read_keys = false : joystick seul, touches inchangées (pas d'I2C).
+// time_us : horodatage des événements produits par cette photo.
+void input_poll(Keys& k, bool read_keys = true);
+void input_publish(const Keys& k, int64_t time_us);
+
+// Lecture de la dernière photo publiée ; retourne son numéro de séquence
+uint32_t input_snapshot(Keys& k);
+
+// Photo + événements depuis l'appel précédent (tâche jeu uniquement)
+uint32_t input_read(Keys& k);
+bool     input_pop_event(InputEvent& e);
+
+// Événements perdus (file pleine) depuis le démarrage
+uint32_t input_dropped_events();
+
+bool isLongPress(const Keys& k, int key);
@@ -0,0 +1,263 @@
+#include "mem_track.h"
+#include "frame_arena.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <new>
+
+static const char* const s_tag_names[] = {
+    "other", "game", "ghost", "ui", "snapshot", "netplay",
+    "video", "audio", "sfx", "music"
+};
+static_assert(sizeof(s_tag_names) / sizeof(s_tag_names[0]) == (int)MemTag::Count,
+              "un nom par MemTag");
+
+const char* mem_tag_name(MemTag tag)
+{
+    return (tag < MemTag::Count) ? s_tag_names[(int)tag] : "?";
+}
+
+#ifdef USE_MEM_TRACK
+
+/*
+============================================================
+  ÉTAT
+============================================================
+*/
+static const int MEM_TRACK_LOG_MAX = 8;     // infractions journalisées par étiquette
+
+// Budgets par défaut (octets, 0 = illimité) : tailles prévues + marge
+static uint32_t s_budget[(int)MemTag::Count] = {
+    0,                  // other
+    16 * 1024,          // game     : vecteurs fantômes / scores flottants
+    4 * 1024,           // ghost
+    16 * 1024,          // ui
+    256 * 1024,         // snapshot : anneau de rewind 192 Ko + tampons
+    80 * 1024,          // netplay  : 10 photos de 6 Ko + marge
+    192 * 1024,         // video    : cache du labyrinthe 336×256×2
+    8 * 1024,           // audio    : décodeurs ADPCM
+    320 * 1024,         // sfx      : budget PCM 256 Ko + ADPCM
+    4 * 1024 * 1024     // music    : PMF pré-rendu en PSRAM
+};
+
+static MemTagStats  s_stats[(int)MemTag::Count];
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Par tâche : étiquette courante, zone interdite courante
+static thread_local MemTag      s_scope_tag = MemTag::Other;
+static thread_local const char* s_no_alloc  = nullptr;
+
+// En-tête placé devant chaque bloc suivi (garde l'alignement 8)
+struct BlockHeader {
+    uint32_t size;
+    uint16_t magic;
+    uint8_t  tag;
+    uint8_t  reserved;
+};
+static_assert(sizeof(BlockHeader) == 8, "en-tête de 8 octets");
+
+static const uint16_t BLOCK_MAGIC = 0x4D54;    // "MT"
+
+/*
+============================================================
+  COMPTAGE
+============================================================
+*/
+static void report_violation(MemTag tag, size_t bytes, const char* zone,
+                             uint32_t forbidden, uint32_t over)
+{
+    if (zone && forbidden <= MEM_TRACK_LOG_MAX)
+        printf("MEM: allocation interdite (%s) : %u octets, étiquette %s, tâche %s\n",
+               zone, (unsigned)bytes, mem_tag_name(tag), pcTaskGetName(nullptr));
+    if (over && over <= MEM_TRACK_LOG_MAX)
+        printf("MEM: budget %s dépassé (%u octets demandés, budget %u)\n",
+               mem_tag_name(tag), (unsigned)bytes, (unsigned)s_budget[(int)tag]);
+
+#ifdef MEM_TRACK_STRICT
+    assert(!"mem_track : allocation interdite ou budget dépassé");
+#endif
+}
+
+void* mem_alloc(MemTag tag, size_t bytes, uint32_t caps)
+{
+    if (tag >= MemTag::Count)
+        tag = MemTag::Other;
+
+    BlockHeader* h = (BlockHeader*)heap_caps_malloc(sizeof(BlockHeader) + bytes, caps);
+    if (!h)
+        return nullptr;
+    h->size     = (uint32_t)bytes;
+    h->magic    = BLOCK_MAGIC;
+    h->tag      = (uint8_t)tag;
+    h->reserved = 0;
+
+    const char*  zone = s_no_alloc;
+    MemTagStats& s    = s_stats[(int)tag];
+    uint32_t forbidden = 0, over = 0;
+
+    portENTER_CRITICAL(&s_mux);
+    s.bytes += (uint32_t)bytes;
+    s.allocs++;
+    if (s.bytes > s.peak)
+        s.peak = s.bytes;
+    if (s_budget[(int)tag] && s.bytes > s_budget[(int)tag])
+        over = ++s.over_budget;
+    if (zone)
+        forbidden = ++s.forbidden;
+    portEXIT_CRITICAL(&s_mux);
+
+    if (zone || over)
+        report_violation(tag, bytes, zone, forbidden, over);
+
+    return h + 1;
+}
+
+void mem_free(void* p)
+{
+    if (!p)
+        return;
+
+    BlockHeader* h = (BlockHeader*)p - 1;
+    if (h->magic != BLOCK_MAGIC || h->tag >= (uint8_t)MemTag::Count) {
+        printf("MEM: libération d'un bloc non suivi ou déjà libéré (%p)\n", p);
+        assert(!"mem_free : bloc invalide");
+        return;
+    }
+    h->magic = 0;    // double libération détectée au prochain appel
+
+    MemTagStats& s = s_stats[h->tag];
+    portENTER_CRITICAL(&s_mux);
+    s.bytes -= h->size;
+    s.frees++;
+    portEXIT_CRITICAL(&s_mux);
+
+    heap_caps_free(h);
+}
+
+/*
+============================================================
+  PORTÉES
+============================================================
+*/
+MemScope::MemScope(MemTag tag) : m_prev(s_scope_tag)
+{
+    s_scope_tag = tag;
+}
+
+MemScope::~MemScope()
+{
+    s_scope_tag = m_prev;
+}
+
+MemNoAlloc::MemNoAlloc(const char* what) : m_prev(s_no_alloc)
+{
+    s_no_alloc = what;
+}
+
+MemNoAlloc::~MemNoAlloc()
+{
+    s_no_alloc = m_prev;
+}
+
+/*
+============================================================
+  RELEVÉS
+============================================================
+*/
+void mem_track_set_budget(MemTag tag, uint32_t bytes)
+{
+    if (tag < MemTag::Count)
+        s_budget[(int)tag] = bytes;
+}
+
+bool mem_track_get(MemTag tag, MemTagStats& out)
+{
+    if (tag >= MemTag::Count)
+        return false;
+
+    portENTER_CRITICAL(&s_mux);
+    out = s_stats[(int)tag];
+    portEXIT_CRITICAL(&s_mux);
+    out.budget = s_budget[(int)tag];
+    return true;
+}
+
+uint32_t mem_track_violations()
+{
+    uint32_t n = 0;
+    portENTER_CRITICAL(&s_mux);
+    for (int i = 0; i < (int)MemTag::Count; i++)
+        n += s_stats[i].forbidden + s_stats[i].over_budget;
+    portEXIT_CRITICAL(&s_mux);
+    return n;
+}
+
+static void report_heap(const char* name, uint32_t caps)
+{
+    size_t free_b  = heap_caps_get_free_size(caps);
+    size_t largest = heap_caps_get_largest_free_block(caps);
+    size_t min_b   = heap_caps_get_minimum_free_size(caps);
+
+    // Fragmentation : part du libre inutilisable en un seul bloc
+    unsigned frag = free_b ? (unsigned)(100 - largest * 100 / free_b) : 0;
+    printf("MEM: %-8s libre %7u  plus grand bloc %7u  minimum %7u  fragmentation %u%%\n",
+           name, (unsigned)free_b, (unsigned)largest, (unsigned)min_b, frag);
+}
+
+void mem_track_report()
+{
+    printf("MEM: étiquette  en cours      pic  allocs  libés   budget  dépass.  interdites\n");
+    for (int i = 0; i < (int)MemTag::Count; i++)
+    {
+        MemTagStats s;
+        mem_track_get((MemTag)i, s);
+        if (s.allocs == 0)
+            continue;
+        printf("MEM: %-9s %9u %8u %7u %6u %8u %8u %11u\n",
+               s_tag_names[i], (unsigned)s.bytes, (unsigned)s.peak,
+               (unsigned)s.allocs, (unsigned)s.frees, (unsigned)s.budget,
+               (unsigned)s.over_budget, (unsigned)s.forbidden);
+    }
+    report_heap("interne", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    report_heap("PSRAM",   MALLOC_CAP_SPIRAM);
+
+    FrameArenaStats fa;
+    frame_arena_stats(fa);
+    printf("MEM: arena de frame : pic %u / %u octets, %u débordement(s)\n",
+           (unsigned)fa.peak, (unsigned)fa.capacity, (unsigned)fa.overflows);
+}
+
+/*
+============================================================
+  NEW / DELETE GLOBAUX
+------------------------------------------------------------
+Toutes les allocations C++ (STL comprise) passent par
+mem_alloc avec l'étiquette de la tâche courante.
+============================================================
+*/
+static void* tracked_new(size_t n)
+{
+    void* p = mem_alloc(s_scope_tag, n, MALLOC_CAP_DEFAULT);
+    if (!p) {
+        printf("MEM: new de %u octets impossible (%s)\n",
+               (unsigned)n, mem_tag_name(s_scope_tag));
+        abort();
+    }
+    return p;
+}
+
+void* operator new(size_t n)                                 { return tracked_new(n); }
+void* operator new[](size_t n)                               { return tracked_new(n); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept   { return mem_alloc(s_scope_tag, n, MALLOC_CAP_DEFAULT); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return mem_alloc(s_scope_tag, n, MALLOC_CAP_DEFAULT); }
+
+void operator delete(void* p) noexcept                          { mem_free(p); }
+void operator delete[](void* p) noexcept                        { mem_free(p); }
+void operator delete(void* p, size_t) noexcept                  { mem_free(p); }
+void operator delete[](void* p, size_t) noexcept                { mem_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept   { mem_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { mem_free(p); }
+
+#endif
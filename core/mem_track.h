@@ -0,0 +1,101 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "lib/common.h"
+#include "esp_heap_caps.h"
+
+/*
+============================================================
+  mem_track.h — Suivi des allocations par sous-système
+------------------------------------------------------------
+Build de debug uniquement (USE_MEM_TRACK, lib/common.h) ;
+sinon tout ce fichier se réduit à heap_caps_malloc / free et
+à des classes vides.
+
+ - chaque allocation porte une étiquette (MemTag) : octets en
+   cours, pic (high-water mark), nombre d'allocations /
+   libérations, dépassements de budget ;
+ - mem_alloc / mem_free : allocations explicites (PSRAM,
+   banques audio, caches) ;
+ - new / delete (std::vector, std::string…) : étiquette de la
+   tâche courante, posée par MemScope ;
+ - MemNoAlloc : zone où aucune allocation n'est permise (la
+   frame de jeu). Chaque infraction est comptée et les
+   premières sont journalisées ; avec MEM_TRACK_STRICT elle
+   arrête le programme (assert) ;
+ - mem_track_report : tableau par étiquette + état des tas
+   (libre / plus grand bloc : fragmentation).
+
+Coût en mode suivi : 8 octets d'en-tête par bloc et une
+section critique par allocation.
+============================================================
+*/
+
+enum class MemTag : uint8_t {
+    Other,        // hors de toute MemScope
+    Game,         // logique / rendu de la partie
+    Ghost,        // IA des fantômes
+    Ui,           // écrans titre, options, scores
+    Snapshot,     // photos + anneau de rewind
+    Netplay,
+    Video,        // caches d'affichage
+    Audio,        // décodage WAV / ADPCM
+    Sfx,          // banque d'effets
+    Music,        // PMF pré-rendu
+    Count
+};
+
+struct MemTagStats {
+    uint32_t bytes;          // en cours
+    uint32_t peak;
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t budget;         // 0 = illimité
+    uint32_t over_budget;    // allocations ayant dépassé le budget
+    uint32_t forbidden;      // allocations en zone MemNoAlloc
+};
+
+const char* mem_tag_name(MemTag tag);
+
+#ifdef USE_MEM_TRACK
+
+void* mem_alloc(MemTag tag, size_t bytes, uint32_t caps);
+void  mem_free(void* p);
+
+// Étiquette des new / malloc C++ de la tâche courante (imbricable)
+class MemScope {
+public:
+    explicit MemScope(MemTag tag);
+    ~MemScope();
+private:
+    MemTag m_prev;
+};
+
+// Toute allocation de la tâche courante est une infraction
+class MemNoAlloc {
+public:
+    explicit MemNoAlloc(const char* what);
+    ~MemNoAlloc();
+private:
+    const char* m_prev;
+};
+
+void     mem_track_set_budget(MemTag tag, uint32_t bytes);
+bool     mem_track_get(MemTag tag, MemTagStats& out);
+uint32_t mem_track_violations();         // MemNoAlloc + budgets, toutes étiquettes
+void     mem_track_report();
+
+#else
+
+inline void* mem_alloc(MemTag, size_t bytes, uint32_t caps) { return heap_caps_malloc(bytes, caps); }
+inline void  mem_free(void* p)                              { heap_caps_free(p); }
+
+class MemScope   { public: explicit MemScope(MemTag) {} };
+class MemNoAlloc { public: explicit MemNoAlloc(const char*) {} };
+
+inline void     mem_track_set_budget(MemTag, uint32_t) {}
+inline bool     mem_track_get(MemTag, MemTagStats&)    { return false; }
+inline uint32_t mem_track_violations()                 { return 0; }
+inline void     mem_track_report()                     {}
+
+#endif
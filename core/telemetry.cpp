@@ -0,0 +1,179 @@
+#include "telemetry.h"
+#include "core/audio.h"
+#include "game/config.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*
+============================================================
+  ÉTAT
+============================================================
+*/
+static bool            s_active = false;
+static int             s_sock   = -1;
+static sockaddr_in     s_dest {};
+static TelemetryFormat s_format = TelemetryFormat::Binary;
+static uint32_t        s_seq    = 0;
+
+// Tâches suivies. Le handle d'une tâche permanente est gardé dès qu'elle
+// est trouvée ; une tâche qui se termine (pmf_prerender) est recherchée à
+// chaque envoi, son handle pouvant désigner une tâche supprimée.
+struct TrackedTask {
+    const char* name;
+    bool        permanent;
+};
+static const TrackedTask s_tasks[] = {
+    { "GameTask",      true  },
+    { "InputTask",     true  },
+    { "audio_task",    true  },
+    { "wav_stream",    true  },
+    { "pmf_prerender", false },
+    { "TelemetryTask", true  },
+};
+static const int s_task_count = sizeof(s_tasks) / sizeof(s_tasks[0]);
+static TaskHandle_t s_task_handles[s_task_count] = {};
+
+/*
+============================================================
+  FRAMES (tâche jeu → tâche télémétrie)
+============================================================
+*/
+struct FrameAcc {
+    uint32_t n;
+    uint32_t sum, min, max;
+    uint32_t work_sum, work_max;
+    uint32_t late;
+};
+
+static FrameAcc     s_acc {};
+static portMUX_TYPE s_acc_mux = portMUX_INITIALIZER_UNLOCKED;
+
+void telemetry_frame(uint32_t interval_us, uint32_t work_us)
+{
+    if (!s_active)
+        return;
+
+    portENTER_CRITICAL(&s_acc_mux);
+    if (s_acc.n == 0 || interval_us < s_acc.min) s_acc.min = interval_us;
+    if (interval_us > s_acc.max)                 s_acc.max = interval_us;
+    if (work_us > s_acc.work_max)                s_acc.work_max = work_us;
+    s_acc.sum      += interval_us;
+    s_acc.work_sum += work_us;
+    if (interval_us > (uint32_t)GAME_FRAME_US * 3 / 2)
+        s_acc.late++;
+    s_acc.n++;
+    portEXIT_CRITICAL(&s_acc_mux);
+}
+
+/*
+============================================================
+  MESURE + ENVOI
+============================================================
+*/
+static void collect(TelemetrySample& s)
+{
+    s = TelemetrySample {};
+    s.seq       = s_seq++;
+    s.uptime_ms = (uint32_t)(esp_timer_get_time() / 1000);
+
+    FrameAcc a;
+    portENTER_CRITICAL(&s_acc_mux);
+    a = s_acc;
+    s_acc = FrameAcc {};
+    portEXIT_CRITICAL(&s_acc_mux);
+
+    s.frames = a.n;
+    if (a.n) {
+        s.frame_us_min = a.min;
+        s.frame_us_avg = a.sum / a.n;
+        s.frame_us_max = a.max;
+        s.work_us_avg  = a.work_sum / a.n;
+        s.work_us_max  = a.work_max;
+        s.late_frames  = a.late;
+    }
+
+    AudioStats as;
+    audio_get_stats(&as);
+    s.audio_underruns  = as.underruns;
+    s.audio_overflows  = as.overflows;
+    s.stream_underruns = as.stream_underruns;
+    s.fifo_used  = (uint8_t)audio_fifo_buffer_used();
+    s.fifo_count = (uint8_t)audio_fifo_buffer_count();
+
+    const uint32_t internal = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    s.heap_free      = heap_caps_get_free_size(internal);
+    s.heap_min_free  = heap_caps_get_minimum_free_size(internal);
+    s.heap_largest   = heap_caps_get_largest_free_block(internal);
+    s.psram_free     = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    s.psram_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM);
+    s.psram_largest  = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+
+    // Pile : high-water mark en octets (les tâches absentes sont omises)
+    for (int i = 0; i < s_task_count && s.task_count < TELEMETRY_MAX_TASKS; i++)
+    {
+        TaskHandle_t h = s_task_handles[i];
+        if (!h) {
+            h = xTaskGetHandle(s_tasks[i].name);
+            if (!h)
+                continue;
+            if (s_tasks[i].permanent)
+                s_task_handles[i] = h;
+        }
+        TelemetryTask& t = s.tasks[s.task_count++];
+        strncpy(t.name, s_tasks[i].name, sizeof(t.name) - 1);
+        t.stack_free = uxTaskGetStackHighWaterMark(h) * sizeof(StackType_t);
+    }
+}
+
+bool telemetry_start(const char* dest_ip, TelemetryFormat format)
+{
+    if (s_active)
+        return true;
+
+    s_sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s_sock < 0) {
+        printf("TELEMETRY: socket impossible\n");
+        return false;
+    }
+    int yes = 1;
+    setsockopt(s_sock, SOL_SOCKET, SO_BROADCAST, &yes, sizeof(yes));
+
+    s_dest.sin_family      = AF_INET;
+    s_dest.sin_port        = htons(TELEMETRY_PORT);
+    s_dest.sin_addr.s_addr = inet_addr(dest_ip ? dest_ip : TELEMETRY_DEST_IP);
+
+    s_format = format;
+    s_active = true;
+    printf("TELEMETRY: %s:%u (%s), toutes les %d ms\n",
+           dest_ip ? dest_ip : TELEMETRY_DEST_IP, (unsigned)TELEMETRY_PORT,
+           format == TelemetryFormat::Json ? "JSON" : "binaire", TELEMETRY_PERIOD_MS);
+    return true;
+}
+
+bool telemetry_active()
+{
+    return s_active;
+}
+
+void telemetry_send()
+{
+    if (!s_active)
+        return;
+
+    static TelemetrySample s;
+    static uint8_t         buf[TELEMETRY_MAX_PACKET];
+    collect(s);
+
+    size_t n = (s_format == TelemetryFormat::Json)
+             ? telemetry_to_json(s, (char*)buf, sizeof(buf))
+             : telemetry_encode(s, buf, sizeof(buf));
+    if (n)
+        sendto(s_sock, buf, n, 0, (const sockaddr*)&s_dest, sizeof(s_dest));
+}
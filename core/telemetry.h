@@ -0,0 +1,95 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+============================================================
+  telemetry.h — Télémétrie UDP (mesures de fonctionnement)
+------------------------------------------------------------
+Optionnelle (USE_TELEMETRY, lib/common.h) : la console ouvre
+son point d'accès WiFi et diffuse toutes les
+TELEMETRY_PERIOD_MS une mesure vers TELEMETRY_DEST_IP :
+ - frames : intervalle min / moyen / max, temps de travail
+   (logique + rendu), frames en retard ;
+ - audio : underruns, overflows, retards du streaming WAV,
+   remplissage FIFO ;
+ - mémoire : libre / minimum historique / plus grand bloc,
+   interne et PSRAM ;
+ - pile restante (high-water mark) des tâches principales.
+
+Format binaire compact (82 octets + ~15 par tâche,
+little-endian, cf. telemetry_format.cpp) ou JSON (une
+ligne). Le relevé des frames (telemetry_frame) ne coûte que
+quelques additions ; l'envoi se fait dans une tâche de basse
+priorité (task_telemetry).
+
+Lecture côté PC : tools/telemetry_viewer.cpp (même code de
+format, telemetry_format.cpp).
+============================================================
+*/
+
+static const uint16_t TELEMETRY_PORT      = 47900;
+static const int      TELEMETRY_PERIOD_MS = 1000;
+#define TELEMETRY_DEST_IP "192.168.4.255"      // diffusion sur le softAP
+
+static const int TELEMETRY_MAX_TASKS = 6;
+
+enum class TelemetryFormat : uint8_t {
+    Binary,
+    Json
+};
+
+struct TelemetryTask {
+    char     name[16];
+    uint32_t stack_free;          // octets jamais utilisés (high-water mark)
+};
+
+struct TelemetrySample {
+    uint32_t seq;
+    uint32_t uptime_ms;
+
+    // Frames depuis la mesure précédente
+    uint32_t frames;
+    uint32_t frame_us_min, frame_us_avg, frame_us_max;   // intervalle
+    uint32_t work_us_avg,  work_us_max;                  // update + draw + flush
+    uint32_t late_frames;                                // > 1,5 × GAME_FRAME_US
+
+    // Audio (cumulés depuis le démarrage)
+    uint32_t audio_underruns;
+    uint32_t audio_overflows;
+    uint32_t stream_underruns;
+    uint8_t  fifo_used, fifo_count;
+
+    // Mémoire (octets)
+    uint32_t heap_free,  heap_min_free,  heap_largest;
+    uint32_t psram_free, psram_min_free, psram_largest;
+
+    uint8_t       task_count;
+    TelemetryTask tasks[TELEMETRY_MAX_TASKS];
+};
+
+/*
+============================================================
+  FORMAT (telemetry_format.cpp, sans dépendance matérielle)
+============================================================
+*/
+static const size_t TELEMETRY_MAX_PACKET = 512;
+
+size_t telemetry_encode(const TelemetrySample& s, uint8_t* buf, size_t cap);
+bool   telemetry_decode(TelemetrySample& s, const uint8_t* buf, size_t size);
+size_t telemetry_to_json(const TelemetrySample& s, char* buf, size_t cap);
+
+/*
+============================================================
+  CONSOLE (telemetry.cpp)
+============================================================
+*/
+// Ouvre la socket ; dest_ip = nullptr → TELEMETRY_DEST_IP
+bool telemetry_start(const char* dest_ip, TelemetryFormat format);
+bool telemetry_active();
+
+// Une frame de jeu : intervalle depuis la précédente et temps de travail
+void telemetry_frame(uint32_t interval_us, uint32_t work_us);
+
+// Relève une mesure et l'envoie (task_telemetry)
+void telemetry_send();
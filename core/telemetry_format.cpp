@@ -0,0 +1,154 @@
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+============================================================
+  PAQUET BINAIRE (little-endian)
+------------------------------------------------------------
+    0  "PKTM"
+    4  u8  version
+    5  u8  nombre de tâches
+    6  u32 × 19 : seq, uptime_ms, frames, frame_us min/avg/max,
+       work_us avg/max, late_frames, underruns, overflows,
+       stream_underruns, heap free/min/largest, psram
+       free/min/largest, fifo_used | fifo_count << 8
+   82  par tâche : u8 longueur du nom, nom, u32 pile libre
+============================================================
+*/
+static const uint8_t TELEMETRY_VERSION = 1;
+
+struct Out {
+    uint8_t* p;
+    size_t   cap;
+    size_t   n  = 0;
+    bool     ok = true;
+
+    void u8(uint8_t v)   { if (n + 1 > cap) { ok = false; return; } p[n++] = v; }
+    void u32(uint32_t v) { for (int i = 0; i < 4; i++) u8((uint8_t)(v >> (8 * i))); }
+};
+
+struct In {
+    const uint8_t* p;
+    size_t         size;
+    size_t         n  = 0;
+    bool           ok = true;
+
+    uint8_t u8() { if (n + 1 > size) { ok = false; return 0; } return p[n++]; }
+    uint32_t u32()
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) v |= (uint32_t)u8() << (8 * i);
+        return v;
+    }
+};
+
+size_t telemetry_encode(const TelemetrySample& s, uint8_t* buf, size_t cap)
+{
+    Out o;
+    o.p   = buf;
+    o.cap = cap;
+
+    o.u8('P'); o.u8('K'); o.u8('T'); o.u8('M');
+    o.u8(TELEMETRY_VERSION);
+    int tasks = s.task_count < TELEMETRY_MAX_TASKS ? s.task_count : TELEMETRY_MAX_TASKS;
+    o.u8((uint8_t)tasks);
+
+    o.u32(s.seq);              o.u32(s.uptime_ms);
+    o.u32(s.frames);
+    o.u32(s.frame_us_min);     o.u32(s.frame_us_avg);   o.u32(s.frame_us_max);
+    o.u32(s.work_us_avg);      o.u32(s.work_us_max);    o.u32(s.late_frames);
+    o.u32(s.audio_underruns);  o.u32(s.audio_overflows); o.u32(s.stream_underruns);
+    o.u32(s.heap_free);        o.u32(s.heap_min_free);  o.u32(s.heap_largest);
+    o.u32(s.psram_free);       o.u32(s.psram_min_free); o.u32(s.psram_largest);
+    o.u32(s.fifo_used | (s.fifo_count << 8));
+
+    for (int i = 0; i < tasks; i++) {
+        size_t len = strnlen(s.tasks[i].name, sizeof(s.tasks[i].name) - 1);
+        o.u8((uint8_t)len);
+        for (size_t k = 0; k < len; k++)
+            o.u8((uint8_t)s.tasks[i].name[k]);
+        o.u32(s.tasks[i].stack_free);
+    }
+
+    return o.ok ? o.n : 0;
+}
+
+bool telemetry_decode(TelemetrySample& s, const uint8_t* buf, size_t size)
+{
+    In in;
+    in.p    = buf;
+    in.size = size;
+
+    if (size < 6 || memcmp(buf, "PKTM", 4) != 0 || buf[4] != TELEMETRY_VERSION)
+        return false;
+    in.n = 5;
+
+    s = TelemetrySample {};
+    int tasks = in.u8();
+    if (tasks > TELEMETRY_MAX_TASKS)
+        return false;
+
+    s.seq             = in.u32();  s.uptime_ms       = in.u32();
+    s.frames          = in.u32();
+    s.frame_us_min    = in.u32();  s.frame_us_avg    = in.u32();  s.frame_us_max  = in.u32();
+    s.work_us_avg     = in.u32();  s.work_us_max     = in.u32();  s.late_frames   = in.u32();
+    s.audio_underruns = in.u32();  s.audio_overflows = in.u32();  s.stream_underruns = in.u32();
+    s.heap_free       = in.u32();  s.heap_min_free   = in.u32();  s.heap_largest  = in.u32();
+    s.psram_free      = in.u32();  s.psram_min_free  = in.u32();  s.psram_largest = in.u32();
+    uint32_t fifo     = in.u32();
+    s.fifo_used  = (uint8_t)fifo;
+    s.fifo_count = (uint8_t)(fifo >> 8);
+
+    s.task_count = (uint8_t)tasks;
+    for (int i = 0; i < tasks; i++) {
+        size_t len = in.u8();
+        if (len >= sizeof(s.tasks[i].name))
+            return false;
+        for (size_t k = 0; k < len; k++)
+            s.tasks[i].name[k] = (char)in.u8();
+        s.tasks[i].name[len] = 0;
+        s.tasks[i].stack_free = in.u32();
+    }
+
+    return in.ok && in.n == size;
+}
+
+size_t telemetry_to_json(const TelemetrySample& s, char* buf, size_t cap)
+{
+    int n = snprintf(buf, cap,
+        "{\"seq\":%u,\"uptime_ms\":%u,"
+        "\"frames\":{\"n\":%u,\"min_us\":%u,\"avg_us\":%u,\"max_us\":%u,"
+        "\"work_avg_us\":%u,\"work_max_us\":%u,\"late\":%u},"
+        "\"audio\":{\"underruns\":%u,\"overflows\":%u,\"stream_underruns\":%u,"
+        "\"fifo\":%u,\"fifo_count\":%u},"
+        "\"heap\":{\"free\":%u,\"min_free\":%u,\"largest\":%u},"
+        "\"psram\":{\"free\":%u,\"min_free\":%u,\"largest\":%u},"
+        "\"stack_free\":{",
+        (unsigned)s.seq, (unsigned)s.uptime_ms,
+        (unsigned)s.frames, (unsigned)s.frame_us_min, (unsigned)s.frame_us_avg,
+        (unsigned)s.frame_us_max, (unsigned)s.work_us_avg, (unsigned)s.work_us_max,
+        (unsigned)s.late_frames,
+        (unsigned)s.audio_underruns, (unsigned)s.audio_overflows,
+        (unsigned)s.stream_underruns, (unsigned)s.fifo_used, (unsigned)s.fifo_count,
+        (unsigned)s.heap_free, (unsigned)s.heap_min_free, (unsigned)s.heap_largest,
+        (unsigned)s.psram_free, (unsigned)s.psram_min_free, (unsigned)s.psram_largest);
+    if (n < 0 || (size_t)n >= cap)
+        return 0;
+
+    int tasks = s.task_count < TELEMETRY_MAX_TASKS ? s.task_count : TELEMETRY_MAX_TASKS;
+    for (int i = 0; i < tasks; i++) {
+        int k = snprintf(buf + n, cap - n, "%s\"%.15s\":%u", i ? "," : "",
+                         s.tasks[i].name, (unsigned)s.tasks[i].stack_free);
+        if (k < 0 || (size_t)(n + k) >= cap)
+            return 0;
+        n += k;
+    }
+
+    if ((size_t)n + 3 > cap)
+        return 0;
+    buf[n++] = '}';
+    buf[n++] = '}';
+    buf[n]   = 0;
+    return n;
+}
@@ -17,8 +17,18 @@
 
 	// Pacman
 	constexpr int PACMAN_SIZE = 14;        	 // sprite ~ taille d’une tile
-	constexpr int PACMAN_SPEED = 3;  		 // vitesse de déplacement (pixels/frame)
 	constexpr int PACMAN_OFFSET = (TILE_SIZE - PACMAN_SIZE) / 2;
+
+	// Graine du hasard de la partie (fantômes effrayés, maison)
+	constexpr unsigned GAME_RNG_SEED = 123456u;
+
+	// Cadence de la simulation (tâche jeu)
+	constexpr int GAME_FRAME_US = 25000;     // 40 FPS
+
+	// Virages : intention gardée TURN_BUFFER_FRAMES frames après l'appui,
+	// virage anticipé / tardif (cornering) jusqu'à TURN_CORNER_PX du centre
+	constexpr int TURN_BUFFER_FRAMES = 6;
+	constexpr int TURN_CORNER_PX     = 6;
 	
 
 	// Fantômes
@@ -45,18 +55,16 @@
 	extern int debug;   // 0 = off, 1 = on
 	
 	// -----------------------------------------------------------------------------
-	// Vitesses arcade-faithful (pixels par frame)
+	// Vitesses arcade-faithful (8.8 pixels par frame, 0x100 = 1 px/frame)
 	// -----------------------------------------------------------------------------
 
-	// Vitesse normale des fantômes (Scatter/Chase)
-	#define GHOST_SPEED             2   // base
-
-	// Vitesse des fantômes dans les tunnels (≈ 40% arcade)
-	#define GHOST_SPEED_TUNNEL      1
+	// Vitesse 100 % arcade : les tables par niveau (level.cpp) en sont
+	// des pourcentages. 3,75 px/frame → Pac-Man niveau 1 (80 %) = 3 px/frame
+	#define SPEED_FULL_FP           0x03C0
 
-	// Vitesse des fantômes en mode Frightened (≈ 50% arcade)
-	#define GHOST_SPEED_FRIGHTENED  1
+	// Vitesse des yeux (Eaten) — fixe, plus rapide que tout le reste
+	#define GHOST_SPEED_EYES_FP     0x0400
 
-	// Vitesse des yeux (Eaten) — plus rapide que normal
-	#define GHOST_SPEED_EYES        4
+	// Nombre de pac-gommes du labyrinthe arcade (référence des seuils Elroy)
+	#define ARCADE_PELLET_COUNT     240
 
@@ -134,17 +134,17 @@ void FruitManager::update(int pellets_remaining, int level)
 
 /*
 ============================================================
-  draw(camera_y)
+  draw(camera_x, camera_y)
 ------------------------------------------------------------
 Dessine le fruit si actif.
 ============================================================
 */
-void FruitManager::draw(int camera_y) const
+void FruitManager::draw(int camera_x, int camera_y) const
 {
     if (!active)
         return;
 
-    int px = fruit.tile_c * TILE_SIZE + (TILE_SIZE - 14) / 2;
+    int px = fruit.tile_c * TILE_SIZE + (TILE_SIZE - 14) / 2 - camera_x;
     int py = fruit.tile_r * TILE_SIZE + (TILE_SIZE - 14) / 2 - camera_y;
 
     gfx_drawSprite(px, py, fruit.sprite, 14, 14);
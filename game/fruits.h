@@ -37,7 +37,7 @@ public:
     void update(int pellets_remaining, int level);
 
     // Dessine le fruit si actif
-    void draw(int camera_y) const;
+    void draw(int camera_x, int camera_y) const;
 
     // Collision Pac-Man → renvoie true si fruit mangé
     bool checkCollision(int pac_x, int pac_y, int& out_score);
@@ -2,7 +2,9 @@
 #include "level.h"
 #include "maze.h"
 #include "core/graphics.h"
-#include <string>
+#include "core/frame_arena.h"
+#include "core/draw_list.h"
+#include <stdio.h>
 #include "assets/pacman_pmf.h"
 #include "lib/audio_pmf.h"
 #include "core/audio.h"
@@ -11,10 +13,13 @@
 #include "assets/assets.h"
 #include "core/sprite.h"
 #include "core/input.h"
+#include "maze_view.h"
+#include "snapshot.h"
 
 extern AudioPMF audioPMF;
 extern int debug;
 
+float g_camera_x = 0.0f;
 float g_camera_y = 0.0f;
 
 #define DBG(code) do { if (debug) { code; } } while(0)
@@ -97,8 +102,13 @@ void update_floating_scores(GameState& g)
   FRIGHTENED : DÉCLENCHEMENT
 ============================================================
 */
+// Musique plus rapide pendant le mode Frightened (8.8, 256 = normal)
+static const uint16_t MUSIC_TEMPO_FRIGHTENED = 256 * 115 / 100;
+
 void game_trigger_frightened(GameState& g)
 {
+    audioPMF.setTempo(MUSIC_TEMPO_FRIGHTENED);
+
     g.frightened_timer_ticks = g.frightened_duration_ticks;
     g.frightened_chain = 0;
 
@@ -119,6 +129,7 @@ static void update_frightened(GameState& g)
 
         if (g.frightened_timer_ticks == 0)
         {
+            audioPMF.setTempo(256);
             for (auto& gh : g.ghosts)
                 gh.on_end_frightened();
         }
@@ -195,7 +206,7 @@ void detect_portals(GameState& g)
     g.portalV = GameState::PortalPair{};
 
     // --- Horizontal ---
-    for (int r = 0; r < MAZE_HEIGHT; r++)
+    for (int r = 0; r < m.rows; r++)
         if (m.tiles[r][0] == TileType::Tunnel)
         {
             g.portalH.T0_r = r;
@@ -205,13 +216,13 @@ void detect_portals(GameState& g)
             break;
         }
 
-    for (int r = 0; r < MAZE_HEIGHT; r++)
-        if (m.tiles[r][MAZE_WIDTH-1] == TileType::Tunnel)
+    for (int r = 0; r < m.rows; r++)
+        if (m.tiles[r][m.cols-1] == TileType::Tunnel)
         {
             g.portalH.T1_r = r;
-            g.portalH.T1_c = MAZE_WIDTH-1;
+            g.portalH.T1_c = m.cols-1;
             g.portalH.E1_r = r;
-            g.portalH.E1_c = MAZE_WIDTH-2;
+            g.portalH.E1_c = m.cols-2;
             break;
         }
 
@@ -221,7 +232,7 @@ void detect_portals(GameState& g)
         g.portalH.exists = true;
 
     // --- Vertical ---
-    for (int c = 0; c < MAZE_WIDTH; c++)
+    for (int c = 0; c < m.cols; c++)
         if (m.tiles[0][c] == TileType::Tunnel)
         {
             g.portalV.T0_r = 0;
@@ -231,12 +242,12 @@ void detect_portals(GameState& g)
             break;
         }
 
-    for (int c = 0; c < MAZE_WIDTH; c++)
-        if (m.tiles[MAZE_HEIGHT-1][c] == TileType::Tunnel)
+    for (int c = 0; c < m.cols; c++)
+        if (m.tiles[m.rows-1][c] == TileType::Tunnel)
         {
-            g.portalV.T1_r = MAZE_HEIGHT-1;
+            g.portalV.T1_r = m.rows-1;
             g.portalV.T1_c = c;
-            g.portalV.E1_r = MAZE_HEIGHT-2;
+            g.portalV.E1_r = m.rows-2;
             g.portalV.E1_c = c;
             break;
         }
@@ -258,6 +269,7 @@ static void reset_level(GameState& g)
     g.pacman.tile_r = g.pacman_start_r;
     g.pacman.tile_c = g.pacman_start_c;
     g.pacman.pixel_offset = 0;
+    g.pacman.corner_off = 0;
     g.pacman.dir = Pacman::Dir::Left;
     g.pacman.next_dir = Pacman::Dir::Left;
 
@@ -341,6 +353,7 @@ static void reset_level_full(GameState& g)
 
     g.frightened_timer_ticks = 0;
     g.frightened_chain = 0;
+    audioPMF.setTempo(256);
     g.ghostDoorState = GameState::DoorState::Closed;
     g.ghostDoorTimer_ticks = 0;
     g.elapsed_ticks = 0;
@@ -366,6 +379,10 @@ static void reset_level_full(GameState& g)
 void game_init(GameState& g) {
     g.score = 0;
     g.lives = 3;
+    g.level = 1;
+    g.rng   = GAME_RNG_SEED;
+    g.ghost_player = -1;
+    rewind_clear();
 
     level_init(g);
     detect_portals(g);
@@ -389,6 +406,9 @@ void game_init(GameState& g) {
         );
         g.ghosts[i].houseState = Ghost::HouseState::Inside;
     }
+    g.floatingScores.clear();
+    g.floatingScores.reserve(FLOATING_SCORES_RESERVE);
+    level_apply_speeds(g);
 
     init_ghost_schedule(g);
 
@@ -400,6 +420,7 @@ void game_init(GameState& g) {
 
     g.frightened_timer_ticks = 0;
     g.frightened_chain = 0;
+    audioPMF.setTempo(256);
     g.ghostDoorState = GameState::DoorState::Closed;
     g.ghostDoorTimer_ticks = 0;
     g.elapsed_ticks = 0;
@@ -409,28 +430,36 @@ void game_init(GameState& g) {
 
     audioPMF.stop();
     audioPMF.init(pacman_pmf);
+    // Boucle pré-rendue aux deux tempos joués (normal / Frightened),
+    // en ADPCM : ~0,6 + 0,5 Mo de PSRAM au lieu de 4,7 Mo en PCM
+    audioPMF.setPrerender(true, PMF_PRERENDER_ADPCM, MUSIC_TEMPO_FRIGHTENED);
     // La musique PMF sera lancée au bon moment
     audio_play_begin();
 }
 
 /*
 ============================================================
-  CAMÉRA VERTICALE
+  CAMÉRA 2D
+------------------------------------------------------------
+Centrée sur Pac-Man, bornée au labyrinthe sur chaque axe
+(axe fixe à 0 si le labyrinthe tient dans l'écran).
 ============================================================
 */
-static void update_camera(const GameState& g)
+static int camera_axis(int center, int screen, int maze_px)
 {
-    int maze_height_px = MAZE_HEIGHT * TILE_SIZE;
-    int max_scroll = maze_height_px - SCREEN_H;
+    int max_scroll = maze_px - screen;
     if (max_scroll < 0) max_scroll = 0;
 
-    int pac_center_y = g.pacman.y + PACMAN_SIZE / 2;
-    int target_y = pac_center_y - SCREEN_H / 2;
-
-    if (target_y < 0) target_y = 0;
-    if (target_y > max_scroll) target_y = max_scroll;
+    int target = center - screen / 2;
+    if (target < 0) target = 0;
+    if (target > max_scroll) target = max_scroll;
+    return target;
+}
 
-    g_camera_y = (float)target_y;
+static void update_camera(const GameState& g)
+{
+    g_camera_x = (float)camera_axis(g.pacman.x + PACMAN_SIZE / 2, SCREEN_W, g.maze.widthPx());
+    g_camera_y = (float)camera_axis(g.pacman.y + PACMAN_SIZE / 2, SCREEN_H, g.maze.heightPx());
 }
 
 /*
@@ -533,7 +562,7 @@ static void update_state_starting_level(GameState& g)
     {
         update_floating_scores(g);
 
-        if (g_keys.A) {
+        if (g.input.A) {
             g.ready_waiting_for_input = false;
             g.state = GameState::State::Playing;
         }
@@ -543,6 +572,7 @@ static void update_state_starting_level(GameState& g)
 
     // Pac-Man et fantômes figés sur la position de départ
     g.pacman.pixel_offset = 0;
+    g.pacman.corner_off = 0;
     for (auto& gh : g.ghosts)
         gh.pixel_offset = 0;
 
@@ -620,7 +650,7 @@ static void update_state_gameover(GameState& g)
 
     if (g.gameover_waiting_for_input)
     {
-        if (g_keys.A)
+        if (g.input.A)
         {
             g.gameover_waiting_for_input = false;
             g.state = GameState::State::TitleScreen;
@@ -635,6 +665,8 @@ static void update_state_gameover(GameState& g)
 ============================================================
 */
 void game_update(GameState& g) {
+    frame_arena_reset();    // listes temporaires de l'étape précédente
+
     g.elapsed_ticks++;
 
     update_frightened(g);
@@ -663,6 +695,7 @@ void game_update(GameState& g) {
         case GameState::State::Paused:
         case GameState::State::Options:
         case GameState::State::OptionsMenu:
+        case GameState::State::AudioDebug:
         case GameState::State::Highscores:
             // Pas de logique de gameplay ici pour l’instant
             break;
@@ -672,35 +705,46 @@ void game_update(GameState& g) {
 /*
 ============================================================
   RENDU GLOBAL (game_draw)
+------------------------------------------------------------
+Émet la frame dans la draw list (core/draw_list.h), puis la
+soumet : fond, acteurs, effets et HUD sont ordonnés par
+couche, quel que soit l'ordre d'émission.
 ============================================================
 */
+static void draw_background(const void* ctx)
+{
+    // Labyrinthe via le cache de tuiles (efface tout l'écran)
+    const Maze& maze = *static_cast<const Maze*>(ctx);
+    maze_view_draw(maze, (int)g_camera_x, (int)g_camera_y);
+}
+
+static void draw_floating_scores(const GameState& g)
+{
+    for (const auto& fs : g.floatingScores)
+        draw_list_text(DrawLayer::Effects,
+                       fs.x - (int)g_camera_x, fs.y - (int)g_camera_y,
+                       frame_printf("%d", fs.value), COLOR_YELLOW);
+}
+
+static void draw_hud(const GameState& g)
+{
+    draw_list_text(DrawLayer::Hud, 4,   4, frame_printf("SCORE: %d", g.score), COLOR_WHITE);
+    draw_list_text(DrawLayer::Hud, 180, 4, frame_printf("LIVES: %d", g.lives), COLOR_YELLOW);
+}
+
 void game_draw(const GameState& g) {
-    gfx_clear(COLOR_BLACK);
+    frame_arena_reset();
+    draw_list_begin();
 
-    // Labyrinthe
-    g.maze.draw();
+    draw_list_call(DrawLayer::Background, draw_background, &g.maze);
 
     switch (g.state)
     {
         case GameState::State::StartingLevel:
-        {
             g.pacman.draw(g);
-
-            gfx_text(150, 120, "READY!", COLOR_YELLOW);
-
-            for (const auto& fs : g.floatingScores)
-            {
-                char buf[16];
-                snprintf(buf, sizeof(buf), "%d", fs.value);
-                int screen_x = fs.x;
-                int screen_y = fs.y - (int)g_camera_y;
-                gfx_text(screen_x, screen_y, buf, COLOR_YELLOW);
-            }
-
-            gfx_text(4,   4, ("SCORE: " + std::to_string(g.score)).c_str(), COLOR_WHITE);
-            gfx_text(180, 4, ("LIVES: " + std::to_string(g.lives)).c_str(), COLOR_YELLOW);
-            return;
-        }
+            draw_list_text(DrawLayer::Hud, 150, 120, "READY!", COLOR_YELLOW);
+            draw_floating_scores(g);
+            break;
 
         case GameState::State::PacmanDying:
         {
@@ -708,59 +752,31 @@ void game_draw(const GameState& g) {
             if (frame < 0)   frame = 0;
             if (frame > 11)  frame = 11;
 
-            const uint16_t* sprite = pacman_death_anim[frame];
-
-            int screen_x = g.pacman.x + 1;
-            int screen_y = g.pacman.y + 1 - (int)g_camera_y;
-
-            gfx_drawSprite(screen_x, screen_y, sprite, 14, 14);
-
-            for (const auto& fs : g.floatingScores)
-            {
-                char buf[16];
-                snprintf(buf, sizeof(buf), "%d", fs.value);
-                int screen_x = fs.x;
-                int screen_y = fs.y - (int)g_camera_y;
-                gfx_text(screen_x, screen_y, buf, COLOR_YELLOW);
-            }
-
-            gfx_text(4,   4, ("SCORE: " + std::to_string(g.score)).c_str(), COLOR_WHITE);
-            gfx_text(180, 4, ("LIVES: " + std::to_string(g.lives)).c_str(), COLOR_YELLOW);
-            return;
+            draw_list_sprite(DrawLayer::Actors,
+                             g.pacman.x + 1 - (int)g_camera_x,
+                             g.pacman.y + 1 - (int)g_camera_y,
+                             pacman_death_anim[frame], 14, 14);
+            draw_floating_scores(g);
+            break;
         }
 
         case GameState::State::GameOver:
-        {
-            gfx_text(100, 120, "GAME OVER", COLOR_RED);
-            gfx_text(110, 140, "PRESS A",   COLOR_WHITE);
-
-            gfx_text(4,   4, ("SCORE: " + std::to_string(g.score)).c_str(), COLOR_WHITE);
-            gfx_text(180, 4, ("LIVES: " + std::to_string(g.lives)).c_str(), COLOR_YELLOW);
-            return;
-        }
+            draw_list_text(DrawLayer::Hud, 100, 120, "GAME OVER", COLOR_RED);
+            draw_list_text(DrawLayer::Hud, 110, 140, "PRESS A",   COLOR_WHITE);
+            break;
 
         case GameState::State::Playing:
         default:
+            // État normal : Pac-Man + fantômes (par-dessus)
+            g.pacman.draw(g);
+            for (const auto& ghost : g.ghosts)
+                ghost.draw(g);
+            draw_floating_scores(g);
             break;
     }
 
-    // État normal : Pac-Man + fantômes
-    g.pacman.draw(g);
-
-    for (const auto& ghost : g.ghosts)
-        ghost.draw(g);
-
-    for (const auto& fs : g.floatingScores)
-    {
-        char buf[16];
-        snprintf(buf, sizeof(buf), "%d", fs.value);
-        int screen_x = fs.x;
-        int screen_y = fs.y - (int)g_camera_y;
-        gfx_text(screen_x, screen_y, buf, COLOR_YELLOW);
-    }
-
-    gfx_text(4,   4, ("SCORE: " + std::to_string(g.score)).c_str(), COLOR_WHITE);
-    gfx_text(180, 4, ("LIVES: " + std::to_string(g.lives)).c_str(), COLOR_YELLOW);
+    draw_hud(g);
+    draw_list_submit();
 }
 
 /*
@@ -4,6 +4,7 @@
 #include "ghost.h"
 #include "maze.h"
 #include "config.h"
+#include "core/input.h"
 
 /*
 ============================================================
@@ -42,6 +43,10 @@ struct FloatingScore {
     int timer = 0;            // durée d'affichage en frames
 };
 
+// Capacité réservée une fois (game_init) : pas de malloc en partie.
+// Les chemins des fantômes sont réservés par Ghost::Ghost.
+static const int FLOATING_SCORES_RESERVE = 8;
+
 /*
 ============================================================
   GAMESTATE : ÉTAT GLOBAL DU JEU
@@ -58,6 +63,7 @@ struct GameState {
         Paused,
         Options,
         OptionsMenu,
+        AudioDebug,
         Highscores,
         GameOver
     };
@@ -93,6 +99,8 @@ struct GameState {
     int gameover_timer = 0;
 
     Maze maze;
+    LevelSpeeds speeds {};      // vitesses du niveau (cf. level_pack.h)
+    Keys input {};              // entrées de la frame (input_read, tâche jeu)
     Pacman pacman;
 
     int pacman_start_r = 0;
@@ -149,8 +157,41 @@ struct GameState {
     int frightened_duration_ticks = 360;
     int frightened_blink_start_ticks = 120;
     int frightened_chain = 0;
+
+    /*
+    --------------------------------------------------------
+      HASARD (fait partie de l'état : rewind / save-states
+      rejouent les mêmes choix, cf. snapshot.h)
+    --------------------------------------------------------
+    */
+    uint32_t rng = GAME_RNG_SEED;
+
+    /*
+    --------------------------------------------------------
+      JEU À 2 (cf. netplay.h)
+    --------------------------------------------------------
+    ghost_player : fantôme dirigé par le joueur 2 (-1 = aucun)
+    ghost_input  : son entrée de la frame (NET_IN_*), non
+                   sauvegardée, comme input
+    */
+    int     ghost_player = -1;
+    uint8_t ghost_input  = 0;
 };
 
+/*
+============================================================
+  HASARD DE LA PARTIE (xorshift32)
+============================================================
+*/
+inline uint32_t game_rand(GameState& g)
+{
+    uint32_t x = g.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return g.rng = x;
+}
+
 /*
 ============================================================
   TUNNEL WRAP (PORTAILS)
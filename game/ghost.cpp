@@ -18,20 +18,23 @@ La logique est strictement arcade-faithful.
 #include "game/game.h"
 #include "maze.h"
 #include "config.h"
+#include "motion.h"
+#include "netplay.h"
 #include "assets/assets.h"
 #include "core/graphics.h"
 #include "core/sprite.h"
+#include "core/draw_list.h"
+#include "core/mem_track.h"
 
-#include <queue>
+#include <string.h>
 #include <algorithm>
-#include <random>
 #include <cmath>
 
+extern float g_camera_x;
 extern float g_camera_y;
 extern int   debug;
 
 // RNG pour frightened
-static std::mt19937 ghost_rng(123456);
 
 /*
 ============================================================
@@ -123,56 +126,71 @@ static bool bfs_to_target(const Maze& maze,
                           int tr, int tc,
                           std::vector<std::pair<int,int>>& path)
 {
-    struct Node { int r, c; };
     static const int dr[4] = {-1, +1, 0, 0};
     static const int dc[4] = {0, 0, -1, +1};
 
-    bool visited[MAZE_HEIGHT][MAZE_WIDTH] = {};
-    Node parent[MAZE_HEIGHT][MAZE_WIDTH];
+    // Index plat r * MAZE_MAX_COLS + c. Buffers statiques (tâche jeu
+    // uniquement) : rien sur la pile, seules les lignes du niveau
+    // sont remises à zéro.
+    static const int STRIDE = MAZE_MAX_COLS;
+    static bool     visited[MAZE_MAX_ROWS * MAZE_MAX_COLS];
+    static uint16_t parent[MAZE_MAX_ROWS * MAZE_MAX_COLS];
+    static uint16_t queue[MAZE_MAX_ROWS * MAZE_MAX_COLS];
 
-    std::queue<Node> q;
-    q.push({sr, sc});
-    visited[sr][sc] = true;
+    memset(visited, 0, maze.rows * STRIDE);
 
-    while (!q.empty())
+    int start  = sr * STRIDE + sc;
+    int target = tr * STRIDE + tc;
+    int head = 0, tail = 0;
+
+    queue[tail++] = (uint16_t)start;
+    visited[start] = true;
+
+    while (head < tail)
     {
-        Node n = q.front(); q.pop();
+        int n = queue[head++];
 
-        if (n.r == tr && n.c == tc)
+        if (n == target)
         {
-            // Reconstruction du chemin
-            path.clear();
-            int r = tr, c = tc;
+            // Reconstruction des PATH_RESERVE premiers pas au plus :
+            // le chemin tient toujours dans la capacité réservée
+            int len = 0;
+            for (int m = n; m != start; m = parent[m])
+                len++;
+            for (; len > Ghost::PATH_RESERVE; len--)
+                n = parent[n];
 
-            while (!(r == sr && c == sc))
+            path.clear();
+            while (n != start)
             {
-                path.push_back({r, c});
-                Node p = parent[r][c];
-                r = p.r;
-                c = p.c;
+                path.push_back({n / STRIDE, n % STRIDE});
+                n = parent[n];
             }
 
             std::reverse(path.begin(), path.end());
             return true;
         }
 
+        int r = n / STRIDE;
+        int c = n % STRIDE;
+
         for (int i = 0; i < 4; i++)
         {
-            int nr = n.r + dr[i];
-            int nc = n.c + dc[i];
+            int nr = r + dr[i];
+            int nc = c + dc[i];
 
-            if (nr < 0 || nr >= MAZE_HEIGHT ||
-                nc < 0 || nc >= MAZE_WIDTH)
+            if (!maze.inside(nr, nc))
                 continue;
 
             if (!is_walkable_for_eyes(maze.tiles[nr][nc]))
                 continue;
 
-            if (!visited[nr][nc])
+            int next = nr * STRIDE + nc;
+            if (!visited[next])
             {
-                visited[nr][nc] = true;
-                parent[nr][nc] = n;
-                q.push({nr, nc});
+                visited[next] = true;
+                parent[next]  = (uint16_t)n;
+                queue[tail++] = (uint16_t)next;
             }
         }
     }
@@ -187,6 +205,21 @@ static bool bfs_to_target(const Maze& maze,
 */
 Ghost::Ghost(int id_, int start_c, int start_r)
 {
+    reset_for_level(id_, start_c, start_r);
+
+    // Fantômes créés hors partie (game_init) : le BFS des yeux, plafonné
+    // à PATH_RESERVE pas, ne réalloue jamais pendant le jeu
+    path.reserve(PATH_RESERVE);
+}
+
+void Ghost::reset_for_level(int id_, int start_c, int start_r)
+{
+    // Valeurs par défaut, en gardant le tampon du chemin
+    std::vector<std::pair<int,int>> keep = std::move(path);
+    *this = Ghost();
+    path = std::move(keep);
+    path.clear();
+
     id = id_;
     start_col = start_c;
     start_row = start_r;
@@ -194,6 +227,7 @@ Ghost::Ghost(int id_, int start_c, int start_r)
     tile_c = start_c;
     tile_r = start_r;
     pixel_offset = 0;
+    sub_px = 0;
 
     x = tile_c * TILE_SIZE + (TILE_SIZE - GHOST_SIZE) / 2;
     y = tile_r * TILE_SIZE + (TILE_SIZE - GHOST_SIZE) / 2;
@@ -207,10 +241,13 @@ Ghost::Ghost(int id_, int start_c, int start_r)
     houseState = HouseState::Inside;
     eaten_timer = 0;
 
-    speed_normal     = GHOST_SPEED;
-    speed_frightened = GHOST_SPEED_FRIGHTENED;
-    speed_tunnel     = GHOST_SPEED_TUNNEL;
-    speed_eyes       = GHOST_SPEED_EYES;
+    // Vitesses du niveau 1 ; level_apply_speeds() les remplace
+    speed_normal     = SPEED_FULL_FP * 75 / 100;
+    speed_frightened = SPEED_FULL_FP * 50 / 100;
+    speed_tunnel     = SPEED_FULL_FP * 40 / 100;
+    speed_eyes       = GHOST_SPEED_EYES_FP;
+    speed_elroy1     = SPEED_FULL_FP * 80 / 100;
+    speed_elroy2     = SPEED_FULL_FP * 85 / 100;
 }
 
 /*
@@ -223,6 +260,7 @@ void Ghost::reset_to_start()
     tile_r = start_row;
     tile_c = start_col;
     pixel_offset = 0;
+    sub_px = 0;
 
     dir = Dir::Left;
     next_dir = Dir::Left;
@@ -263,11 +301,11 @@ void Ghost::on_end_frightened()
   Directions valides
 ============================================================
 */
-std::vector<Ghost::Dir> Ghost::getValidDirections(const GameState& g,
+FrameVector<Ghost::Dir> Ghost::getValidDirections(const GameState& g,
                                                   int row, int col,
                                                   bool is_eyes) const
 {
-    std::vector<Dir> dirs;
+    FrameVector<Dir> dirs;
     dirs.reserve(4);
 
     for (Dir d : {Dir::Up, Dir::Left, Dir::Down, Dir::Right})
@@ -275,8 +313,7 @@ std::vector<Ghost::Dir> Ghost::getValidDirections(const GameState& g,
         int nr = row + dirY(d);
         int nc = col + dirX(d);
 
-        if (nr < 0 || nr >= MAZE_HEIGHT ||
-            nc < 0 || nc >= MAZE_WIDTH)
+        if (!g.maze.inside(nr, nc))
             continue;
 
         TileType t = g.maze.tiles[nr][nc];
@@ -319,7 +356,8 @@ Ghost::Dir Ghost::chooseDirectionTowardsTarget(const GameState& g,
         return dir;
 
     // Évite le demi-tour si possible
-    std::vector<Dir> filtered;
+    FrameVector<Dir> filtered;
+    filtered.reserve(valid.size());
     for (Dir d : valid)
         if (!is_opposite(d, dir))
             filtered.push_back(d);
@@ -351,7 +389,7 @@ Ghost::Dir Ghost::chooseDirectionTowardsTarget(const GameState& g,
   Direction aléatoire (Frightened)
 ============================================================
 */
-Ghost::Dir Ghost::chooseRandomDir(const GameState& g,
+Ghost::Dir Ghost::chooseRandomDir(GameState& g,
                                   int row, int col,
                                   bool is_eyes) const
 {
@@ -359,7 +397,8 @@ Ghost::Dir Ghost::chooseRandomDir(const GameState& g,
     if (valid.empty())
         return dir;
 
-    std::vector<Dir> filtered;
+    FrameVector<Dir> filtered;
+    filtered.reserve(valid.size());
     for (Dir d : valid)
         if (!is_opposite(d, dir))
             filtered.push_back(d);
@@ -367,8 +406,39 @@ Ghost::Dir Ghost::chooseRandomDir(const GameState& g,
     if (!filtered.empty())
         valid = filtered;
 
-    std::uniform_int_distribution<int> dist(0, valid.size() - 1);
-    return valid[dist(ghost_rng)];
+    return valid[game_rand(g) % valid.size()];
+}
+
+/*
+============================================================
+  Direction du joueur 2 (jeu à 2, cf. netplay.h)
+------------------------------------------------------------
+Direction demandée si elle est libre (demi-tour compris),
+sinon on continue, sinon premier virage possible.
+============================================================
+*/
+Ghost::Dir Ghost::choosePlayerDir(const GameState& g, int row, int col) const
+{
+    auto valid = getValidDirections(g, row, col, false);
+    if (valid.empty())
+        return dir;
+
+    Dir wanted = Dir::None;
+    if (g.ghost_input & NET_IN_UP)    wanted = Dir::Up;
+    if (g.ghost_input & NET_IN_LEFT)  wanted = Dir::Left;
+    if (g.ghost_input & NET_IN_DOWN)  wanted = Dir::Down;
+    if (g.ghost_input & NET_IN_RIGHT) wanted = Dir::Right;
+
+    for (Dir d : valid)
+        if (d == wanted)
+            return d;
+    for (Dir d : valid)
+        if (d == dir)
+            return d;
+    for (Dir d : valid)
+        if (!is_opposite(d, dir))
+            return d;
+    return valid.front();
 }
 
 /*
@@ -380,11 +450,11 @@ void Ghost::getScatterTarget(const GameState& g, int& tr, int& tc) const
 {
     switch (id)
     {
-        case 0: tr = 0;              tc = MAZE_WIDTH - 1; break; // Blinky
-        case 1: tr = 0;              tc = 0;              break; // Pinky
-        case 2: tr = MAZE_HEIGHT - 1; tc = MAZE_WIDTH - 1; break; // Inky
-        case 3: tr = MAZE_HEIGHT - 1; tc = 0;              break; // Clyde
-        default: tr = 0; tc = MAZE_WIDTH - 1; break;
+        case 0: tr = 0;               tc = g.maze.cols - 1; break; // Blinky
+        case 1: tr = 0;               tc = 0;               break; // Pinky
+        case 2: tr = g.maze.rows - 1; tc = g.maze.cols - 1; break; // Inky
+        case 3: tr = g.maze.rows - 1; tc = 0;               break; // Clyde
+        default: tr = 0; tc = g.maze.cols - 1; break;
     }
 }
 
@@ -457,10 +527,11 @@ void Ghost::getChaseTarget(const GameState& g, int& tr, int& tc) const
   Choix direction dans la maison
 ============================================================
 */
-Ghost::Dir Ghost::chooseDirectionInsideHouse(const GameState& g,
+Ghost::Dir Ghost::chooseDirectionInsideHouse(GameState& g,
                                              int row, int col)
 {
-    std::vector<Dir> valid;
+    FrameVector<Dir> valid;
+    valid.reserve(4);
 
     auto try_add = [&](Dir d)
     {
@@ -479,7 +550,7 @@ Ghost::Dir Ghost::chooseDirectionInsideHouse(const GameState& g,
     if (valid.empty())
         return dir;
 
-    return valid[rand() % valid.size()];
+    return valid[game_rand(g) % valid.size()];
 }
 
 /*
@@ -489,6 +560,8 @@ Ghost::Dir Ghost::chooseDirectionInsideHouse(const GameState& g,
 */
 void Ghost::update(GameState& g)
 {
+    MemScope mem_scope(MemTag::Ghost);
+
     bool is_eyes = (mode == Mode::Eaten);
     int row = tile_r;
     int col = tile_c;
@@ -508,12 +581,22 @@ void Ghost::update(GameState& g)
     }
 
     // --------------------------------------------------------
-    // Vitesses selon mode
+    // Vitesses selon mode (8.8)
     // --------------------------------------------------------
-    int speed = speed_normal;
+    uint16_t speed = speed_normal;
     if (mode == Mode::Frightened) speed = speed_frightened;
     if (mode == Mode::Eaten)      speed = speed_eyes;
 
+    // Elroy : Blinky accélère en fin de niveau
+    if (id == 0 && houseState == HouseState::Outside &&
+        (mode == Mode::Scatter || mode == Mode::Chase))
+    {
+        if (g.maze.pellet_count <= g.speeds.elroy2_dots)
+            speed = speed_elroy2;
+        else if (g.maze.pellet_count <= g.speeds.elroy1_dots)
+            speed = speed_elroy1;
+    }
+
     if (g.maze.tiles[row][col] == TileType::Tunnel)
         speed = speed_tunnel;
 
@@ -545,12 +628,8 @@ void Ghost::update(GameState& g)
         }
 
         // Avancement
-        pixel_offset += speed;
-
-        if (pixel_offset >= TILE_SIZE)
+        if (motion_advance(pixel_offset, sub_px, speed))
         {
-            pixel_offset = 0;
-
             prev_tile_r = tile_r;
             prev_tile_c = tile_c;
 
@@ -603,9 +682,7 @@ void Ghost::update(GameState& g)
             if (isCentered())
                 dir = chooseDirectionInsideHouse(g, row, col);
 
-            pixel_offset += speed;
-
-            if (pixel_offset >= TILE_SIZE)
+            if (motion_advance(pixel_offset, sub_px, speed))
             {
                 int nr = row + dirY(dir);
                 int nc = col + dirX(dir);
@@ -615,8 +692,6 @@ void Ghost::update(GameState& g)
                     tile_r = nr;
                     tile_c = nc;
                 }
-
-                pixel_offset = 0;
             }
 
             x = tile_c * TILE_SIZE + (TILE_SIZE - GHOST_SIZE)/2 + dirX(dir) * pixel_offset;
@@ -662,12 +737,10 @@ void Ghost::update(GameState& g)
             }
         }
 
-        pixel_offset += speed;
-        if (pixel_offset >= TILE_SIZE)
+        if (motion_advance(pixel_offset, sub_px, speed))
         {
             tile_r += dirY(dir);
             tile_c += dirX(dir);
-            pixel_offset = 0;
         }
 
         x = tile_c * TILE_SIZE + (TILE_SIZE - GHOST_SIZE) / 2 + dirX(dir) * pixel_offset;
@@ -692,12 +765,10 @@ void Ghost::update(GameState& g)
         }
 
         // Avancer vers le haut
-        pixel_offset += speed;
-        if (pixel_offset >= TILE_SIZE)
+        if (motion_advance(pixel_offset, sub_px, speed))
         {
             tile_r += dirY(dir);
             tile_c += dirX(dir);
-            pixel_offset = 0;
         }
 
         x = tile_c * TILE_SIZE + (TILE_SIZE - GHOST_SIZE) / 2 + dirX(dir) * pixel_offset;
@@ -727,7 +798,11 @@ void Ghost::update(GameState& g)
     */
     if (isCentered())
     {
-        if (mode == Mode::Frightened)
+        if (id == g.ghost_player)
+        {
+            dir = choosePlayerDir(g, row, col);
+        }
+        else if (mode == Mode::Frightened)
         {
             dir = chooseRandomDir(g, row, col, is_eyes);
         }
@@ -750,16 +825,13 @@ void Ghost::update(GameState& g)
       5) Mouvement case-based + tunnel wrap
     ============================================================
     */
-    pixel_offset += speed;
-
-    if (pixel_offset >= TILE_SIZE)
+    if (motion_advance(pixel_offset, sub_px, speed))
     {
         prev_tile_r = tile_r;
         prev_tile_c = tile_c;
 
         tile_r += dirY(dir);
         tile_c += dirX(dir);
-        pixel_offset = 0;
 
         // Tunnel wrap
         if (try_portal_wrap(g, g.portalH, *this) ||
@@ -852,7 +924,7 @@ void Ghost::draw(const GameState& g) const
     };
 
     int frame = (animTick / 8) % 2;
-    int sx = x;
+    int sx = x - (int)g_camera_x;
     int sy = y - (int)g_camera_y;
 
     /*
@@ -861,7 +933,7 @@ void Ghost::draw(const GameState& g) const
     ------------------------------------------------------------
     */
     if (body_anim[0])
-        gfx_drawSprite(sx, sy, body_anim[frame], GHOST_SIZE, GHOST_SIZE);
+        draw_list_sprite(DrawLayer::Actors, sx, sy, body_anim[frame], GHOST_SIZE, GHOST_SIZE);
 
     /*
     ------------------------------------------------------------
@@ -881,10 +953,10 @@ void Ghost::draw(const GameState& g) const
         }
 
         const EyeOffset& off = eyeOffsets[idx];
-        gfx_drawSprite(sx + off.dx, sy + off.dy, eyes, 10, 5);
+        draw_list_sprite(DrawLayer::Actors, sx + off.dx, sy + off.dy, eyes, 10, 5);
     }
     else if (is_eyes)
     {
-        gfx_drawSprite(sx + 3, sy + 4, eyes, 10, 5);
+        draw_list_sprite(DrawLayer::Actors, sx + 3, sy + 4, eyes, 10, 5);
     }
 }
@@ -20,6 +20,7 @@ Les fantômes utilisent la même logique case-based que Pac-Man :
 
 #include "config.h"
 #include "maze.h"
+#include "core/frame_arena.h"
 #include <vector>
 
 struct GameState;
@@ -88,8 +89,9 @@ struct Ghost
     int prev_tile_r = 0;
     int prev_tile_c = 0;
 
-    // Progression dans la tuile (0..TILE_SIZE)
-    int pixel_offset = 0;
+    // Progression dans la tuile (0..TILE_SIZE) + fraction 8.8 (cf. motion.h)
+    int      pixel_offset = 0;
+    uint16_t sub_px       = 0;
 
     /*
     ------------------------------------------------------------
@@ -102,6 +104,7 @@ struct Ghost
 		  prev_tile_r(0),
 		  prev_tile_c(0),
 		  pixel_offset(0),
+		  sub_px(0),
 
 		  x(0),
 		  y(0),
@@ -119,6 +122,8 @@ struct Ghost
 		  speed_frightened(0),
 		  speed_tunnel(0),
 		  speed_eyes(0),
+		  speed_elroy1(0),
+		  speed_elroy2(0),
 
 		  id(-1),
 
@@ -170,17 +175,24 @@ struct Ghost
       Pathfinding (mode Eaten)
     ------------------------------------------------------------
     */
+    // Pas du BFS, réservés à la construction ; le BFS n'en garde pas
+    // plus (il repart de la case atteinte une fois le chemin consommé)
+    static const int PATH_RESERVE = 128;
     std::vector<std::pair<int,int>> path;
 
     /*
     ------------------------------------------------------------
-      Vitesses selon le mode
+      Vitesses selon le mode (8.8 pixels/frame)
     ------------------------------------------------------------
+    speed_elroy1/2 : Blinky (id 0) accélère quand il reste peu
+    de pac-gommes (seuils dans GameState::speeds).
     */
-    int speed_normal     = 0;
-    int speed_frightened = 0;
-    int speed_tunnel     = 0;
-    int speed_eyes       = 0;
+    uint16_t speed_normal     = 0;
+    uint16_t speed_frightened = 0;
+    uint16_t speed_tunnel     = 0;
+    uint16_t speed_eyes       = 0;
+    uint16_t speed_elroy1     = 0;
+    uint16_t speed_elroy2     = 0;
 
     /*
     ------------------------------------------------------------
@@ -224,9 +236,13 @@ struct Ghost
     ------------------------------------------------------------
     */
     void update(GameState& g);
-	void draw(const GameState& g) const;
+	void draw(const GameState& g) const;    // émet dans la draw list (game_draw)
     void reset_to_start();
 
+    // Nouveau niveau (level_init) : fantôme neuf, mais path garde sa
+    // capacité (appelé dans la frame de jeu, sans allocation)
+    void reset_for_level(int id_, int start_c, int start_r);
+
     /*
     ------------------------------------------------------------
       Gestion du mode Frightened
@@ -249,7 +265,8 @@ struct Ghost
       IA : directions valides
     ------------------------------------------------------------
     */
-    std::vector<Dir> getValidDirections(const GameState& g,
+    // Liste valable pour la frame en cours (core/frame_arena.h)
+    FrameVector<Dir> getValidDirections(const GameState& g,
                                         int row, int col,
                                         bool is_eyes) const;
 
@@ -263,13 +280,16 @@ struct Ghost
                                      int tr, int tc,
                                      bool is_eyes) const;
 
-    Dir chooseRandomDir(const GameState& g,
+    Dir chooseRandomDir(GameState& g,
                         int row, int col,
                         bool is_eyes) const;
 
-    Dir chooseDirectionInsideHouse(const GameState& g,
+    Dir chooseDirectionInsideHouse(GameState& g,
                                    int row, int col);
 
+    // Jeu à 2 : direction demandée par le joueur (g.ghost_input)
+    Dir choosePlayerDir(const GameState& g, int row, int col) const;
+
     /*
     ------------------------------------------------------------
       IA : cibles Scatter / Chase
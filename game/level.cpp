@@ -3,12 +3,80 @@
 #include "maze.h"
 #include "pacman.h"
 #include "ghost.h"
+#include "levels_preset.h"
+
+/*
+============================================================
+  TABLES DE VITESSES ARCADE
+------------------------------------------------------------
+Pourcentages de SPEED_FULL_FP par tranche de niveaux :
+niveau 1, 2-4, 5-20, 21+. Converties en 8.8 une seule fois
+par niveau ; le déplacement reste entier (cf. motion.h).
+============================================================
+*/
+static const uint8_t PCT_PACMAN[4]        = {  80,  90, 100,  90 };
+static const uint8_t PCT_PACMAN_FRIGHT[4] = {  90,  95, 100, 100 };
+static const uint8_t PCT_GHOST[4]         = {  75,  85,  95,  95 };
+static const uint8_t PCT_GHOST_TUNNEL[4]  = {  40,  45,  50,  50 };
+static const uint8_t PCT_GHOST_FRIGHT[4]  = {  50,  55,  60,  60 };
+static const uint8_t PCT_ELROY1[4]        = {  80,  90, 100, 100 };
+static const uint8_t PCT_ELROY2[4]        = {  85,  95, 105, 105 };
+
+// Seuils Elroy 1 (pac-gommes restantes sur ARCADE_PELLET_COUNT),
+// niveaux 1..19+ ; Elroy 2 à la moitié
+static const uint8_t ELROY1_DOTS[19] = {
+    20, 30, 40, 40, 40, 50, 50, 50, 60, 60, 60, 80, 80, 80, 100, 100, 100, 100, 120
+};
+
+static uint16_t pct_fp(uint8_t pct)
+{
+    return (uint16_t)((SPEED_FULL_FP * pct) / 100);
+}
+
+LevelSpeeds level_speeds_for(int level)
+{
+    if (level < 1) level = 1;
+
+    int band = (level == 1) ? 0 : (level <= 4) ? 1 : (level <= 20) ? 2 : 3;
+    int dots = ELROY1_DOTS[(level <= 19 ? level : 19) - 1];
+
+    LevelSpeeds s;
+    s.pacman            = pct_fp(PCT_PACMAN[band]);
+    s.ghost             = pct_fp(PCT_GHOST[band]);
+    s.ghost_tunnel      = pct_fp(PCT_GHOST_TUNNEL[band]);
+    s.ghost_frightened  = pct_fp(PCT_GHOST_FRIGHT[band]);
+    s.ghost_eyes        = GHOST_SPEED_EYES_FP;
+    s.frightened_ticks  = FRIGHTENED_DURATION_TICKS;
+    s.pacman_frightened = pct_fp(PCT_PACMAN_FRIGHT[band]);
+    s.ghost_elroy1      = pct_fp(PCT_ELROY1[band]);
+    s.ghost_elroy2      = pct_fp(PCT_ELROY2[band]);
+    s.elroy1_dots       = (uint16_t)dots;
+    s.elroy2_dots       = (uint16_t)(dots / 2);
+    return s;
+}
+
+void level_apply_speeds(GameState& g)
+{
+    for (auto& gh : g.ghosts)
+    {
+        gh.speed_normal     = g.speeds.ghost;
+        gh.speed_tunnel     = g.speeds.ghost_tunnel;
+        gh.speed_frightened = g.speeds.ghost_frightened;
+        gh.speed_eyes       = g.speeds.ghost_eyes;
+        gh.speed_elroy1     = g.speeds.ghost_elroy1;
+        gh.speed_elroy2     = g.speeds.ghost_elroy2;
+    }
+    g.frightened_duration_ticks = g.speeds.frightened_ticks;
+}
 
 void level_init(GameState &g)
 {
-    g.ghosts.clear();
+    // Niveau g.level (1 = premier) : pack binaire ou labyrinthe intégré
+    build_level(g.level - 1, g.maze, g.speeds);
 
-    maze_from_ascii(maze_B_ascii, g.maze);
+    // Seuils Elroy proportionnels au nombre de pac-gommes du labyrinthe
+    g.speeds.elroy1_dots = (uint16_t)(g.speeds.elroy1_dots * g.maze.pellet_count / ARCADE_PELLET_COUNT);
+    g.speeds.elroy2_dots = (uint16_t)(g.speeds.elroy2_dots * g.maze.pellet_count / ARCADE_PELLET_COUNT);
 
     // Pac-Man
     int prow = g.maze.pac_spawn_row;
@@ -22,18 +90,25 @@ void level_init(GameState &g)
     int grow = g.maze.ghost_center_row;
     int gcol = g.maze.ghost_center_col;
 
-    // Fantômes initialisés dans la maison
+    // Fantômes initialisés dans la maison. Niveau suivant (frame de jeu,
+    // MemNoAlloc) : les fantômes existants sont remis à neuf sur place
     auto addGhost = [&](int id, int col, int row)
     {
-        g.ghosts.push_back(Ghost(id, col, row));
-        g.ghosts.back().x = col * TILE_SIZE + GHOST_OFFSET;
-        g.ghosts.back().y = row * TILE_SIZE + GHOST_OFFSET;
-        g.ghosts.back().mode = Ghost::Mode::Scatter;
-        g.ghosts.back().houseState = Ghost::HouseState::Inside;
+        if ((int)g.ghosts.size() > id)
+            g.ghosts[id].reset_for_level(id, col, row);
+        else
+            g.ghosts.push_back(Ghost(id, col, row));
+        Ghost& gh = g.ghosts[id];
+        gh.x = col * TILE_SIZE + GHOST_OFFSET;
+        gh.y = row * TILE_SIZE + GHOST_OFFSET;
+        gh.mode = Ghost::Mode::Scatter;
+        gh.houseState = Ghost::HouseState::Inside;
     };
 
     addGhost(0, gcol, grow);
     addGhost(1, gcol - 1, grow);
     addGhost(2, gcol + 1, grow);
     addGhost(3, gcol, grow + 1);
+
+    level_apply_speeds(g);
 }
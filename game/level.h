@@ -1,8 +1,34 @@
 	#pragma once
+	#include <stdint.h>
 	struct GameState;     // forward only (pas d’include de game.h ici)
 	constexpr int LEVEL_ROWS = 21;
 	constexpr int LEVEL_COLS = 20;
 
+	// Vitesses d'un niveau (8.8 pixels/frame, 0x100 = 1 px/frame)
+	// Les 6 premiers champs peuvent venir du pack (level_pack.h),
+	// les autres viennent toujours de la table arcade.
+	struct LevelSpeeds {
+		uint16_t pacman;
+		uint16_t ghost;
+		uint16_t ghost_tunnel;
+		uint16_t ghost_frightened;
+		uint16_t ghost_eyes;
+		uint16_t frightened_ticks;
+
+		uint16_t pacman_frightened;   // Pac-Man pendant le mode Frightened
+		uint16_t ghost_elroy1;        // Blinky, reste ≤ elroy1_dots pac-gommes
+		uint16_t ghost_elroy2;        // Blinky, reste ≤ elroy2_dots pac-gommes
+		uint16_t elroy1_dots;
+		uint16_t elroy2_dots;
+	};
+
+	// Table arcade pour le niveau level (1 = premier) :
+	// % de SPEED_FULL_FP par tranche (1, 2-4, 5-20, 21+)
+	LevelSpeeds level_speeds_for(int level);
+
 	void level_init(GameState& g);
 
+	// Applique g.speeds aux fantômes et au mode Frightened
+	void level_apply_speeds(GameState& g);
+
 	extern const int level_grid[LEVEL_ROWS][LEVEL_COLS];
\ No newline at end of file
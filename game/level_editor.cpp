@@ -46,7 +46,7 @@ void level_editor_run(Level& lvl) {
 
         // Lecture des touches
         Keys k;
-        input_poll(k);
+        input_read(k);
 
         // Déplacement du curseur
  		if (k.raw & EXPANDER_KEY_LEFT)  cursor.gx = (cursor.gx - 1 + BRICK_COLS) % BRICK_COLS;
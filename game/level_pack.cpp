@@ -0,0 +1,272 @@
+#include "level_pack.h"
+#include "maze.h"
+#include "esp_partition.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+============================================================
+  SOURCE DU PACK
+============================================================
+*/
+static const char* LEVEL_PACK_PARTITION = "levels";
+static const char* LEVEL_PACK_PATH      = "/sdcard/PAKAMAN/levels.pak";
+
+static const int LEVEL_PACK_HEADER = 16;
+static const int LEVEL_RECORD_MAX  = LEVEL_RECORD_HEADER + MAZE_MAX_COLS * MAZE_MAX_ROWS;
+
+static struct {
+    bool                         opened = false;
+    const uint8_t*               map    = nullptr;   // partition mappée
+    esp_partition_mmap_handle_t  handle = 0;
+    uint32_t                     size   = 0;
+    FILE*                        file   = nullptr;   // ou fichier SD
+    uint16_t                     count  = 0;
+    uint32_t                     index_offset = 0;
+} s_pack;
+
+static inline uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static bool parse_header(const uint8_t* hdr, uint32_t pack_size)
+{
+    if (memcmp(hdr, "PKLV", 4) != 0 || rd16(hdr + 4) != LEVEL_PACK_VERSION)
+        return false;
+
+    s_pack.count        = rd16(hdr + 6);
+    s_pack.index_offset = rd32(hdr + 8);
+    if (s_pack.count == 0 ||
+        (uint64_t)s_pack.index_offset + s_pack.count * 8ULL > pack_size)
+        return false;
+    return true;
+}
+
+static bool open_partition()
+{
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           ESP_PARTITION_SUBTYPE_ANY,
+                                                           LEVEL_PACK_PARTITION);
+    if (!part)
+        return false;
+
+    const void* ptr = nullptr;
+    if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA,
+                           &ptr, &s_pack.handle) != ESP_OK)
+        return false;
+
+    if (!parse_header((const uint8_t*)ptr, part->size)) {
+        esp_partition_munmap(s_pack.handle);
+        return false;
+    }
+
+    s_pack.map  = (const uint8_t*)ptr;
+    s_pack.size = part->size;
+    printf("LEVELS: pack en flash (partition '%s'), %u niveaux\n",
+           LEVEL_PACK_PARTITION, (unsigned)s_pack.count);
+    return true;
+}
+
+static bool open_file()
+{
+    FILE* f = fopen(LEVEL_PACK_PATH, "rb");
+    if (!f)
+        return false;
+
+    uint8_t hdr[LEVEL_PACK_HEADER];
+    long size = 0;
+    if (fseek(f, 0, SEEK_END) == 0)
+        size = ftell(f);
+
+    if (size < LEVEL_PACK_HEADER || fseek(f, 0, SEEK_SET) != 0 ||
+        fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) ||
+        !parse_header(hdr, (uint32_t)size)) {
+        printf("LEVELS: %s invalide\n", LEVEL_PACK_PATH);
+        fclose(f);
+        return false;
+    }
+
+    s_pack.file = f;
+    s_pack.size = (uint32_t)size;
+    printf("LEVELS: pack sur SD (%s), %u niveaux\n", LEVEL_PACK_PATH, (unsigned)s_pack.count);
+    return true;
+}
+
+bool level_pack_open()
+{
+    if (!s_pack.opened)
+    {
+        s_pack.opened = true;
+        if (!open_partition() && !open_file())
+            printf("LEVELS: pas de pack, niveau intégré\n");
+    }
+    return s_pack.count > 0;
+}
+
+void level_pack_close()
+{
+    if (s_pack.map)
+        esp_partition_munmap(s_pack.handle);
+    if (s_pack.file)
+        fclose(s_pack.file);
+
+    s_pack.map    = nullptr;
+    s_pack.file   = nullptr;
+    s_pack.count  = 0;
+    s_pack.opened = false;
+}
+
+int level_pack_count()
+{
+    return s_pack.count;
+}
+
+/*
+============================================================
+  LECTURE D'UN NIVEAU
+============================================================
+*/
+
+// Pointeur sur l'enregistrement du niveau : directement dans la partition
+// mappée, ou dans un buffer statique rempli par une seule lecture SD
+static const uint8_t* fetch_record(int index, uint32_t& size)
+{
+    static uint8_t record[LEVEL_RECORD_MAX];
+
+    uint8_t entry[8];
+    uint32_t entry_pos = s_pack.index_offset + (uint32_t)index * 8;
+
+    if (s_pack.map)
+        memcpy(entry, s_pack.map + entry_pos, sizeof(entry));
+    else if (fseek(s_pack.file, entry_pos, SEEK_SET) != 0 ||
+             fread(entry, 1, sizeof(entry), s_pack.file) != sizeof(entry))
+        return nullptr;
+
+    uint32_t offset = rd32(entry);
+    size = rd32(entry + 4);
+    if (size < LEVEL_RECORD_HEADER || size > LEVEL_RECORD_MAX ||
+        (uint64_t)offset + size > s_pack.size)
+        return nullptr;
+
+    if (s_pack.map)
+        return s_pack.map + offset;
+
+    if (fseek(s_pack.file, offset, SEEK_SET) != 0 ||
+        fread(record, 1, size, s_pack.file) != size)
+        return nullptr;
+    return record;
+}
+
+// Position d'un enregistrement dans le labyrinthe (octets non signés)
+static bool rec_inside(int r, int c, int rows, int cols)
+{
+    return r >= 0 && c >= 0 && r < rows && c < cols;
+}
+
+// Toutes les positions lues par le jeu : maison, porte, départs, fruit, tunnels
+static bool rec_positions_ok(const uint8_t* rec, int rows, int cols)
+{
+    if (!rec_inside(rec[2], rec[3], rows, cols) ||      // Pac-Man
+        !rec_inside(rec[6], rec[7], rows, cols))        // porte
+        return false;
+
+    // level_init : centre, centre ± 1 colonne, centre + 1 ligne
+    int cr = rec[8], cc = rec[9];
+    if (!rec_inside(cr, cc - 1, rows, cols) || !rec_inside(cr + 1, cc + 1, rows, cols))
+        return false;
+
+    for (int i = 0; i < 4; i++)
+        if (!rec_inside(rec[10 + i], rec[14 + i], rows, cols))
+            return false;
+
+    bool no_fruit = (rec[4] == 0xFF && rec[5] == 0xFF);
+    if (!no_fruit && !rec_inside(rec[4], rec[5], rows, cols))
+        return false;
+
+    int tunnels = rec[18] > 2 ? 2 : rec[18];
+    for (int i = 0; i < tunnels; i++)
+        if (!rec_inside(rec[19 + i], rec[21 + i], rows, cols))
+            return false;
+    return true;
+}
+
+bool level_pack_load(int index, Maze& maze, LevelSpeeds& speeds)
+{
+    if (!level_pack_open())
+        return false;
+
+    index %= s_pack.count;
+    if (index < 0)
+        index += s_pack.count;
+
+    uint32_t size = 0;
+    const uint8_t* rec = fetch_record(index, size);
+    if (!rec) {
+        printf("LEVELS: niveau %d illisible\n", index);
+        return false;
+    }
+
+    int cols = rec[0];
+    int rows = rec[1];
+    if (cols < 3 || rows < 3 || cols > MAZE_MAX_COLS || rows > MAZE_MAX_ROWS ||
+        size < (uint32_t)(LEVEL_RECORD_HEADER + cols * rows)) {
+        printf("LEVELS: niveau %d de %dx%d non supporté\n", index, cols, rows);
+        return false;
+    }
+
+    if (!rec_positions_ok(rec, rows, cols)) {
+        printf("LEVELS: niveau %d : position hors du labyrinthe\n", index);
+        return false;
+    }
+
+    const uint8_t* tiles = rec + LEVEL_RECORD_HEADER;
+    for (int i = 0; i < cols * rows; i++)
+        if (tiles[i] > (uint8_t)TileType::FruitSpawn) {
+            printf("LEVELS: niveau %d : tuile invalide\n", index);
+            return false;
+        }
+    // Pack compact (cols octets par ligne), Maze au pas de MAZE_MAX_COLS
+    for (int r = 0; r < rows; r++)
+        memcpy(maze.tiles[r], tiles + r * cols, cols);
+    maze.cols = cols;
+    maze.rows = rows;
+
+    // Compteurs recalculés depuis les tuiles : ce sont eux qui terminent
+    // le niveau, ceux de l'entête ne servent qu'à signaler un pack incohérent
+    maze.pellet_count       = 0;
+    maze.power_pellet_count = 0;
+    for (int i = 0; i < cols * rows; i++) {
+        if (tiles[i] == (uint8_t)TileType::Pellet)      maze.pellet_count++;
+        if (tiles[i] == (uint8_t)TileType::PowerPellet) maze.power_pellet_count++;
+    }
+    if (maze.pellet_count != rd16(rec + 24) || maze.power_pellet_count != rd16(rec + 26))
+        printf("LEVELS: niveau %d : compteurs de l'entête (%u/%u) corrigés (%d/%d)\n",
+               index, (unsigned)rd16(rec + 24), (unsigned)rd16(rec + 26),
+               maze.pellet_count, maze.power_pellet_count);
+
+    maze.pac_spawn_row    = rec[2];
+    maze.pac_spawn_col    = rec[3];
+    maze.fruit_row        = rec[4] == 0xFF ? -1 : rec[4];
+    maze.fruit_col        = rec[5] == 0xFF ? -1 : rec[5];
+    maze.ghost_door_row   = rec[6];
+    maze.ghost_door_col   = rec[7];
+    maze.ghost_center_row = rec[8];
+    maze.ghost_center_col = rec[9];
+    for (int i = 0; i < 4; i++) {
+        maze.ghost_spawn_row[i] = rec[10 + i];
+        maze.ghost_spawn_col[i] = rec[14 + i];
+    }
+
+    maze.tunnel_entry_count = rec[18] > 2 ? 2 : rec[18];
+    for (int i = 0; i < maze.tunnel_entry_count; i++) {
+        maze.tunnel_entry_row[i] = rec[19 + i];
+        maze.tunnel_entry_col[i] = rec[21 + i];
+    }
+
+    speeds.pacman           = rd16(rec + 28);
+    speeds.ghost            = rd16(rec + 30);
+    speeds.ghost_tunnel     = rd16(rec + 32);
+    speeds.ghost_frightened = rd16(rec + 34);
+    speeds.ghost_eyes       = rd16(rec + 36);
+    speeds.frightened_ticks = rd16(rec + 38);
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <stdint.h>
+#include "level.h"
+
+/*
+============================================================
+  level_pack.h — Pack binaire de niveaux
+------------------------------------------------------------
+Tous les niveaux sont regroupés dans un seul fichier binaire
+(généré par tools/make_level_pack.py), lu :
+ - soit depuis la partition flash "levels" via esp_partition_mmap
+   (aucune copie : le niveau est lu directement en flash) ;
+ - soit depuis la carte SD (/sdcard/PAKAMAN/levels.pak) : seul
+   l'entête est lu à l'ouverture, puis un niveau = une lecture.
+
+Le nombre de niveaux ne change donc ni le temps de démarrage
+ni la RAM utilisée.
+
+Format (petit-boutiste) :
+
+  Entête (16 octets)
+    0   "PKLV"
+    4   u16 version (LEVEL_PACK_VERSION)
+    6   u16 nombre de niveaux
+    8   u32 position de l'index
+    12  u32 réservé
+
+  Index : nombre × { u32 position, u32 taille } (depuis le début du pack)
+
+  Niveau (LEVEL_RECORD_HEADER octets + tuiles)
+    0   u8 colonnes, u8 lignes (≤ MAZE_MAX_COLS × MAZE_MAX_ROWS)
+    2   u8 Pac-Man (ligne, colonne)
+    4   u8 fruit (ligne, colonne), 0xFF = aucun
+    6   u8 porte fantôme (ligne, colonne)
+    8   u8 centre de la maison (ligne, colonne)
+    10  u8 départ fantômes lignes[4], colonnes[4]
+    18  u8 nombre de tunnels, lignes[2], colonnes[2]
+    23  u8 réservé
+    24  u16 pac-gommes, u16 super pac-gommes (contrôle : recomptées
+        depuis les tuiles au chargement)
+    28  u16 vitesses 8.8 : Pac-Man, fantôme, tunnel, frightened, yeux
+    38  u16 durée frightened (ticks)
+    40  tuiles lignes × colonnes (TileType)
+============================================================
+*/
+
+struct Maze;
+
+static const uint16_t LEVEL_PACK_VERSION  = 1;
+static const int      LEVEL_RECORD_HEADER = 40;
+
+// Ouvre le pack (partition puis SD). Sans effet si déjà ouvert.
+// Retourne false si aucun pack valide n'est disponible.
+bool level_pack_open();
+void level_pack_close();
+
+// Nombre de niveaux du pack (0 = pas de pack)
+int level_pack_count();
+
+// Charge le niveau index (modulo le nombre de niveaux) dans maze.
+// Seules les vitesses de base sont remplacées ; Elroy et Pac-Man
+// en Frightened gardent la table arcade (level_speeds_for).
+bool level_pack_load(int index, Maze& maze, LevelSpeeds& speeds);
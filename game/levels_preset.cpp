@@ -1,7 +1,29 @@
 #include "levels_preset.h"
+#include "level_pack.h"
+#include "maze.h"
+#include "maze_gen.h"
+#include <stdio.h>
 
-Level build_level(int id){
-    Level L; L.id=id;
-    L.generate_grid(6,9,1);
-    return L;
+void build_level(int id, Maze& maze, LevelSpeeds& speeds)
+{
+    int packed = level_pack_count();
+
+    // Table arcade ; un niveau du pack en remplace les vitesses de base
+    speeds = level_speeds_for(id + 1);
+
+    if (packed > 0 && id < packed && level_pack_load(id, maze, speeds))
+        return;
+
+    // Mode sans fin : au-delà du pack (ou du niveau intégré),
+    // labyrinthe généré depuis le numéro de niveau
+    if (id > 0 && id >= packed)
+    {
+        MazeGenParams params;
+        params.seed = (uint32_t)id;
+        if (maze_generate(params, maze))
+            return;
+        printf("LEVELS: génération du niveau %d impossible\n", id);
+    }
+
+    maze_from_ascii(maze_B_ascii, MAZE_HEIGHT, maze);
 }
@@ -1,4 +1,10 @@
 #pragma once
 #include "level.h"
 
-Level build_level(int id);
+struct Maze;
+
+// Construit le niveau id (0 = premier) : niveaux du pack binaire si
+// présent (cf. level_pack.h), sinon labyrinthe intégré maze_B_ascii
+// pour le premier niveau ; ensuite labyrinthes générés (maze_gen.h)
+// avec les vitesses par défaut.
+void build_level(int id, Maze& maze, LevelSpeeds& speeds);
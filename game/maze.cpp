@@ -3,7 +3,9 @@
 #include "core/sprite.h"
 #include "game/config.h"
 #include "core/graphics.h"
+#include <string.h>
 
+extern float g_camera_x;
 extern float g_camera_y;
 
 /*
@@ -42,8 +44,8 @@ const char* maze_B_ascii[MAZE_HEIGHT] = {
 */
 void Maze::setGhostDoor(TileType newState)
 {
-    for (int r = 0; r < MAZE_HEIGHT; r++)
-        for (int c = 0; c < MAZE_WIDTH; c++)
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < cols; c++)
             if (isGhostDoorTile(tiles[r][c]))
                 tiles[r][c] = newState;
 }
@@ -53,8 +55,15 @@ void Maze::setGhostDoor(TileType newState)
   ASCII → MAZE
 ============================================================
 */
-void maze_from_ascii(const char* ascii[MAZE_HEIGHT], Maze& maze)
+void maze_from_ascii(const char* const* ascii, int rows, Maze& maze)
 {
+    int cols = (int)strlen(ascii[0]);
+    if (rows > MAZE_MAX_ROWS) rows = MAZE_MAX_ROWS;
+    if (cols > MAZE_MAX_COLS) cols = MAZE_MAX_COLS;
+
+    maze.rows = rows;
+    maze.cols = cols;
+
     maze.pellet_count        = 0;
     maze.power_pellet_count  = 0;
     maze.tunnel_entry_count  = 0;
@@ -63,11 +72,11 @@ void maze_from_ascii(const char* ascii[MAZE_HEIGHT], Maze& maze)
     int house_sum_c = 0;
     int house_count = 0;
 
-    for (int r = 0; r < MAZE_HEIGHT; r++)
+    for (int r = 0; r < rows; r++)
     {
         const char* line = ascii[r];
 
-        for (int c = 0; c < MAZE_WIDTH; c++)
+        for (int c = 0; c < cols; c++)
         {
             char ch = line[c];
             TileType t = TileType::Empty;
@@ -138,80 +147,74 @@ void maze_from_ascii(const char* ascii[MAZE_HEIGHT], Maze& maze)
 
 /*
 ============================================================
-  RENDU DU LABYRINTHE
+  SPRITE D'UNE CASE (nullptr = case noire)
 ============================================================
 */
-void Maze::draw() const
+const uint16_t* Maze::tileSprite(int r, int c) const
 {
-    for (int r = 0; r < MAZE_HEIGHT; r++)
+    switch (tiles[r][c])
     {
-        for (int c = 0; c < MAZE_WIDTH; c++)
-        {
-            TileType t = tiles[r][c];
-
-            int px = c * TILE_SIZE;
-            int py = r * TILE_SIZE;
-
-            int sx = px;
-            int sy = py - (int)g_camera_y;
-
-            if (sy < -TILE_SIZE || sy >= SCREEN_H)
-                continue;
-
-            switch (t)
-            {
-                case TileType::Wall:
-                    draw_sprite16(sx, sy, tile_wall);
-                    break;
+        case TileType::Wall:             return tile_wall;
+        case TileType::Pellet:           return tile_pacgum;
+        case TileType::PowerPellet:      return tile_powerdot;
+        case TileType::Tunnel:           return tile_tunnel_wall;
 
-                case TileType::Pellet:
-                    draw_sprite16(sx, sy, tile_pacgum);
-                    break;
-
-                case TileType::PowerPellet:
-                    draw_sprite16(sx, sy, tile_powerdot);
-                    break;
-
-                case TileType::Tunnel:
-                    draw_sprite16(sx, sy, tile_tunnel_wall);
-                    break;
-
-                case TileType::TunnelEntry:
-                {
-                    // Détection directionnelle robuste
-                    bool left  = (c > 0              && tiles[r][c-1] == TileType::Tunnel);
-                    bool right = (c < MAZE_WIDTH-1   && tiles[r][c+1] == TileType::Tunnel);
-                    bool up    = (r > 0              && tiles[r-1][c] == TileType::Tunnel);
-                    bool down  = (r < MAZE_HEIGHT-1  && tiles[r+1][c] == TileType::Tunnel);
-
-                    if (left)       draw_sprite16(sx, sy, tile_tunnel_entry_left);
-                    else if (right) draw_sprite16(sx, sy, tile_tunnel_entry_right);
-                    else if (up)    draw_sprite16(sx, sy, tile_tunnel_entry_up);
-                    else if (down)  draw_sprite16(sx, sy, tile_tunnel_entry_down);
-                    else            draw_sprite16(sx, sy, tile_tunnel_entry_neutral);
-                    break;
-                }
-
-                case TileType::GhostDoorClosed:
-                    draw_sprite16(sx, sy, tile_ghost_door_closed);
-                    break;
+        case TileType::TunnelEntry:
+        {
+            // Détection directionnelle robuste
+            bool left  = (c > 0      && tiles[r][c-1] == TileType::Tunnel);
+            bool right = (c < cols-1 && tiles[r][c+1] == TileType::Tunnel);
+            bool up    = (r > 0      && tiles[r-1][c] == TileType::Tunnel);
+            bool down  = (r < rows-1 && tiles[r+1][c] == TileType::Tunnel);
+
+            if (left)  return tile_tunnel_entry_left;
+            if (right) return tile_tunnel_entry_right;
+            if (up)    return tile_tunnel_entry_up;
+            if (down)  return tile_tunnel_entry_down;
+            return tile_tunnel_entry_neutral;
+        }
 
-                case TileType::GhostDoorOpening:
-                    draw_sprite16(sx, sy, tile_ghost_door_opening);
-                    break;
+        case TileType::GhostDoorClosed:  return tile_ghost_door_closed;
+        case TileType::GhostDoorOpening: return tile_ghost_door_opening;
+        case TileType::GhostDoorOpen:    return tile_ghost_door_open;
 
-                case TileType::GhostDoorOpen:
-                    draw_sprite16(sx, sy, tile_ghost_door_open);
-                    break;
+/*      case TileType::GhostHouse:
+            // Optionnel : motif discret
+            return tile_ghost_house;
+*/
+        default:
+            return nullptr;
+    }
+}
 
-/*                case TileType::GhostHouse:
-                    // Optionnel : motif discret
-                    draw_sprite16(sx, sy, tile_ghost_house);
-                    break;
+/*
+============================================================
+  RENDU DU LABYRINTHE (direct, sans cache)
+------------------------------------------------------------
+Seules les cases visibles sont parcourues : le coût dépend
+de l'écran, pas de la taille du labyrinthe.
+Avec le framebuffer, maze_view_draw() (maze_view.h) est
+utilisé à la place.
+============================================================
 */
-                default:
-                    break;
-            }
+void Maze::draw() const
+{
+    int cam_x = (int)g_camera_x;
+    int cam_y = (int)g_camera_y;
+    int r0 = cam_y / TILE_SIZE;
+    int c0 = cam_x / TILE_SIZE;
+    int r1 = (cam_y + SCREEN_H - 1) / TILE_SIZE;
+    int c1 = (cam_x + SCREEN_W - 1) / TILE_SIZE;
+    if (r0 < 0)     r0 = 0;
+    if (c0 < 0)     c0 = 0;
+    if (r1 >= rows) r1 = rows - 1;
+    if (c1 >= cols) c1 = cols - 1;
+
+    for (int r = r0; r <= r1; r++)
+        for (int c = c0; c <= c1; c++)
+        {
+            const uint16_t* sprite = tileSprite(r, c);
+            if (sprite)
+                draw_sprite16(c * TILE_SIZE - cam_x, r * TILE_SIZE - cam_y, sprite);
         }
-    }
 }
@@ -2,11 +2,17 @@
 #include <stdint.h>
 #include "level.h"
 #include "game/config.h"
-#include "core/graphics.h"
 
-// Dimensions du labyrinthe (ASCII)
-static const int MAZE_WIDTH  = LEVEL_COLS;  // doit être 20
-static const int MAZE_HEIGHT = LEVEL_ROWS;  // doit être 21
+// Dimensions du labyrinthe intégré (maze_B) et des labyrinthes générés
+static const int MAZE_WIDTH  = LEVEL_COLS;  // 20
+static const int MAZE_HEIGHT = LEVEL_ROWS;  // 21
+
+// Capacité du stockage : les niveaux du pack peuvent aller jusqu'à
+// cette taille (28×31 arcade compris). Le pas de ligne est fixe
+// (MAZE_MAX_COLS) : tiles[r][c] reste un simple décalage constant,
+// seules les boucles s'arrêtent à rows / cols.
+static const int MAZE_MAX_COLS = 32;
+static const int MAZE_MAX_ROWS = 36;
 
 /*
 ============================================================
@@ -39,7 +45,19 @@ enum class TileType : uint8_t {
 */
 struct Maze {
 
-    TileType tiles[MAZE_HEIGHT][MAZE_WIDTH];
+    TileType tiles[MAZE_MAX_ROWS][MAZE_MAX_COLS];
+
+    // Dimensions réelles du niveau (≤ MAZE_MAX_*)
+    int cols = MAZE_WIDTH;
+    int rows = MAZE_HEIGHT;
+
+    bool inside(int r, int c) const
+    {
+        return (unsigned)r < (unsigned)rows && (unsigned)c < (unsigned)cols;
+    }
+
+    int widthPx()  const { return cols * TILE_SIZE; }
+    int heightPx() const { return rows * TILE_SIZE; }
 
     // Comptage
     int pellet_count       = 0;
@@ -75,6 +93,9 @@ struct Maze {
     */
     void draw() const;
 
+    // Sprite 16×16 de la case (r, c), nullptr = case noire
+    const uint16_t* tileSprite(int r, int c) const;
+
     /*
     --------------------------------------------------------
       Mise à jour de la porte fantôme
@@ -89,7 +110,8 @@ struct Maze {
   CHARGEMENT ASCII → MAZE
 ============================================================
 */
-void maze_from_ascii(const char* ascii[MAZE_HEIGHT], Maze& maze);
+// rows lignes de même longueur (= nombre de colonnes)
+void maze_from_ascii(const char* const* ascii, int rows, Maze& maze);
 
 /*
 ============================================================
@@ -0,0 +1,678 @@
+#include "maze_gen.h"
+#include <string.h>
+
+/*
+============================================================
+  GÉOMÉTRIE
+------------------------------------------------------------
+  Symétrie : la colonne c a pour miroir cols-1-c.
+
+  Maison : intérieur 6×3 centré, entouré d'un mur d'une case.
+  Porte  : 2 cases au-dessus de la maison (miroir l'une de l'autre).
+  Couloirs obligatoires : ligne au-dessus de la porte, ligne
+  sous la maison, colonne de chaque côté de la maison.
+============================================================
+*/
+struct Geometry {
+    int W, H;
+    int house_r0, house_r1;     // intérieur de la maison
+    int house_c0, house_c1;
+    int row_above;              // couloir devant la porte
+    int row_below;              // couloir du départ Pac-Man
+    int col_beside;             // couloir à gauche de la maison
+
+    Geometry(int cols, int rows)
+        : W(cols), H(rows),
+          house_r0((rows - 3) / 2), house_r1((rows - 3) / 2 + 2),
+          house_c0(cols / 2 - 3),   house_c1(cols / 2 + 2),
+          row_above((rows - 3) / 2 - 2), row_below((rows - 3) / 2 + 4),
+          col_beside(cols / 2 - 5) {}
+
+    // Maison + son mur
+    bool in_house_block(int r, int c) const
+    {
+        return r >= house_r0 - 1 && r <= house_r1 + 1 &&
+               c >= house_c0 - 1 && c <= house_c1 + 1;
+    }
+};
+
+static const int MAX_ROWS  = MAZE_MAX_ROWS / 2 + 1;
+static const int MAX_COLS  = MAZE_MAX_COLS / 2 + 1;   // colonnes des deux moitiés
+static const int MAX_NODES = MAX_ROWS * MAX_COLS;
+static const int MAX_EDGES = MAX_NODES * 2;
+
+static const int GEN_ATTEMPTS = 8;
+
+/*
+============================================================
+  RNG (xorshift32, déterministe sur toutes les plateformes)
+============================================================
+*/
+struct GenRng {
+    uint32_t s;
+
+    explicit GenRng(uint32_t seed)
+    {
+        // Mélange de la graine (0 interdit pour xorshift)
+        s = seed * 2654435761u ^ 0x9E3779B9u;
+        if (s == 0) s = 0x6D2B79F5u;
+    }
+
+    uint32_t next()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+
+    // [lo, hi] inclus
+    int range(int lo, int hi) { return lo + (int)(next() % (uint32_t)(hi - lo + 1)); }
+};
+
+/*
+============================================================
+  TREILLIS DE COULOIRS
+------------------------------------------------------------
+  Nœuds = intersections lignes × colonnes du treillis.
+  Arêtes = segments de couloir entre deux nœuds voisins.
+  Tout est en tableaux fixes (statiques), rien n'est alloué.
+============================================================
+*/
+enum { ADJ_LEFT, ADJ_RIGHT, ADJ_UP, ADJ_DOWN };
+
+struct Lattice {
+    Geometry g {MAZE_WIDTH, MAZE_HEIGHT};
+
+    int rows[MAX_ROWS];
+    int cols[MAX_COLS];
+    int nrows = 0;
+    int ncols = 0;
+
+    struct Edge {
+        uint16_t a, b;      // nœuds (index ligne * ncols + colonne)
+        uint16_t mirror;    // arête symétrique (elle-même au centre)
+        bool     alive;
+        bool     locked;    // jamais retirée
+    };
+
+    Edge    edges[MAX_EDGES];
+    int     nedges = 0;
+    bool    node_ok[MAX_NODES];
+    uint8_t degree[MAX_NODES];
+    int16_t adj[MAX_NODES][4];  // arête vers chaque voisin, -1 = aucune
+
+    int tunnel_node[2] = {-1, -1};
+
+    int node(int ri, int ci) const { return ri * ncols + ci; }
+    int node_row(int n) const { return rows[n / ncols]; }
+    int node_col(int n) const { return cols[n % ncols]; }
+};
+
+// Ajoute des lignes entre from (exclu) et to (inclus), espacées de 2 à 4
+static void add_lines(GenRng& rng, int* out, int& n, int from, int to)
+{
+    int cur = from;
+    while (to - cur > 4 || (to - cur == 4 && (rng.next() & 1)))
+    {
+        int left = to - cur - 2;        // ne pas coller la ligne suivante
+        cur += rng.range(2, left < 4 ? left : 4);
+        out[n++] = cur;
+    }
+    out[n++] = to;
+}
+
+static void build_lattice(GenRng& rng, Lattice& L)
+{
+    const Geometry& G = L.g;
+
+    // --- Lignes ---
+    L.nrows = 0;
+    L.rows[L.nrows++] = 1;
+    add_lines(rng, L.rows, L.nrows, 1, G.row_above);
+    add_lines(rng, L.rows, L.nrows, G.row_above, G.row_below);
+    add_lines(rng, L.rows, L.nrows, G.row_below, G.H - 2);
+
+    // --- Colonnes (moitié gauche, puis miroir) ---
+    int half[MAX_COLS];
+    int nhalf = 0;
+    half[nhalf++] = 1;
+    add_lines(rng, half, nhalf, 1, G.col_beside);
+
+    // Colonne optionnelle entre la maison et l'axe central
+    // (jamais sur les 2 colonnes centrales : couloir de 2 de large)
+    if (G.col_beside + 2 <= G.W / 2 - 2 && (rng.next() & 3))
+        half[nhalf++] = rng.range(G.col_beside + 2, G.W / 2 - 2);
+
+    L.ncols = 0;
+    for (int i = 0; i < nhalf; i++)
+        L.cols[L.ncols++] = half[i];
+    for (int i = nhalf - 1; i >= 0; i--)
+        L.cols[L.ncols++] = G.W - 1 - half[i];
+
+    // --- Nœuds ---
+    for (int ri = 0; ri < L.nrows; ri++)
+        for (int ci = 0; ci < L.ncols; ci++)
+        {
+            int n = L.node(ri, ci);
+            L.node_ok[n] = !G.in_house_block(L.rows[ri], L.cols[ci]);
+            L.degree[n]  = 0;
+            for (int d = 0; d < 4; d++)
+                L.adj[n][d] = -1;
+        }
+
+    // --- Arêtes (horizontales puis verticales) ---
+    L.nedges = 0;
+    auto add_edge = [&](int a, int b, int dir_ab, int dir_ba) {
+        if (!L.node_ok[a] || !L.node_ok[b])
+            return;
+        // Segment traversant la maison ?
+        int r0 = L.node_row(a), c0 = L.node_col(a);
+        int r1 = L.node_row(b), c1 = L.node_col(b);
+        for (int r = r0; r <= r1; r++)
+            for (int c = c0; c <= c1; c++)
+                if (G.in_house_block(r, c))
+                    return;
+
+        int i = L.nedges++;
+        Lattice::Edge& e = L.edges[i];
+        e.a = (uint16_t)a;
+        e.b = (uint16_t)b;
+        e.mirror = 0;
+        e.alive  = true;
+        e.locked = false;
+        L.degree[a]++;
+        L.degree[b]++;
+        L.adj[a][dir_ab] = (int16_t)i;
+        L.adj[b][dir_ba] = (int16_t)i;
+    };
+
+    for (int ri = 0; ri < L.nrows; ri++)
+        for (int ci = 0; ci + 1 < L.ncols; ci++)
+            add_edge(L.node(ri, ci), L.node(ri, ci + 1), ADJ_RIGHT, ADJ_LEFT);
+    for (int ri = 0; ri + 1 < L.nrows; ri++)
+        for (int ci = 0; ci < L.ncols; ci++)
+            add_edge(L.node(ri, ci), L.node(ri + 1, ci), ADJ_DOWN, ADJ_UP);
+
+    // --- Symétriques ---
+    for (int i = 0; i < L.nedges; i++)
+    {
+        Lattice::Edge& e = L.edges[i];
+        int ri = e.a / L.ncols;
+        int ma = L.node(ri, L.ncols - 1 - e.a % L.ncols);
+
+        // Horizontale : le miroir part vers la gauche depuis ma
+        bool horizontal = (ri == e.b / L.ncols);
+        e.mirror = (uint16_t)L.adj[ma][horizontal ? ADJ_LEFT : ADJ_DOWN];
+
+        // Segments centraux devant la porte et au départ de Pac-Man
+        int row = L.node_row(e.a);
+        if (e.mirror == i && (row == G.row_above || row == G.row_below))
+            e.locked = true;
+    }
+}
+
+// Connexité du graphe des nœuds vivants (tunnel compris)
+static bool lattice_connected(const Lattice& L)
+{
+    const int nn = L.nrows * L.ncols;
+    uint16_t queue[MAX_NODES];
+    bool     seen[MAX_NODES];
+    memset(seen, 0, nn);
+
+    int start = -1, total = 0;
+    for (int n = 0; n < nn; n++)
+        if (L.node_ok[n] && L.degree[n] > 0) {
+            total++;
+            if (start < 0) start = n;
+        }
+    if (start < 0)
+        return false;
+
+    int head = 0, tail = 0;
+    queue[tail++] = (uint16_t)start;
+    seen[start] = true;
+
+    auto visit = [&](int o) {
+        if (!seen[o]) {
+            seen[o] = true;
+            queue[tail++] = (uint16_t)o;
+        }
+    };
+
+    while (head < tail)
+    {
+        int n = queue[head++];
+        for (int d = 0; d < 4; d++)
+        {
+            int i = L.adj[n][d];
+            if (i < 0 || !L.edges[i].alive) continue;
+            visit(L.edges[i].a == n ? L.edges[i].b : L.edges[i].a);
+        }
+        // Tunnel
+        if (L.tunnel_node[0] == n) visit(L.tunnel_node[1]);
+        if (L.tunnel_node[1] == n) visit(L.tunnel_node[0]);
+    }
+    return tail == total;
+}
+
+// Blocs de murs : chaque case du treillis (entre 2 lignes et 2 colonnes)
+// est un bloc ; retirer une arête fusionne les 2 blocs qu'elle sépare.
+// Union-find borné pour garder des blocs compacts.
+static const int MAX_FACES       = (MAX_ROWS - 1) * (MAX_COLS - 1);
+static const int MAX_BLOCK_FACES = 3;
+static const int FACE_OUTSIDE    = -1;   // bord extérieur : jamais fusionné
+static const int FACE_HOUSE      = -2;   // touche la maison : jamais fusionné
+
+struct Blocks {
+    int16_t parent[MAX_FACES];
+    uint8_t size[MAX_FACES];
+
+    int find(int f) const
+    {
+        while (parent[f] != f) f = parent[f];
+        return f;
+    }
+};
+
+static int face_at(const Lattice& L, int ri, int ci)
+{
+    if (ri < 0 || ci < 0 || ri >= L.nrows - 1 || ci >= L.ncols - 1)
+        return FACE_OUTSIDE;
+    for (int r = L.rows[ri]; r <= L.rows[ri + 1]; r++)
+        for (int c = L.cols[ci]; c <= L.cols[ci + 1]; c++)
+            if (L.g.in_house_block(r, c))
+                return FACE_HOUSE;
+    return ri * (L.ncols - 1) + ci;
+}
+
+// Les 2 blocs de part et d'autre d'une arête
+static void edge_faces(const Lattice& L, const Lattice::Edge& e, int& f0, int& f1)
+{
+    int ri = e.a / L.ncols, ci = e.a % L.ncols;
+    if (ri == e.b / L.ncols) {          // horizontale
+        f0 = face_at(L, ri - 1, ci);
+        f1 = face_at(L, ri, ci);
+    } else {                            // verticale
+        f0 = face_at(L, ri, ci - 1);
+        f1 = face_at(L, ri, ci);
+    }
+}
+
+// Retire des paires d'arêtes symétriques pour former des blocs de murs
+static void merge_blocks(GenRng& rng, Lattice& L, int merge_pct)
+{
+    static Blocks B;
+    for (int f = 0; f < MAX_FACES; f++) {
+        B.parent[f] = (int16_t)f;
+        B.size[f]   = 1;
+    }
+
+    static uint16_t order[MAX_EDGES];
+    for (int i = 0; i < L.nedges; i++)
+        order[i] = (uint16_t)i;
+    for (int i = L.nedges - 1; i > 0; i--) {
+        int j = rng.range(0, i);
+        uint16_t t = order[i]; order[i] = order[j]; order[j] = t;
+    }
+
+    int target  = L.nedges * merge_pct / 100;
+    int removed = 0;
+
+    for (int k = 0; k < L.nedges && removed < target; k++)
+    {
+        Lattice::Edge& e = L.edges[order[k]];
+        Lattice::Edge& m = L.edges[e.mirror];
+        if (!e.alive || e.locked)
+            continue;
+
+        // Chaque extrémité doit garder au moins 2 sorties (pas de cul-de-sac)
+        bool self = (&e == &m);
+        if (L.degree[e.a] < 3 || L.degree[e.b] < 3)
+            continue;
+
+        // Blocs fusionnés : ni bord, ni maison, taille bornée
+        int f0, f1, g0, g1;
+        edge_faces(L, e, f0, f1);
+        edge_faces(L, m, g0, g1);
+        if (f0 < 0 || f1 < 0 || g0 < 0 || g1 < 0)
+            continue;
+        f0 = B.find(f0); f1 = B.find(f1);
+        g0 = B.find(g0); g1 = B.find(g1);
+        if (f0 == f1 || g0 == g1)
+            continue;
+        int merged = B.size[f0] + B.size[f1];
+        if (!self && (g0 == f0 || g0 == f1 || g1 == f0 || g1 == f1))
+            merged += (g0 == f0 || g0 == f1) ? B.size[g1] : B.size[g0];
+        if (merged > MAX_BLOCK_FACES)
+            continue;
+
+        e.alive = false;
+        m.alive = false;
+        L.degree[e.a]--; L.degree[e.b]--;
+        if (!self) { L.degree[m.a]--; L.degree[m.b]--; }
+
+        if (!lattice_connected(L)) {
+            e.alive = true;
+            m.alive = true;
+            L.degree[e.a]++; L.degree[e.b]++;
+            if (!self) { L.degree[m.a]++; L.degree[m.b]++; }
+            continue;
+        }
+
+        B.parent[f1] = (int16_t)f0;
+        B.size[f0]  += B.size[f1];
+        if (!self) {
+            g0 = B.find(g0); g1 = B.find(g1);
+            if (g0 != g1) {
+                B.parent[g1] = (int16_t)g0;
+                B.size[g0]  += B.size[g1];
+            }
+        }
+        removed += self ? 1 : 2;
+    }
+}
+
+/*
+============================================================
+  LATTICE → MAZE
+============================================================
+*/
+static void carve(const Lattice& L, Maze& maze, int tunnel_row)
+{
+    const Geometry& G = L.g;
+    const int W = G.W;
+    const int H = G.H;
+
+    maze.cols = W;
+    maze.rows = H;
+
+    for (int r = 0; r < H; r++)
+        for (int c = 0; c < W; c++)
+            maze.tiles[r][c] = TileType::Wall;
+
+    // Couloirs
+    for (int i = 0; i < L.nedges; i++)
+    {
+        const Lattice::Edge& e = L.edges[i];
+        if (!e.alive) continue;
+        for (int r = L.node_row(e.a); r <= L.node_row(e.b); r++)
+            for (int c = L.node_col(e.a); c <= L.node_col(e.b); c++)
+                maze.tiles[r][c] = TileType::Pellet;
+    }
+
+    // Maison + porte
+    for (int r = G.house_r0; r <= G.house_r1; r++)
+        for (int c = G.house_c0; c <= G.house_c1; c++)
+            maze.tiles[r][c] = TileType::GhostHouse;
+    maze.tiles[G.house_r0 - 1][W / 2 - 1] = TileType::GhostDoorClosed;
+    maze.tiles[G.house_r0 - 1][W / 2]     = TileType::GhostDoorClosed;
+
+    // Tunnel latéral
+    if (tunnel_row >= 0) {
+        maze.tiles[tunnel_row][0]     = TileType::Tunnel;
+        maze.tiles[tunnel_row][1]     = TileType::TunnelEntry;
+        maze.tiles[tunnel_row][W - 2] = TileType::TunnelEntry;
+        maze.tiles[tunnel_row][W - 1] = TileType::Tunnel;
+    }
+
+    // Super pac-gommes dans les coins, départ Pac-Man sous la maison
+    maze.tiles[1][1]         = TileType::PowerPellet;
+    maze.tiles[1][W - 2]     = TileType::PowerPellet;
+    maze.tiles[H - 2][1]     = TileType::PowerPellet;
+    maze.tiles[H - 2][W - 2] = TileType::PowerPellet;
+    maze.tiles[G.row_below][W / 2 - 1] = TileType::PacSpawn;
+
+    // Champs dérivés (mêmes règles que maze_from_ascii)
+    maze.pellet_count       = 0;
+    maze.power_pellet_count = 0;
+    maze.tunnel_entry_count = 0;
+    maze.fruit_row = -1;
+    maze.fruit_col = -1;
+
+    int house_sum_r = 0, house_sum_c = 0, house_count = 0;
+
+    for (int r = 0; r < H; r++)
+        for (int c = 0; c < W; c++)
+            switch (maze.tiles[r][c])
+            {
+                case TileType::Pellet:      maze.pellet_count++; break;
+                case TileType::PowerPellet: maze.power_pellet_count++; break;
+                case TileType::GhostHouse:
+                    if (house_count < 4) {
+                        maze.ghost_spawn_row[house_count] = r;
+                        maze.ghost_spawn_col[house_count] = c;
+                    }
+                    house_sum_r += r;
+                    house_sum_c += c;
+                    house_count++;
+                    break;
+                case TileType::GhostDoorClosed:
+                    maze.ghost_door_row = r;
+                    maze.ghost_door_col = c;
+                    break;
+                case TileType::TunnelEntry:
+                    if (maze.tunnel_entry_count < 2) {
+                        maze.tunnel_entry_row[maze.tunnel_entry_count] = r;
+                        maze.tunnel_entry_col[maze.tunnel_entry_count] = c;
+                        maze.tunnel_entry_count++;
+                    }
+                    break;
+                case TileType::PacSpawn:
+                    maze.pac_spawn_row = r;
+                    maze.pac_spawn_col = c;
+                    break;
+                default:
+                    break;
+            }
+
+    maze.ghost_center_row = house_sum_r / house_count;
+    maze.ghost_center_col = house_sum_c / house_count;
+}
+
+/*
+============================================================
+  GÉNÉRATION
+============================================================
+*/
+bool maze_generate(const MazeGenParams& params, Maze& maze)
+{
+    int cols = params.cols;
+    int rows = params.rows;
+    if ((cols & 1) || cols < MAZE_GEN_MIN_COLS || rows < MAZE_GEN_MIN_ROWS ||
+        cols > MAZE_MAX_COLS || rows > MAZE_MAX_ROWS)
+        return false;
+
+    GenRng rng(params.seed);
+
+    // Statique : quelques Ko, hors de la pile de la tâche jeu
+    static Lattice L;
+    L.g = Geometry(cols, rows);
+
+    for (int attempt = 0; attempt < GEN_ATTEMPTS; attempt++)
+    {
+        build_lattice(rng, L);
+
+        // Tunnel sur une ligne intérieure (hors coins)
+        int tunnel_row = -1;
+        L.tunnel_node[0] = L.tunnel_node[1] = -1;
+        if (params.tunnel && L.nrows > 2)
+        {
+            int ri = rng.range(1, L.nrows - 2);
+            if (L.node_ok[L.node(ri, 0)]) {
+                tunnel_row = L.rows[ri];
+                L.tunnel_node[0] = L.node(ri, 0);
+                L.tunnel_node[1] = L.node(ri, L.ncols - 1);
+            }
+        }
+
+        merge_blocks(rng, L, params.merge_pct);
+        carve(L, maze, tunnel_row);
+
+        if (maze_validate(maze))
+            return true;
+    }
+    return false;
+}
+
+/*
+============================================================
+  VALIDATION
+------------------------------------------------------------
+  Indépendante du générateur : s'applique aussi aux niveaux
+  du pack et à maze_B.
+============================================================
+*/
+enum TileClass : uint8_t { TC_WALL, TC_HOUSE, TC_DOOR, TC_OPEN };
+
+static TileClass tile_class(TileType t)
+{
+    if (t == TileType::Wall)   return TC_WALL;
+    if (isGhostHouseTile(t))   return TC_HOUSE;
+    if (isGhostDoorTile(t))    return TC_DOOR;
+    return TC_OPEN;
+}
+
+// Voisins praticables pour Pac-Man (wrap horizontal sur les tunnels)
+static int open_neighbours(const Maze& m, int r, int c, int out_r[4], int out_c[4])
+{
+    static const int DR[4] = {-1, 1, 0, 0};
+    static const int DC[4] = {0, 0, -1, 1};
+    int n = 0;
+
+    for (int d = 0; d < 4; d++)
+    {
+        int nr = r + DR[d];
+        int nc = c + DC[d];
+        if (m.tiles[r][c] == TileType::Tunnel && nr == r) {
+            if (nc < 0)       nc = m.cols - 1;
+            if (nc >= m.cols) nc = 0;
+        }
+        if (!m.inside(nr, nc))
+            continue;
+        if (tile_class(m.tiles[nr][nc]) != TC_OPEN)
+            continue;
+        out_r[n] = nr;
+        out_c[n] = nc;
+        n++;
+    }
+    return n;
+}
+
+bool maze_validate(const Maze& m, const char** reason)
+{
+    const char* dummy;
+    if (!reason) reason = &dummy;
+
+    const int W = m.cols;
+    const int H = m.rows;
+    if (W < 3 || H < 3 || W > MAZE_MAX_COLS || H > MAZE_MAX_ROWS) {
+        *reason = "dimensions";
+        return false;
+    }
+
+    // --- Symétrie ---
+    for (int r = 0; r < H; r++)
+        for (int c = 0; c < W / 2; c++)
+            if (tile_class(m.tiles[r][c]) != tile_class(m.tiles[r][W - 1 - c])) {
+                *reason = "asymetrique";
+                return false;
+            }
+
+    // --- Bords fermés (sauf tunnels) ---
+    for (int c = 0; c < W; c++)
+        if (m.tiles[0][c] != TileType::Wall || m.tiles[H - 1][c] != TileType::Wall) {
+            *reason = "bord ouvert";
+            return false;
+        }
+    for (int r = 0; r < H; r++)
+        for (int c = 0; c < W; c += W - 1)
+            if (m.tiles[r][c] != TileType::Wall && m.tiles[r][c] != TileType::Tunnel) {
+                *reason = "bord ouvert";
+                return false;
+            }
+
+    // --- Maison et porte ---
+    int dr = m.ghost_door_row, dc = m.ghost_door_col;
+    if (dr <= 0 || dr >= H - 1 || dc < 0 || dc >= W ||
+        !isGhostDoorTile(m.tiles[dr][dc]) ||
+        tile_class(m.tiles[dr - 1][dc]) != TC_OPEN ||
+        !isGhostHouseTile(m.tiles[dr + 1][dc])) {
+        *reason = "porte";
+        return false;
+    }
+    for (int i = 0; i < 4; i++)
+        if (!m.inside(m.ghost_spawn_row[i], m.ghost_spawn_col[i]) ||
+            !isGhostHouseTile(m.tiles[m.ghost_spawn_row[i]][m.ghost_spawn_col[i]])) {
+            *reason = "depart fantome";
+            return false;
+        }
+
+    if (m.power_pellet_count != 4 || m.pellet_count == 0) {
+        *reason = "pac-gommes";
+        return false;
+    }
+
+    // --- Culs-de-sac et zones 2×2 ouvertes ---
+    int nr[4], nc[4];
+    int open_total = 0;
+    for (int r = 0; r < H; r++)
+        for (int c = 0; c < W; c++)
+        {
+            if (tile_class(m.tiles[r][c]) != TC_OPEN)
+                continue;
+            open_total++;
+            if (open_neighbours(m, r, c, nr, nc) < 2) {
+                *reason = "cul-de-sac";
+                return false;
+            }
+            if (r + 1 < H && c + 1 < W &&
+                tile_class(m.tiles[r][c + 1]) == TC_OPEN &&
+                tile_class(m.tiles[r + 1][c]) == TC_OPEN &&
+                tile_class(m.tiles[r + 1][c + 1]) == TC_OPEN) {
+                *reason = "zone 2x2";
+                return false;
+            }
+        }
+
+    // --- Connexité (BFS depuis le départ de Pac-Man) ---
+    int pr = m.pac_spawn_row, pc = m.pac_spawn_col;
+    if (!m.inside(pr, pc) || tile_class(m.tiles[pr][pc]) != TC_OPEN) {
+        *reason = "depart pac-man";
+        return false;
+    }
+
+    static bool    seen[MAZE_MAX_ROWS][MAZE_MAX_COLS];
+    static uint8_t queue_r[MAZE_MAX_ROWS * MAZE_MAX_COLS];
+    static uint8_t queue_c[MAZE_MAX_ROWS * MAZE_MAX_COLS];
+    memset(seen, 0, H * sizeof(seen[0]));
+
+    int head = 0, tail = 0;
+    queue_r[tail] = (uint8_t)pr;
+    queue_c[tail] = (uint8_t)pc;
+    tail++;
+    seen[pr][pc] = true;
+
+    while (head < tail)
+    {
+        int r = queue_r[head];
+        int c = queue_c[head];
+        head++;
+        int n = open_neighbours(m, r, c, nr, nc);
+        for (int i = 0; i < n; i++)
+            if (!seen[nr[i]][nc[i]]) {
+                seen[nr[i]][nc[i]] = true;
+                queue_r[tail] = (uint8_t)nr[i];
+                queue_c[tail] = (uint8_t)nc[i];
+                tail++;
+            }
+    }
+
+    if (tail != open_total) {
+        *reason = "non connexe";
+        return false;
+    }
+
+    *reason = "ok";
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include "maze.h"
+
+/*
+============================================================
+  maze_gen.h — Générateur procédural de labyrinthes
+------------------------------------------------------------
+Produit, à partir d'une graine, un labyrinthe « Pac-Man » :
+ - symétrique gauche / droite ;
+ - sans cul-de-sac, entièrement connexe (tunnels compris) ;
+ - maison des fantômes centrée avec porte, tunnel latéral,
+   pac-gommes partout et 4 super pac-gommes dans les coins.
+
+Principe : un treillis de couloirs (lignes et colonnes tirées
+au hasard, espacées de 2 à 4 cases) dont on retire des
+segments par paires symétriques, tant que chaque carrefour
+garde au moins 2 sorties et que le graphe reste connexe.
+
+Dimensions libres (colonnes paires, jusqu'à MAZE_MAX_*).
+Temps et mémoire bornés (buffers statiques de quelques Ko,
+aucune allocation, non réentrant) : le mode sans fin ne
+coûte pas de flash.
+Vérifié sur hôte par tools/maze_bench.cpp.
+============================================================
+*/
+
+// Plus petit labyrinthe générable (maison + couloirs autour)
+static const int MAZE_GEN_MIN_COLS = 16;
+static const int MAZE_GEN_MIN_ROWS = 13;
+
+struct MazeGenParams {
+    uint32_t seed        = 1;
+    int      cols        = MAZE_WIDTH;     // pair, ≤ MAZE_MAX_COLS
+    int      rows        = MAZE_HEIGHT;    // ≤ MAZE_MAX_ROWS
+    uint8_t  merge_pct   = 35;     // % de segments de couloir à retirer (blocs plus gros)
+    bool     tunnel      = true;   // tunnel latéral
+};
+
+// Génère un labyrinthe valide dans maze. Retourne false (maze à
+// réinitialiser) si les dimensions sont invalides ou si aucune
+// tentative n'a abouti, ce qui ne doit pas arriver en pratique.
+bool maze_generate(const MazeGenParams& params, Maze& maze);
+
+// Vérification complète (symétrie, connexité, culs-de-sac, porte).
+// reason reçoit un message court en cas d'échec.
+bool maze_validate(const Maze& maze, const char** reason = nullptr);
@@ -0,0 +1,149 @@
+#include "maze_view.h"
+#include "maze.h"
+#include "game/config.h"
+#include "core/graphics.h"
+#include <stdio.h>
+#include <string.h>
+
+#if USE_FRAMEBUFFER
+#include "core/gfx_fb.h"
+#include "core/mem_track.h"
+#endif
+
+/*
+============================================================
+  CACHE CIRCULAIRE
+============================================================
+*/
+static const int CACHE_COLS = SCREEN_W / TILE_SIZE + 1;    // 21
+static const int CACHE_ROWS = SCREEN_H / TILE_SIZE + 1;    // 16
+static const int CACHE_W    = CACHE_COLS * TILE_SIZE;      // pixels
+static const int CACHE_H    = CACHE_ROWS * TILE_SIZE;
+
+static const uint16_t TAG_NONE = 0xFFFF;
+
+static struct {
+    bool             tried  = false;
+    uint16_t*        pixels = nullptr;    // CACHE_W × CACHE_H (PSRAM)
+    // Contenu de chaque case du cache : case du labyrinthe + sprite dessiné
+    uint16_t         tag[CACHE_ROWS][CACHE_COLS];
+    const uint16_t*  sprite[CACHE_ROWS][CACHE_COLS];
+    int              last_drawn = 0;
+} s_view;
+
+void maze_view_invalidate()
+{
+    for (int r = 0; r < CACHE_ROWS; r++)
+        for (int c = 0; c < CACHE_COLS; c++)
+            s_view.tag[r][c] = TAG_NONE;
+}
+
+int maze_view_last_tiles_drawn()
+{
+    return s_view.last_drawn;
+}
+
+#if USE_FRAMEBUFFER
+
+static bool cache_init()
+{
+    if (s_view.tried)
+        return s_view.pixels != nullptr;
+    s_view.tried = true;
+
+    size_t bytes = (size_t)CACHE_W * CACHE_H * sizeof(uint16_t);
+    s_view.pixels = (uint16_t*)mem_alloc(MemTag::Video, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!s_view.pixels) {
+        printf("MAZE VIEW: pas de PSRAM (%u octets), rendu direct\n", (unsigned)bytes);
+        return false;
+    }
+
+    maze_view_invalidate();
+    printf("MAZE VIEW: cache %dx%d cases en PSRAM (%u octets)\n",
+           CACHE_COLS, CACHE_ROWS, (unsigned)bytes);
+    return true;
+}
+
+// Recopie un sprite 16×16 (ou du noir) dans une case du cache
+static void raster_tile(int slot_r, int slot_c, const uint16_t* sprite)
+{
+    uint16_t* dst = s_view.pixels + slot_r * TILE_SIZE * CACHE_W + slot_c * TILE_SIZE;
+
+    for (int j = 0; j < TILE_SIZE; j++, dst += CACHE_W)
+    {
+        if (sprite)
+            memcpy(dst, sprite + j * TILE_SIZE, TILE_SIZE * sizeof(uint16_t));
+        else
+            memset(dst, 0, TILE_SIZE * sizeof(uint16_t));
+    }
+}
+
+void maze_view_draw(const Maze& maze, int cam_x, int cam_y)
+{
+    if (cam_x < 0 || cam_y < 0 || !cache_init()) {
+        gfx_clear(COLOR_BLACK);
+        maze.draw();
+        return;
+    }
+
+    // --------------------------------------------------------
+    // 1) Mise à jour des cases visibles : nouvelles ou modifiées
+    // --------------------------------------------------------
+    int r0 = cam_y / TILE_SIZE;
+    int c0 = cam_x / TILE_SIZE;
+    int r1 = (cam_y + SCREEN_H - 1) / TILE_SIZE;
+    int c1 = (cam_x + SCREEN_W - 1) / TILE_SIZE;
+
+    int drawn = 0;
+    for (int r = r0; r <= r1; r++)
+    {
+        int slot_r = r % CACHE_ROWS;
+        for (int c = c0; c <= c1; c++)
+        {
+            int slot_c = c % CACHE_COLS;
+
+            // Hors du labyrinthe : noir
+            const uint16_t* sprite = maze.inside(r, c) ? maze.tileSprite(r, c) : nullptr;
+            uint16_t tag = (uint16_t)(r * MAZE_MAX_COLS + c);
+
+            if (s_view.tag[slot_r][slot_c] != tag || s_view.sprite[slot_r][slot_c] != sprite)
+            {
+                raster_tile(slot_r, slot_c, sprite);
+                s_view.tag[slot_r][slot_c]    = tag;
+                s_view.sprite[slot_r][slot_c] = sprite;
+                drawn++;
+            }
+        }
+    }
+    s_view.last_drawn = drawn;
+
+    // --------------------------------------------------------
+    // 2) Cache → framebuffer (la ligne peut boucler une fois)
+    // --------------------------------------------------------
+    uint16_t* fb = gfx_fb_getFramebuffer();
+    int sx    = cam_x % CACHE_W;
+    int first = CACHE_W - sx;
+    if (first > SCREEN_W) first = SCREEN_W;
+
+    int sy = cam_y % CACHE_H;
+    for (int y = 0; y < SCREEN_H; y++, fb += SCREEN_W)
+    {
+        const uint16_t* src = s_view.pixels + sy * CACHE_W;
+        memcpy(fb, src + sx, first * sizeof(uint16_t));
+        if (first < SCREEN_W)
+            memcpy(fb + first, src, (SCREEN_W - first) * sizeof(uint16_t));
+
+        if (++sy == CACHE_H)
+            sy = 0;
+    }
+}
+
+#else
+
+void maze_view_draw(const Maze& maze, int, int)
+{
+    gfx_clear(COLOR_BLACK);
+    maze.draw();
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+#include <stdint.h>
+
+/*
+============================================================
+  maze_view.h — Rendu du labyrinthe avec cache de tuiles
+------------------------------------------------------------
+Le fond (labyrinthe) est gardé dans un tampon circulaire de
+(écran + 1 case) dans chaque direction, en PSRAM :
+
+    case (r, c) du labyrinthe → case (r % lignes, c % colonnes)
+                                 du cache
+
+Chaque frame :
+ - seules les cases qui entrent dans l'écran (défilement) ou
+   qui ont changé (pac-gomme mangée, porte) sont redessinées ;
+ - le cache est recopié dans le framebuffer (2 memcpy par
+   ligne d'écran au plus).
+
+Le travail par frame dépend donc de l'écran, pas de la taille
+du labyrinthe. Sans framebuffer (USE_FRAMEBUFFER = 0) ou si
+la PSRAM manque, on revient à gfx_clear() + Maze::draw().
+============================================================
+*/
+
+struct Maze;
+
+// Dessine le fond complet de l'écran pour la caméra (cam_x, cam_y) en pixels
+void maze_view_draw(const Maze& maze, int cam_x, int cam_y);
+
+// Force un redessin complet du cache à la prochaine frame
+void maze_view_invalidate();
+
+// Nombre de cases redessinées lors de la dernière frame (debug)
+int maze_view_last_tiles_drawn();
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include "game/config.h"
+
+/*
+============================================================
+  motion.h — Déplacement en virgule fixe 8.8
+------------------------------------------------------------
+Les vitesses sont en 8.8 pixels/frame (0x100 = 1 px/frame).
+Chaque acteur garde, en plus de pixel_offset, un accumulateur
+de sous-pixels (sub_px) : la partie entière fait avancer
+pixel_offset, la fraction est reportée au frame suivant.
+80 % de 3,75 px/frame donne ainsi exactement 3 px/frame,
+75 % donne 2, 3, 3, 3… : le timing arcade est respecté sans
+flottant (une addition, un décalage, un masque par frame).
+
+Au centre de la tuile suivante, pixel_offset repasse à 0 pour
+que les décisions (virage, arrêt, IA) se prennent toujours au
+centre ; les pixels en trop sont remis dans l'accumulateur et
+parcourus au frame suivant, la distance totale est conservée.
+============================================================
+*/
+
+// Avance de speed_fp (8.8). Retourne true si le centre de la
+// tuile suivante est atteint (pixel_offset revient alors à 0).
+static inline bool motion_advance(int& pixel_offset, uint16_t& sub_px, uint16_t speed_fp)
+{
+    uint32_t acc = (uint32_t)sub_px + speed_fp;
+    pixel_offset += (int)(acc >> 8);
+    sub_px = (uint16_t)(acc & 0xFF);
+
+    if (pixel_offset < TILE_SIZE)
+        return false;
+
+    // Dépassement du centre : reporté au frame suivant
+    sub_px += (uint16_t)((pixel_offset - TILE_SIZE) << 8);
+    pixel_offset = 0;
+    return true;
+}
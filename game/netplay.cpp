@@ -0,0 +1,521 @@
+#include "netplay.h"
+#include "snapshot.h"
+#include "game.h"
+#include "core/input.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#ifdef ESP_PLATFORM
+#include "core/mem_track.h"
+#endif
+
+/*
+============================================================
+  PAQUET (little-endian)
+------------------------------------------------------------
+    0  u16 magic 'PN'
+    2  u8  version
+    3  u8  joueur émetteur
+    4  u32 frame de la dernière entrée du paquet
+    8  u32 ack : entrées du destinataire reçues (contiguës)
+   12  u32 frame du CRC (0xFFFFFFFF = aucun)
+   16  u32 CRC de la photo confirmée de cette frame
+   20  i8  avance de l'émetteur (frames d'avance sur nous)
+   21  u8  n
+   22  n entrées (frames frame-n+1 .. frame)
+============================================================
+*/
+static const uint16_t PKT_MAGIC   = 0x4E50;
+static const uint8_t  PKT_VERSION = 1;
+static const int      PKT_HEADER  = 22;
+static const int      PKT_MAX_IN  = 32;
+static const uint32_t NO_FRAME    = 0xFFFFFFFFu;
+
+static const int RING  = 64;                            // entrées par joueur
+static const int SLOTS = NETPLAY_ROLLBACK_FRAMES + 2;   // photos
+
+static struct {
+    bool          active = false;
+    int           local  = 0;
+    int           sock   = -1;
+    sockaddr_in   peer {};
+    bool          peer_known = false;
+    NetplayStepFn step = nullptr;
+
+    int64_t  t0_us = 0;            // instant de la frame 0
+    uint32_t frame = 0;            // prochaine frame à simuler
+
+    uint8_t  in[2][RING];          // entrées reçues / produites
+    uint8_t  used[2][RING];        // entrées utilisées par la simulation
+    bool     known[RING];          // entrée distante reçue (au-delà de remote_count)
+    uint32_t local_count  = 0;     // entrées locales : frames [0, local_count)
+    uint32_t remote_count = 0;     // entrées distantes contiguës reçues
+    uint32_t remote_ack   = 0;     // nos entrées reçues par le pair
+    uint32_t remote_frame = 0;     // frame estimée du pair
+    int      remote_adv   = 0;     // son avance sur nous, vue de chez lui
+    uint32_t rollback_from = NO_FRAME;
+
+    uint8_t* snap = nullptr;       // SLOTS × SNAPSHOT_MAX_BYTES
+    uint32_t snap_frame[SLOTS];
+
+    uint32_t check_next  = 0;      // prochaine frame à contrôler
+    uint32_t check_frame = NO_FRAME, check_crc = 0;   // dernier CRC local
+    uint32_t local_checks[4][2];                       // (frame, crc) récents
+    uint32_t compared    = NO_FRAME;                   // dernier CRC du pair comparé
+
+    NetplayStats stats {};
+} s_np;
+
+/*
+============================================================
+  ENTRÉES
+============================================================
+*/
+uint8_t netplay_input_from_keys(const Keys& k)
+{
+    uint8_t in = 0;
+    if (k.left  || k.joy_x < 0) in |= NET_IN_LEFT;
+    if (k.right || k.joy_x > 0) in |= NET_IN_RIGHT;
+    if (k.up    || k.joy_y > 0) in |= NET_IN_UP;
+    if (k.down  || k.joy_y < 0) in |= NET_IN_DOWN;
+    if (k.A)                    in |= NET_IN_A;
+    return in;
+}
+
+static uint32_t net_to_bits(uint8_t in)
+{
+    uint32_t bits = 0;
+    if (in & NET_IN_LEFT)  bits |= INPUT_JOY_LEFT;
+    if (in & NET_IN_RIGHT) bits |= INPUT_JOY_RIGHT;
+    if (in & NET_IN_UP)    bits |= INPUT_JOY_UP;
+    if (in & NET_IN_DOWN)  bits |= INPUT_JOY_DOWN;
+    return bits;
+}
+
+// Photo d'entrées reconstruite à l'identique sur les deux consoles :
+// horodatage = numéro de frame (jamais l'horloge locale)
+static Keys keys_from_net(uint8_t in, uint8_t prev, uint32_t f)
+{
+    Keys k {};
+    uint32_t bits = net_to_bits(in);
+    uint32_t old  = net_to_bits(prev);
+
+    k.raw      = bits;
+    k.pressed  = bits & ~old;
+    k.released = old & ~bits;
+    k.time_us  = (int64_t)f * NETPLAY_TICK_US;
+    if (k.pressed) {
+        k.last_pressed    = k.pressed & (~k.pressed + 1);
+        k.last_pressed_us = k.time_us;
+    }
+
+    k.left  = in & NET_IN_LEFT;
+    k.right = in & NET_IN_RIGHT;
+    k.up    = in & NET_IN_UP;
+    k.down  = in & NET_IN_DOWN;
+    k.A     = in & NET_IN_A;
+    return k;
+}
+
+static int remote_player()
+{
+    return 1 - s_np.local;
+}
+
+// Entrée d'un joueur pour la frame f : connue, ou prédite (dernière reçue)
+static uint8_t input_for(int p, uint32_t f)
+{
+    if (p == s_np.local)
+        return s_np.in[p][f % RING];
+    if (f < s_np.remote_count || s_np.known[f % RING])
+        return s_np.in[p][f % RING];
+    return s_np.remote_count ? s_np.in[p][(s_np.remote_count - 1) % RING] : 0;
+}
+
+/*
+============================================================
+  SIMULATION
+============================================================
+*/
+static uint8_t* snap_slot(uint32_t f)
+{
+    return s_np.snap + (f % SLOTS) * SNAPSHOT_MAX_BYTES;
+}
+
+static uint32_t snap_crc(uint32_t f)
+{
+    const uint8_t* p = snap_slot(f) + 12;    // CRC du contenu (en-tête)
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Photo de l'état avant la frame f, puis une frame de logique
+static void simulate(GameState& g, uint32_t f)
+{
+    snapshot_save(g, snap_slot(f), SNAPSHOT_MAX_BYTES);
+    s_np.snap_frame[f % SLOTS] = f;
+
+    for (int p = 0; p < 2; p++)
+        s_np.used[p][f % RING] = input_for(p, f);
+
+    uint8_t prev = f ? s_np.used[0][(f - 1) % RING] : 0;
+    g.input       = keys_from_net(s_np.used[0][f % RING], prev, f);
+    g.ghost_input = s_np.used[1][f % RING];
+
+    s_np.step(g);
+}
+
+static void rollback(GameState& g)
+{
+    uint32_t from = s_np.rollback_from;
+    s_np.rollback_from = NO_FRAME;
+    if (from >= s_np.frame)
+        return;
+
+    if (s_np.snap_frame[from % SLOTS] != from ||
+        !snapshot_load(g, snap_slot(from), SNAPSHOT_MAX_BYTES)) {
+        printf("NETPLAY: photo de la frame %u absente, rollback impossible\n", (unsigned)from);
+        return;
+    }
+
+    s_np.stats.rollbacks++;
+    for (uint32_t f = from; f < s_np.frame; f++) {
+        simulate(g, f);
+        s_np.stats.resim_frames++;
+    }
+}
+
+// CRC des photos dont toutes les entrées antérieures sont confirmées
+static void update_checks()
+{
+    while (s_np.check_next < s_np.frame && s_np.check_next <= s_np.remote_count)
+    {
+        uint32_t f = s_np.check_next;
+        s_np.check_next += NETPLAY_CHECK_INTERVAL;
+        if (s_np.snap_frame[f % SLOTS] != f)
+            continue;
+
+        s_np.check_frame = f;
+        s_np.check_crc   = snap_crc(f);
+        uint32_t* c = s_np.local_checks[(f / NETPLAY_CHECK_INTERVAL) % 4];
+        c[0] = f;
+        c[1] = s_np.check_crc;
+    }
+}
+
+static void compare_check(uint32_t f, uint32_t crc)
+{
+    if (f == NO_FRAME || f == s_np.compared)
+        return;
+    const uint32_t* c = s_np.local_checks[(f / NETPLAY_CHECK_INTERVAL) % 4];
+    if (c[0] != f)
+        return;
+
+    s_np.compared = f;
+    s_np.stats.checks++;
+    if (c[1] != crc) {
+        s_np.stats.desyncs++;
+        printf("NETPLAY: désynchronisation à la frame %u (%08X / %08X)\n",
+               (unsigned)f, (unsigned)c[1], (unsigned)crc);
+    }
+}
+
+/*
+============================================================
+  RÉSEAU
+============================================================
+*/
+static void wr32(uint8_t* p, uint32_t v)
+{
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static uint32_t rd32(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Frames d'avance sur le pair (latence comprise : la même vue des deux
+// côtés si les deux consoles sont à l'heure)
+static int advantage()
+{
+    int adv = (int)s_np.frame - (int)s_np.remote_frame;
+    return adv < -127 ? -127 : adv > 127 ? 127 : adv;
+}
+
+static void send_inputs()
+{
+    if (!s_np.peer_known || s_np.local_count == 0)
+        return;
+
+    // Entrées pas encore acquittées par le pair (PKT_MAX_IN max)
+    uint32_t first = s_np.remote_ack;
+    if (s_np.local_count - first > PKT_MAX_IN)
+        first = s_np.local_count - PKT_MAX_IN;
+    int n = (int)(s_np.local_count - first);
+    if (n == 0) {                 // rien de neuf : on répète la dernière
+        first--;
+        n = 1;
+    }
+
+    uint8_t pkt[PKT_HEADER + PKT_MAX_IN];
+    pkt[0] = (uint8_t)PKT_MAGIC;
+    pkt[1] = (uint8_t)(PKT_MAGIC >> 8);
+    pkt[2] = PKT_VERSION;
+    pkt[3] = (uint8_t)s_np.local;
+    wr32(pkt + 4,  s_np.local_count - 1);
+    wr32(pkt + 8,  s_np.remote_count);
+    wr32(pkt + 12, s_np.check_frame);
+    wr32(pkt + 16, s_np.check_crc);
+    pkt[20] = (uint8_t)(int8_t)advantage();
+    pkt[21] = (uint8_t)n;
+    for (int i = 0; i < n; i++)
+        pkt[PKT_HEADER + i] = s_np.in[s_np.local][(first + i) % RING];
+
+    if (sendto(s_np.sock, pkt, PKT_HEADER + n, 0,
+               (const sockaddr*)&s_np.peer, sizeof(s_np.peer)) > 0)
+        s_np.stats.sent++;
+}
+
+static void receive_packet(const uint8_t* pkt, int len)
+{
+    if (len < PKT_HEADER || (pkt[0] | (pkt[1] << 8)) != PKT_MAGIC ||
+        pkt[2] != PKT_VERSION || pkt[3] != remote_player())
+        return;
+
+    int n = pkt[21];
+    if (n > PKT_MAX_IN || len < PKT_HEADER + n)
+        return;
+
+    uint32_t last = rd32(pkt + 4);
+    uint32_t ack  = rd32(pkt + 8);
+    if (ack > s_np.remote_ack && ack <= s_np.local_count)
+        s_np.remote_ack = ack;
+    if (last + 1 >= (uint32_t)NETPLAY_INPUT_DELAY && last + 1 - NETPLAY_INPUT_DELAY > s_np.remote_frame)
+        s_np.remote_frame = last + 1 - NETPLAY_INPUT_DELAY;
+    s_np.remote_adv = (int8_t)pkt[20];
+    s_np.stats.received++;
+
+    // Entrées nouvelles (les doublons des paquets précédents sont ignorés)
+    int rp = remote_player();
+    for (int i = 0; i < n; i++)
+    {
+        uint32_t f = last + 1 - n + i;
+        if (f < s_np.remote_count || f >= s_np.remote_count + RING - SLOTS)
+            continue;
+        s_np.in[rp][f % RING] = pkt[PKT_HEADER + i];
+        s_np.known[f % RING]  = true;
+    }
+
+    // Avance de la frontière confirmée ; prédiction fausse → rollback
+    while (s_np.known[s_np.remote_count % RING])
+    {
+        uint32_t f = s_np.remote_count;
+        s_np.known[f % RING] = false;
+        if (f < s_np.frame && s_np.in[rp][f % RING] != s_np.used[rp][f % RING] &&
+            f < s_np.rollback_from)
+            s_np.rollback_from = f;
+        s_np.remote_count++;
+    }
+
+    compare_check(rd32(pkt + 12), rd32(pkt + 16));
+}
+
+static void receive_all()
+{
+    uint8_t     pkt[PKT_HEADER + PKT_MAX_IN];
+    sockaddr_in from;
+    for (;;)
+    {
+        socklen_t from_len = sizeof(from);
+        int len = recvfrom(s_np.sock, pkt, sizeof(pkt), 0, (sockaddr*)&from, &from_len);
+        if (len <= 0)
+            return;
+
+        if (!s_np.peer_known && len >= 4 && pkt[3] == remote_player()) {
+            s_np.peer       = from;
+            s_np.peer_known = true;
+            printf("NETPLAY: pair %s:%u\n", inet_ntoa(from.sin_addr), ntohs(from.sin_port));
+        }
+        receive_packet(pkt, len);
+    }
+}
+
+/*
+============================================================
+  API
+============================================================
+*/
+static void* netplay_alloc(size_t bytes)
+{
+#ifdef ESP_PLATFORM
+    return mem_alloc(MemTag::Netplay, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return malloc(bytes);
+#endif
+}
+
+static void netplay_release(void* p)
+{
+#ifdef ESP_PLATFORM
+    mem_free(p);
+#else
+    free(p);
+#endif
+}
+
+bool netplay_start(GameState& g, int local_player, const char* peer_ip,
+                   NetplayStepFn step, int64_t now_us)
+{
+    netplay_stop();
+
+    s_np.snap = (uint8_t*)netplay_alloc(SLOTS * SNAPSHOT_MAX_BYTES);
+    if (!s_np.snap) {
+        printf("NETPLAY: mémoire insuffisante\n");
+        return false;
+    }
+
+    s_np.sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s_np.sock < 0) {
+        printf("NETPLAY: socket impossible\n");
+        netplay_stop();
+        return false;
+    }
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(NETPLAY_PORT + local_player);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(s_np.sock, (const sockaddr*)&addr, sizeof(addr)) < 0) {
+        printf("NETPLAY: port %u occupé\n", (unsigned)(NETPLAY_PORT + local_player));
+        netplay_stop();
+        return false;
+    }
+    fcntl(s_np.sock, F_SETFL, fcntl(s_np.sock, F_GETFL, 0) | O_NONBLOCK);
+
+    s_np.peer_known = false;
+    if (peer_ip) {
+        s_np.peer.sin_family      = AF_INET;
+        s_np.peer.sin_port        = htons(NETPLAY_PORT + 1 - local_player);
+        s_np.peer.sin_addr.s_addr = inet_addr(peer_ip);
+        s_np.peer_known = true;
+    }
+
+    s_np.local         = local_player;
+    s_np.step          = step;
+    s_np.t0_us         = now_us;
+    s_np.frame         = 0;
+    s_np.local_count   = 0;
+    s_np.remote_count  = 0;
+    s_np.remote_ack    = 0;
+    s_np.remote_frame  = 0;
+    s_np.remote_adv    = 0;
+    s_np.rollback_from = NO_FRAME;
+    s_np.check_next    = 0;
+    s_np.check_frame   = NO_FRAME;
+    s_np.check_crc     = 0;
+    s_np.compared      = NO_FRAME;
+    s_np.stats         = NetplayStats {};
+    memset(s_np.in, 0, sizeof(s_np.in));
+    memset(s_np.used, 0, sizeof(s_np.used));
+    memset(s_np.known, 0, sizeof(s_np.known));
+    memset(s_np.local_checks, 0xFF, sizeof(s_np.local_checks));
+    for (auto& f : s_np.snap_frame)
+        f = NO_FRAME;
+
+    g.ghost_player = 0;      // Blinky
+    g.ghost_input  = 0;
+    s_np.active = true;
+    printf("NETPLAY: joueur %d (%s), port %u\n", local_player,
+           local_player == 0 ? "Pac-Man" : "fantôme",
+           (unsigned)(NETPLAY_PORT + local_player));
+    return true;
+}
+
+void netplay_stop()
+{
+    if (s_np.sock >= 0)
+        close(s_np.sock);
+    s_np.sock = -1;
+    netplay_release(s_np.snap);
+    s_np.snap   = nullptr;
+    s_np.active = false;
+}
+
+bool netplay_active()
+{
+    return s_np.active;
+}
+
+int netplay_update(GameState& g, uint8_t local_input, int64_t now_us)
+{
+    if (!s_np.active)
+        return 0;
+
+    receive_all();
+    if (s_np.rollback_from != NO_FRAME)
+        rollback(g);
+
+    // Tick fixe : frame cible d'après le temps écoulé depuis la frame 0
+    int64_t target = (now_us - s_np.t0_us) / NETPLAY_TICK_US;
+    if (target <= (int64_t)s_np.frame)
+        return 0;
+    if (target - s_np.frame > 8) {                  // gros retard : on recale
+        s_np.t0_us = now_us - (int64_t)s_np.frame * NETPLAY_TICK_US;
+        target = s_np.frame + 1;
+    }
+
+    int done = 0;
+    while ((int64_t)s_np.frame < target && done < 2)
+    {
+        // Plus d'avance que le pair n'en a sur nous : on cède un tick
+        // (l'écart divisé par deux, la latence s'annule)
+        if (advantage() - s_np.remote_adv >= 2) {
+            s_np.t0_us += NETPLAY_TICK_US;
+            s_np.stats.waits++;
+            break;
+        }
+
+        // Prédiction trop longue : on attend ses entrées
+        if (s_np.frame >= s_np.remote_count + NETPLAY_ROLLBACK_FRAMES) {
+            s_np.t0_us += NETPLAY_TICK_US;
+            s_np.stats.stalls++;
+            break;
+        }
+
+        // Entrée locale, appliquée NETPLAY_INPUT_DELAY frames plus tard
+        while (s_np.local_count <= s_np.frame + NETPLAY_INPUT_DELAY) {
+            s_np.in[s_np.local][s_np.local_count % RING] =
+                (s_np.local_count < (uint32_t)NETPLAY_INPUT_DELAY) ? 0 : local_input;
+            s_np.local_count++;
+        }
+
+        simulate(g, s_np.frame);
+        s_np.frame++;
+        done++;
+    }
+
+    update_checks();
+    send_inputs();
+    return done;
+}
+
+uint32_t netplay_frame()
+{
+    return s_np.frame;
+}
+
+int netplay_delay()
+{
+    return (int)s_np.frame - (int)s_np.remote_count;
+}
+
+const NetplayStats& netplay_stats()
+{
+    return s_np.stats;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include "config.h"
+
+/*
+============================================================
+  netplay.h — Jeu à 2 en lockstep (Pac-Man contre un fantôme)
+------------------------------------------------------------
+Seules les entrées circulent : chaque console simule la même
+partie (logique déterministe, hasard dans GameState) à partir
+des mêmes entrées.
+
+ - tick fixe NETPLAY_TICK_US, indépendant de la boucle d'appel ;
+ - entrée locale retardée de NETPLAY_INPUT_DELAY frames ;
+ - entrée distante absente : prédite (= dernière reçue), la
+   simulation continue. Quand la vraie arrive et diffère, on
+   recharge la photo (game/snapshot.h) de la frame fautive et
+   on resimule jusqu'à la frame courante (rollback) ;
+ - au-delà de NETPLAY_ROLLBACK_FRAMES frames d'avance sur le
+   pair, on attend (stall) ;
+ - un paquet UDP par tick : entrées non acquittées (1 octet par
+   frame, ~1 à 3 en régime normal) + acquittement + CRC d'une
+   photo confirmée (détection de désynchronisation).
+
+Joueur 0 : Pac-Man (g.input). Joueur 1 : fantôme
+g.ghost_player (g.ghost_input).
+
+Sockets BSD (lwIP sur la console, Linux sur l'hôte) : le même
+code tourne entre deux builds Linux en boucle locale
+(tools/netplay_loopback.cpp).
+
+Limite : les effets de bord de game_update (sons) sont rejoués
+pendant un rollback.
+============================================================
+*/
+
+struct GameState;
+struct Keys;
+
+// Entrée d'un joueur pour une frame (1 octet)
+enum : uint8_t {
+    NET_IN_LEFT  = 1 << 0,
+    NET_IN_RIGHT = 1 << 1,
+    NET_IN_UP    = 1 << 2,
+    NET_IN_DOWN  = 1 << 3,
+    NET_IN_A     = 1 << 4
+};
+
+static const int      NETPLAY_TICK_US         = GAME_FRAME_US;
+static const int      NETPLAY_INPUT_DELAY     = 2;      // frames
+static const int      NETPLAY_ROLLBACK_FRAMES = 8;      // prédiction max
+static const int      NETPLAY_CHECK_INTERVAL  = 32;     // frames entre deux CRC
+static const uint16_t NETPLAY_PORT            = 47800;  // + numéro du joueur
+
+// Logique d'une frame (game_update sur la console)
+typedef void (*NetplayStepFn)(GameState& g);
+
+struct NetplayStats {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t rollbacks;        // corrections de prédiction
+    uint32_t resim_frames;     // frames resimulées
+    uint32_t stalls;           // ticks en attente du pair
+    uint32_t waits;            // ticks cédés (trop d'avance)
+    uint32_t checks;           // CRC comparés
+    uint32_t desyncs;          // CRC différents
+};
+
+// local_player : 0 = Pac-Man, 1 = fantôme.
+// peer_ip : nullptr = adresse apprise au premier paquet reçu (hôte).
+// g doit être dans le même état sur les deux consoles (game_init).
+bool netplay_start(GameState& g, int local_player, const char* peer_ip,
+                   NetplayStepFn step, int64_t now_us);
+void netplay_stop();
+bool netplay_active();
+
+// À appeler à chaque tour de boucle : reçoit, avance d'autant de
+// ticks que le temps écoulé (2 max) et émet. Retourne le nombre de
+// frames simulées (0 : pas encore l'heure, ou attente du pair).
+int netplay_update(GameState& g, uint8_t local_input, int64_t now_us);
+
+uint32_t            netplay_frame();       // prochaine frame à simuler
+int                 netplay_delay();       // frames d'avance sur le pair confirmé
+const NetplayStats& netplay_stats();
+
+// Touches / joystick de la frame → entrée réseau
+uint8_t netplay_input_from_keys(const Keys& k);
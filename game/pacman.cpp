@@ -3,7 +3,7 @@
   pacman.cpp — Logique et rendu de Pac-Man
 ------------------------------------------------------------
 Implémente :
- - la lecture des inputs (boutons + joystick)
+ - l'interprétation des inputs (g.input : boutons + joystick)
  - la gestion des directions (dir / next_dir)
  - le mouvement case-based avec pixel_offset
  - les portails (tunnels)
@@ -22,16 +22,21 @@ par GameState (game/game.h) pour les effets de jeu.
 #include "game/config.h"
 #include "game/maze.h"
 #include "game/game.h"
+#include "game/motion.h"
 
 // Core
 #include "core/graphics.h"
 #include "core/sprite.h"
+#include "core/draw_list.h"
 #include "core/input.h"
 #include "core/audio.h"
 
 // Assets
 #include "assets/assets.h"
 
+#include <algorithm>
+
+extern float g_camera_x;
 extern float g_camera_y;
 extern int   debug;
 char debugText[64];
@@ -55,7 +60,7 @@ static bool pac_can_move(const GameState& g, const Pacman& p, Pacman::Dir d)
     int nr = p.tile_r + Pacman::dirY(d);
     int nc = p.tile_c + Pacman::dirX(d);
 
-    if (nr < 0 || nr >= MAZE_HEIGHT || nc < 0 || nc >= MAZE_WIDTH)
+    if (!g.maze.inside(nr, nc))
         return false;
 
     TileType t = g.maze.tiles[nr][nc];
@@ -83,6 +88,90 @@ static bool is_opposite(Pacman::Dir a, Pacman::Dir b)
            (a == Pacman::Dir::Down  && b == Pacman::Dir::Up);
 }
 
+// ------------------------------------------------------------
+// pac_can_enter
+// ------------------------------------------------------------
+// Même règle que pac_can_move, depuis une tuile quelconque
+// (virage anticipé : on teste depuis la tuile suivante).
+// ------------------------------------------------------------
+static bool pac_can_enter(const GameState& g, int r, int c)
+{
+    if (!g.maze.inside(r, c))
+        return false;
+
+    TileType t = g.maze.tiles[r][c];
+    return !(t == TileType::Wall ||
+             t == TileType::GhostDoorClosed ||
+             t == TileType::GhostDoorOpening);
+}
+
+// ------------------------------------------------------------
+// Directions demandées (boutons + joystick)
+// ------------------------------------------------------------
+static Pacman::Dir dir_from_key(uint32_t key)
+{
+    if (key & (EXPANDER_KEY_LEFT  | INPUT_JOY_LEFT))  return Pacman::Dir::Left;
+    if (key & (EXPANDER_KEY_RIGHT | INPUT_JOY_RIGHT)) return Pacman::Dir::Right;
+    if (key & (EXPANDER_KEY_UP    | INPUT_JOY_UP))    return Pacman::Dir::Up;
+    if (key & (EXPANDER_KEY_DOWN  | INPUT_JOY_DOWN))  return Pacman::Dir::Down;
+    return Pacman::Dir::None;
+}
+
+static bool dir_held(const Keys& k, Pacman::Dir d)
+{
+    switch (d)
+    {
+        case Pacman::Dir::Left:  return k.left  || k.joy_x < 0;
+        case Pacman::Dir::Right: return k.right || k.joy_x > 0;
+        case Pacman::Dir::Up:    return k.up    || k.joy_y > 0;
+        case Pacman::Dir::Down:  return k.down  || k.joy_y < 0;
+        default:                 return false;
+    }
+}
+
+// ------------------------------------------------------------
+// pac_enter_next_tile
+// ------------------------------------------------------------
+// Passe dans la tuile suivante (sens dir) : portails puis
+// collecte. Retourne true si un portail a téléporté Pac-Man.
+// ------------------------------------------------------------
+static bool pac_enter_next_tile(GameState& g, Pacman& p)
+{
+    // Mémoriser la tuile précédente
+    p.prev_tile_r = p.tile_r;
+    p.prev_tile_c = p.tile_c;
+
+    // On entre dans une nouvelle tuile
+    p.tile_r += Pacman::dirY(p.dir);
+    p.tile_c += Pacman::dirX(p.dir);
+
+    // TUNNEL WRAP (portails) : try_portal_wrap met à jour
+    // tile_r / tile_c / pixel_offset / dir
+    if (try_portal_wrap(g, g.portalH, p) ||
+        try_portal_wrap(g, g.portalV, p))
+        return true;
+
+    // COLLECTE (pellets / power pellets)
+    TileType& cell = g.maze.tiles[p.tile_r][p.tile_c];
+
+    if (cell == TileType::Pellet)
+    {
+        cell = TileType::Empty;
+        g.maze.pellet_count--;
+        g.score += DOT_SCORE;
+        audio_play_pacgomme();
+    }
+    else if (cell == TileType::PowerPellet)
+    {
+        cell = TileType::Empty;
+        g.maze.power_pellet_count--;
+        g.score += POWERDOT_SCORE;
+        audio_play_power();
+        game_trigger_frightened(g);
+    }
+    return false;
+}
+
 /*
 ============================================================
   Constructeur
@@ -100,6 +189,7 @@ Pacman::Pacman(int start_col, int start_row)
     x = tile_c * TILE_SIZE + PACMAN_OFFSET;
     y = tile_r * TILE_SIZE + PACMAN_OFFSET;
     pixel_offset = 0;
+    sub_px = 0;
 }
 
 /*
@@ -110,26 +200,47 @@ Pacman::Pacman(int start_col, int start_row)
 void Pacman::update(GameState& g)
 {
     // --------------------------------------------------------
-    // 1) INPUT : lecture + filtrage → next_dir
+    // 1) INPUT : photo de la frame (aucune lecture matérielle ici)
     // --------------------------------------------------------
-    Keys k;
-    input_poll(k);
+    const Keys& k = g.input;
 
     Dir requestedDir = Dir::None;
-    const int DEADZONE = 500;
 
-    if (k.left  || (k.joxx < JOYX_MID - DEADZONE)) requestedDir = Dir::Left;
-    if (k.right || (k.joxx > JOYX_MID + DEADZONE)) requestedDir = Dir::Right;
-    if (k.up    || (k.joxy > JOYX_MID + DEADZONE)) requestedDir = Dir::Up;
-    if (k.down  || (k.joxy < JOYX_MID - DEADZONE)) requestedDir = Dir::Down;
+    // Joystick : zone morte + hystérésis déjà appliquées (core/input)
+    if (k.left  || k.joy_x < 0) requestedDir = Dir::Left;
+    if (k.right || k.joy_x > 0) requestedDir = Dir::Right;
+    if (k.up    || k.joy_y > 0) requestedDir = Dir::Up;
+    if (k.down  || k.joy_y < 0) requestedDir = Dir::Down;
+
+    // Intention de virage : le dernier appui (même plus court
+    // qu'une frame, horodaté par la tâche input) prime sur la
+    // direction tenue ; relâchée, elle reste valable
+    // TURN_BUFFER_FRAMES frames, mesurées depuis l'appui réel.
+    Dir pressedDir = dir_from_key(k.last_pressed);
+    if (pressedDir != Dir::None)
+    {
+        turn_dir     = pressedDir;
+        turn_time_us = k.last_pressed_us;
+    }
+    else if (requestedDir != Dir::None && !dir_held(k, turn_dir))
+    {
+        turn_dir     = requestedDir;
+        turn_time_us = k.time_us;
+    }
+
+    if (dir_held(k, turn_dir))
+        turn_time_us = k.time_us;
+    else if (k.time_us - turn_time_us > (int64_t)TURN_BUFFER_FRAMES * GAME_FRAME_US)
+        turn_dir = Dir::None;
 
-    // Mémorise l’intention du joueur (persistante pour les virages anticipés)
-    next_dir = requestedDir;
+    next_dir = turn_dir;
 
     // --------------------------------------------------------
     // 2) LOGIQUE CASE-BASED : décisions de direction
     // --------------------------------------------------------
-    int  speed    = PACMAN_SPEED;
+    // Vitesse 8.8 : plus rapide pendant le mode Frightened (arcade)
+    uint16_t speed = (g.frightened_timer_ticks > 0) ? g.speeds.pacman_frightened
+                                                    : g.speeds.pacman;
     bool centered = (pixel_offset == 0);
 
     if (centered)
@@ -149,65 +260,84 @@ void Pacman::update(GameState& g)
         if (!pac_can_move(g, *this, dir))
             dir = Dir::None;
     }
-
-    // --------------------------------------------------------
-    // 3) AVANCEMENT AVEC SNAP OFFSET
-    // --------------------------------------------------------
-    if (dir != Dir::None && speed > 0)
+    else if (next_dir != Dir::None && next_dir != dir && !is_opposite(next_dir, dir))
     {
-        pixel_offset += speed;
-
-        if (pixel_offset >= TILE_SIZE)
+        // --------------------------------------------------------
+        // 2b) CORNERING (arcade) : virage perpendiculaire jusqu'à
+        //     TURN_CORNER_PX avant ou après le centre. Pac-Man part
+        //     tout de suite sur le nouvel axe ; le décalage sur
+        //     l'ancien (corner_off) se résorbe en diagonale (cf. 3)
+        // --------------------------------------------------------
+        if (pixel_offset <= TURN_CORNER_PX && pac_can_move(g, *this, next_dir))
         {
-            // Mémoriser la tuile précédente
-            prev_tile_r = tile_r;
-            prev_tile_c = tile_c;
-
-            // On entre dans une nouvelle tuile
-            tile_r += dirY(dir);
-            tile_c += dirX(dir);
+            // Centre à peine dépassé : décalage en avant du centre
+            corner_dir = dir;
+            corner_off = pixel_offset;
             pixel_offset = 0;
-
-            // ------------------------------------------------
-            // 3b) TUNNEL WRAP (portails)
-            // ------------------------------------------------
-            if (try_portal_wrap(g, g.portalH, *this) ||
-                try_portal_wrap(g, g.portalV, *this))
+            dir = next_dir;
+        }
+        else if (pixel_offset >= TILE_SIZE - TURN_CORNER_PX &&
+                 pac_can_enter(g, tile_r + dirY(dir) + dirY(next_dir),
+                                  tile_c + dirX(dir) + dirX(next_dir)))
+        {
+            // Centre suivant presque atteint : on entre dans la tuile
+            // (collecte), décalage en arrière de son centre
+            int before = TILE_SIZE - pixel_offset;
+            pixel_offset = 0;
+            if (pac_enter_next_tile(g, *this))
             {
-                // try_portal_wrap a déjà mis à jour tile_r / tile_c / pixel_offset / dir
                 x = tile_c * TILE_SIZE + PACMAN_OFFSET;
                 y = tile_r * TILE_SIZE + PACMAN_OFFSET;
                 return;
             }
+            corner_dir = dir;
+            corner_off = -before;
+            dir = next_dir;
+        }
+    }
 
-            // ------------------------------------------------
-            // 4) COLLECTE (pellets / power pellets)
-            // ------------------------------------------------
-            TileType& cell = g.maze.tiles[tile_r][tile_c];
+    // Virage pris : une intention relâchée est consommée
+    if (dir == turn_dir && !dir_held(k, turn_dir))
+        turn_dir = Dir::None;
 
-            if (cell == TileType::Pellet)
-            {
-                cell = TileType::Empty;
-                g.maze.pellet_count--;
-                g.score += DOT_SCORE;
-                audio_play_pacgomme();
-            }
-            else if (cell == TileType::PowerPellet)
-            {
-                cell = TileType::Empty;
-                g.maze.power_pellet_count--;
-                g.score += POWERDOT_SCORE;
-                audio_play_power();
-                game_trigger_frightened(g);
-            }
+    // --------------------------------------------------------
+    // 3) AVANCEMENT 8.8 (arrêt au centre, reste reporté)
+    // --------------------------------------------------------
+    if (dir == Dir::None)
+    {
+        sub_px = 0;
+        corner_off = 0;
+    }
+
+    if (dir != Dir::None && speed > 0)
+    {
+        int  from    = pixel_offset;
+        bool entered = motion_advance(pixel_offset, sub_px, speed);
+
+        // Cornering : l'ancien axe se rapproche du centre d'autant
+        if (corner_off != 0)
+        {
+            int moved = entered ? TILE_SIZE - from : pixel_offset - from;
+            corner_off = (corner_off > 0) ? std::max(corner_off - moved, 0)
+                                          : std::min(corner_off + moved, 0);
+        }
+
+        // Nouvelle tuile : portails (3b) puis collecte (4)
+        if (entered && pac_enter_next_tile(g, *this))
+        {
+            x = tile_c * TILE_SIZE + PACMAN_OFFSET;
+            y = tile_r * TILE_SIZE + PACMAN_OFFSET;
+            return;
         }
     }
 
     // --------------------------------------------------------
     // 5) MISE À JOUR POSITION PIXEL (depuis tile + offset)
     // --------------------------------------------------------
-    x = tile_c * TILE_SIZE + PACMAN_OFFSET + dirX(dir) * pixel_offset;
-    y = tile_r * TILE_SIZE + PACMAN_OFFSET + dirY(dir) * pixel_offset;
+    x = tile_c * TILE_SIZE + PACMAN_OFFSET + dirX(dir) * pixel_offset
+                                          + dirX(corner_dir) * corner_off;
+    y = tile_r * TILE_SIZE + PACMAN_OFFSET + dirY(dir) * pixel_offset
+                                          + dirY(corner_dir) * corner_off;
 
     // --------------------------------------------------------
     // 6) ANIMATION
@@ -269,10 +399,10 @@ void Pacman::draw(const GameState& g) const
     int frame = (animTick / 4) % 3;
     const uint16_t* sprite = sprites[frame];
 
-    int screen_x = x;
+    int screen_x = x - (int)g_camera_x;
     int screen_y = y - (int)g_camera_y;
 
-    gfx_drawSprite(screen_x, screen_y, sprite, PACMAN_SIZE, PACMAN_SIZE);
+    draw_list_sprite(DrawLayer::Actors, screen_x, screen_y, sprite, PACMAN_SIZE, PACMAN_SIZE);
 
     /*
     DBG({
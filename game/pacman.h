@@ -7,7 +7,8 @@
 Ce module gère :
  - la position de Pac-Man en coordonnées tuiles
  - la direction actuelle et la direction demandée
- - l'avancement avec pixel_offset (case-based smooth)
+ - l'avancement avec pixel_offset (case-based smooth), vitesse
+   en virgule fixe 8.8 (cf. game/motion.h)
  - l’animation (3 frames par direction)
  - l’API update() / draw()
 
@@ -63,8 +64,11 @@ public:
       - exprimé en pixels (0..TILE_SIZE)
       - signé pour gérer les directions "négatives"
         (Up / Left si besoin).
+    sub_px :
+      - fraction de pixel accumulée (8.8), cf. motion.h
     */
-    int pixel_offset = 0;
+    int      pixel_offset = 0;
+    uint16_t sub_px       = 0;
 
     /*
     ------------------------------------------------------------
@@ -90,6 +94,31 @@ public:
     Dir dir      = Dir::None;
     Dir next_dir = Dir::None;
 
+    /*
+    ------------------------------------------------------------
+      Virage en coin (cornering) en cours
+    ------------------------------------------------------------
+    corner_off : décalage restant sur l'ancien axe (corner_dir),
+                 signé par rapport au centre de la tuile. Il se
+                 résorbe d'autant de pixels que l'avancée sur le
+                 nouvel axe : déplacement en diagonale, comme
+                 l'arcade (le coin coupé fait gagner de la distance).
+    */
+    int corner_off = 0;
+    Dir corner_dir = Dir::None;
+
+    /*
+    ------------------------------------------------------------
+      Intention de virage (tampon)
+    ------------------------------------------------------------
+    turn_dir     : dernière direction demandée, gardée
+                   TURN_BUFFER_FRAMES frames après relâchement
+    turn_time_us : horodatage de l'appui (événement input) ou
+                   de la dernière frame où elle était tenue
+    */
+    Dir     turn_dir     = Dir::None;
+    int64_t turn_time_us = 0;
+
     /*
     ------------------------------------------------------------
       Animation
@@ -126,7 +155,7 @@ public:
       API principale
     ------------------------------------------------------------
       update(GameState& g) :
-        - lit les inputs
+        - lit les inputs de la frame (g.input)
         - met à jour direction / offset / tuile
         - gère tunnels, pellets, power pellets, frightened
 
@@ -136,7 +165,7 @@ public:
     ------------------------------------------------------------
     */
     void update(GameState& g);
-    void draw(const GameState& g) const;
+    void draw(const GameState& g) const;    // émet dans la draw list (game_draw)
 
     /*
     ------------------------------------------------------------
@@ -0,0 +1,769 @@
+#include "snapshot.h"
+#include "game.h"
+#include "maze.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include "core/mem_track.h"
+#endif
+
+static const uint32_t SNAPSHOT_MAGIC  = 0x53534B50;   // "PKSS"
+static const size_t   SNAPSHOT_HEADER = 16;
+
+// Bornes = capacités réservées en jeu : un chargement ne fait pas grandir
+// les vecteurs de GameState (rollback et rewind tournent dans la frame)
+static const int MAX_GHOSTS          = 4;
+static const int MAX_FLOATING_SCORES = FLOATING_SCORES_RESERVE;
+static const int MAX_PATH            = Ghost::PATH_RESERVE;   // BFS plafonné
+
+/*
+============================================================
+  CRC-32 (polynôme IEEE, table calculée au premier appel)
+============================================================
+*/
+static uint32_t crc32(const uint8_t* p, size_t n)
+{
+    static uint32_t table[256];
+    static bool     ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/*
+============================================================
+  ARCHIVES : une seule description des champs (io_*) sert
+  à l'écriture et à la lecture
+============================================================
+*/
+struct Writer {
+    static const bool reading = false;
+
+    uint8_t* p;
+    size_t   cap;
+    size_t   n  = 0;
+    bool     ok = true;
+
+    void put(uint64_t v, int bytes)
+    {
+        if (n + bytes > cap) { ok = false; return; }
+        for (int i = 0; i < bytes; i++)
+            p[n++] = (uint8_t)(v >> (8 * i));
+    }
+
+    template<class T> void u8 (T& v) { put((uint64_t)(uint8_t)v, 1); }
+    template<class T> void i8 (T& v) { put((uint64_t)(int8_t)v, 1); }
+    template<class T> void u16(T& v) { put((uint64_t)(uint16_t)v, 2); }
+    template<class T> void i16(T& v) { put((uint64_t)(int16_t)v, 2); }
+    template<class T> void u32(T& v) { put((uint64_t)(uint32_t)v, 4); }
+    template<class T> void i32(T& v) { put((uint64_t)(int32_t)v, 4); }
+    template<class T> void i64(T& v) { put((uint64_t)v, 8); }
+
+    void bytes(void* v, size_t len)
+    {
+        if (n + len > cap) { ok = false; return; }
+        memcpy(p + n, v, len);
+        n += len;
+    }
+
+    // Nombre d'éléments d'un conteneur (borné)
+    void count(int& c, int max) { if (c > max) ok = false; u16(c); }
+};
+
+struct Reader {
+    static const bool reading = true;
+
+    const uint8_t* p;
+    size_t         size;
+    size_t         n  = 0;
+    bool           ok = true;
+
+    uint64_t get(int bytes)
+    {
+        if (n + bytes > size) { ok = false; return 0; }
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; i++)
+            v |= (uint64_t)p[n++] << (8 * i);
+        return v;
+    }
+
+    template<class T> void u8 (T& v) { v = (T)(uint8_t)get(1); }
+    template<class T> void i8 (T& v) { v = (T)(int8_t)get(1); }
+    template<class T> void u16(T& v) { v = (T)(uint16_t)get(2); }
+    template<class T> void i16(T& v) { v = (T)(int16_t)get(2); }
+    template<class T> void u32(T& v) { v = (T)(uint32_t)get(4); }
+    template<class T> void i32(T& v) { v = (T)(int32_t)get(4); }
+    template<class T> void i64(T& v) { v = (T)get(8); }
+
+    void bytes(void* v, size_t len)
+    {
+        if (n + len > size) { ok = false; return; }
+        memcpy(v, p + n, len);
+        n += len;
+    }
+
+    void count(int& c, int max) { u16(c); if (c > max) { ok = false; c = 0; } }
+};
+
+template<class A>
+static void io_portal(A& a, GameState::PortalPair& P)
+{
+    a.i8(P.T0_r); a.i8(P.T0_c); a.i8(P.E0_r); a.i8(P.E0_c);
+    a.i8(P.T1_r); a.i8(P.T1_c); a.i8(P.E1_r); a.i8(P.E1_c);
+    a.u8(P.exists);
+}
+
+template<class A>
+static void io_maze(A& a, Maze& m)
+{
+    a.u8(m.cols);
+    a.u8(m.rows);
+    if (m.cols < 1 || m.cols > MAZE_MAX_COLS || m.rows < 1 || m.rows > MAZE_MAX_ROWS) {
+        a.ok = false;
+        return;
+    }
+    for (int r = 0; r < m.rows; r++)
+        a.bytes(m.tiles[r], m.cols);
+
+    a.i16(m.pellet_count);
+    a.i16(m.power_pellet_count);
+    a.i8(m.pac_spawn_row);
+    a.i8(m.pac_spawn_col);
+    for (int i = 0; i < 4; i++) {
+        a.i8(m.ghost_spawn_row[i]);
+        a.i8(m.ghost_spawn_col[i]);
+    }
+    a.i8(m.fruit_row);
+    a.i8(m.fruit_col);
+    a.i8(m.ghost_door_row);
+    a.i8(m.ghost_door_col);
+    a.i8(m.ghost_center_row);
+    a.i8(m.ghost_center_col);
+    a.u8(m.tunnel_entry_count);
+    if (m.tunnel_entry_count > 2) a.ok = false;
+    for (int i = 0; i < 2; i++) {
+        a.i8(m.tunnel_entry_row[i]);
+        a.i8(m.tunnel_entry_col[i]);
+    }
+}
+
+template<class A>
+static void io_pacman(A& a, Pacman& p)
+{
+    a.i8(p.tile_r);      a.i8(p.tile_c);
+    a.i8(p.prev_tile_r); a.i8(p.prev_tile_c);
+    a.i8(p.pixel_offset);
+    a.u16(p.sub_px);
+    a.i16(p.x);          a.i16(p.y);
+    a.u8(p.dir);         a.u8(p.next_dir);
+    a.u8(p.turn_dir);    a.i64(p.turn_time_us);
+    a.i8(p.corner_off);  a.u8(p.corner_dir);
+    a.i32(p.animTick);
+}
+
+template<class A>
+static void io_ghost(A& a, Ghost& gh)
+{
+    a.i8(gh.id);
+    a.i8(gh.tile_r);      a.i8(gh.tile_c);
+    a.i8(gh.prev_tile_r); a.i8(gh.prev_tile_c);
+    a.i8(gh.pixel_offset);
+    a.u16(gh.sub_px);
+    a.i16(gh.x);          a.i16(gh.y);
+    a.u8(gh.dir);         a.u8(gh.next_dir);
+    a.u8(gh.mode);        a.u8(gh.previous_mode);
+    a.u8(gh.houseState);
+    a.i32(gh.eaten_timer);
+    a.u16(gh.speed_normal);   a.u16(gh.speed_frightened);
+    a.u16(gh.speed_tunnel);   a.u16(gh.speed_eyes);
+    a.u16(gh.speed_elroy1);   a.u16(gh.speed_elroy2);
+    a.i32(gh.animTick);
+    a.i8(gh.start_row);   a.i8(gh.start_col);
+    a.i32(gh.releaseTime_ticks);
+
+    // Chemin BFS en cours (yeux / sortie) : rejoué à l'identique
+    int len = (int)gh.path.size();
+    a.count(len, MAX_PATH);
+    if (A::reading) gh.path.resize(len);
+    for (auto& step : gh.path) {
+        a.i8(step.first);
+        a.i8(step.second);
+    }
+}
+
+template<class A>
+static void io_state(A& a, GameState& g)
+{
+    a.u8(g.state);
+    a.i16(g.levelIndex);
+    a.u8(g.ready_waiting_for_input);
+    a.i32(g.ready_timer);
+    a.u8(g.gameover_waiting_for_input);
+    a.i32(g.gameover_timer);
+
+    a.i16(g.level);
+    a.i32(g.score);
+    a.i8(g.lives);
+    a.i32(g.ghostEatScore);
+    a.i32(g.pacman_death_timer);
+    a.i8(g.pacman_start_r);
+    a.i8(g.pacman_start_c);
+
+    a.u8(g.ghostDoorState);
+    a.i32(g.ghostDoorTimer_ticks);
+    a.i32(g.ghostReleaseInterval_ticks);
+    a.i32(g.elapsed_ticks);
+
+    // Séquence Scatter / Chase
+    a.count(g.schedule.phase_count, 8);
+    for (int i = 0; i < 8; i++) {
+        a.u8(g.schedule.phases[i].mode);
+        a.i32(g.schedule.phases[i].duration_ticks);
+    }
+    a.i8(g.current_phase_index);
+    a.i32(g.phase_timer_ticks);
+    a.u8(g.global_mode);
+
+    a.i32(g.frightened_timer_ticks);
+    a.i32(g.frightened_duration_ticks);
+    a.i32(g.frightened_blink_start_ticks);
+    a.i32(g.frightened_chain);
+
+    a.u32(g.rng);
+    a.i8(g.ghost_player);
+
+    LevelSpeeds& s = g.speeds;
+    a.u16(s.pacman);            a.u16(s.ghost);
+    a.u16(s.ghost_tunnel);      a.u16(s.ghost_frightened);
+    a.u16(s.ghost_eyes);        a.u16(s.frightened_ticks);
+    a.u16(s.pacman_frightened); a.u16(s.ghost_elroy1);
+    a.u16(s.ghost_elroy2);      a.u16(s.elroy1_dots);
+    a.u16(s.elroy2_dots);
+
+    io_portal(a, g.portalH);
+    io_portal(a, g.portalV);
+    io_maze(a, g.maze);
+    io_pacman(a, g.pacman);
+
+    int ghosts = (int)g.ghosts.size();
+    a.count(ghosts, MAX_GHOSTS);
+    if (A::reading) g.ghosts.resize(ghosts);
+    for (auto& gh : g.ghosts)
+        io_ghost(a, gh);
+
+    int scores = (int)g.floatingScores.size();
+    a.count(scores, MAX_FLOATING_SCORES);
+    if (A::reading) g.floatingScores.resize(scores);
+    for (auto& fs : g.floatingScores) {
+        a.i16(fs.x);     a.i16(fs.y);
+        a.i32(fs.value); a.i32(fs.timer);
+    }
+}
+
+/*
+============================================================
+  VALIDATION (fichier forgé ou d'une autre version)
+------------------------------------------------------------
+Tout ce qui sert d'index (positions, id de fantôme, enums)
+est vérifié avant de toucher au GameState du jeu.
+============================================================
+*/
+template<class E>
+static bool enum_ok(E v, E last)
+{
+    return (unsigned)v <= (unsigned)last;
+}
+
+// Point facultatif : (-1, -1) = absent
+static bool inside_or_none(const Maze& m, int r, int c)
+{
+    return (r == -1 && c == -1) || m.inside(r, c);
+}
+
+static bool check_maze(const Maze& m)
+{
+    for (int r = 0; r < m.rows; r++)
+        for (int c = 0; c < m.cols; c++)
+            if (!enum_ok(m.tiles[r][c], TileType::FruitSpawn))
+                return false;
+
+    if (m.pellet_count < 0 || m.power_pellet_count < 0)
+        return false;
+    if (!m.inside(m.pac_spawn_row, m.pac_spawn_col))
+        return false;
+    for (int i = 0; i < 4; i++)
+        if (!m.inside(m.ghost_spawn_row[i], m.ghost_spawn_col[i]))
+            return false;
+
+    // level_init place les fantômes en centre, centre ± 1 colonne, centre + 1 ligne
+    if (!m.inside(m.ghost_center_row, m.ghost_center_col - 1) ||
+        !m.inside(m.ghost_center_row + 1, m.ghost_center_col + 1))
+        return false;
+
+    if (!inside_or_none(m, m.fruit_row, m.fruit_col) ||
+        !inside_or_none(m, m.ghost_door_row, m.ghost_door_col))
+        return false;
+    for (int i = 0; i < m.tunnel_entry_count; i++)
+        if (!m.inside(m.tunnel_entry_row[i], m.tunnel_entry_col[i]))
+            return false;
+    return true;
+}
+
+static bool check_portal(const Maze& m, const GameState::PortalPair& P)
+{
+    if (!P.exists)
+        return true;
+    return m.inside(P.T0_r, P.T0_c) && m.inside(P.E0_r, P.E0_c) &&
+           m.inside(P.T1_r, P.T1_c) && m.inside(P.E1_r, P.E1_c);
+}
+
+static bool check_pacman(const Maze& m, const Pacman& p)
+{
+    return m.inside(p.tile_r, p.tile_c) &&
+           m.inside(p.prev_tile_r, p.prev_tile_c) &&
+           enum_ok(p.dir,      Pacman::Dir::Down) &&
+           enum_ok(p.next_dir, Pacman::Dir::Down) &&
+           enum_ok(p.turn_dir, Pacman::Dir::Down) &&
+           enum_ok(p.corner_dir, Pacman::Dir::Down) &&
+           p.corner_off >= -TURN_CORNER_PX && p.corner_off <= TURN_CORNER_PX;
+}
+
+static bool check_ghost(const Maze& m, const Ghost& gh)
+{
+    if (gh.id < 0 || gh.id > 3)
+        return false;
+    if (!m.inside(gh.tile_r, gh.tile_c) ||
+        !m.inside(gh.prev_tile_r, gh.prev_tile_c) ||
+        !m.inside(gh.start_row, gh.start_col))
+        return false;
+    if (!enum_ok(gh.dir,           Ghost::Dir::Down)   ||
+        !enum_ok(gh.next_dir,      Ghost::Dir::Down)   ||
+        !enum_ok(gh.mode,          Ghost::Mode::Eaten) ||
+        !enum_ok(gh.previous_mode, Ghost::Mode::Eaten) ||
+        !enum_ok(gh.houseState,    Ghost::HouseState::Returning))
+        return false;
+    for (const auto& step : gh.path)
+        if (!m.inside(step.first, step.second))
+            return false;
+    return true;
+}
+
+static bool check_state(const GameState& g)
+{
+    const Maze& m = g.maze;
+
+    if (!enum_ok(g.state,          GameState::State::GameOver) ||
+        !enum_ok(g.ghostDoorState, GameState::DoorState::Open) ||
+        !enum_ok(g.global_mode,    GlobalGhostMode::Chase))
+        return false;
+
+    if (g.current_phase_index < 0 || g.current_phase_index >= g.schedule.phase_count)
+        return false;
+    for (int i = 0; i < g.schedule.phase_count; i++)
+        if (!enum_ok(g.schedule.phases[i].mode, GlobalGhostMode::Chase))
+            return false;
+
+    if (!check_maze(m) || !check_portal(m, g.portalH) || !check_portal(m, g.portalV))
+        return false;
+    if (!m.inside(g.pacman_start_r, g.pacman_start_c) || !check_pacman(m, g.pacman))
+        return false;
+
+    // Quatre fantômes, un par id (ghost_spawn_*, sprites, IA)
+    if (g.ghosts.size() != 4)
+        return false;
+    bool seen[4] = { false, false, false, false };
+    for (const auto& gh : g.ghosts) {
+        if (!check_ghost(m, gh) || seen[gh.id])
+            return false;
+        seen[gh.id] = true;
+    }
+    return g.ghost_player >= -1 && g.ghost_player < 4;
+}
+
+/*
+============================================================
+  API
+============================================================
+*/
+static void wr32(uint8_t* p, uint32_t v)
+{
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static uint32_t rd32(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t snapshot_save(const GameState& g, uint8_t* buf, size_t cap)
+{
+    if (cap < SNAPSHOT_HEADER)
+        return 0;
+
+    Writer w;
+    w.p   = buf + SNAPSHOT_HEADER;
+    w.cap = cap - SNAPSHOT_HEADER;
+    io_state(w, const_cast<GameState&>(g));    // l'écriture ne modifie rien
+    if (!w.ok)
+        return 0;
+
+    wr32(buf, SNAPSHOT_MAGIC);
+    buf[4] = (uint8_t)SNAPSHOT_VERSION;
+    buf[5] = (uint8_t)(SNAPSHOT_VERSION >> 8);
+    buf[6] = 0;
+    buf[7] = 0;
+    wr32(buf + 8,  (uint32_t)w.n);
+    wr32(buf + 12, crc32(w.p, w.n));
+    return SNAPSHOT_HEADER + w.n;
+}
+
+// Copie de décodage de snapshot_load. Les affectations vector gardent
+// la capacité : une fois dimensionnée, aucune copie n'alloue
+static GameState s_load_tmp;
+
+static void load_tmp_reserve()
+{
+    s_load_tmp.ghosts.resize(MAX_GHOSTS);
+    for (auto& gh : s_load_tmp.ghosts)
+        gh.path.reserve(MAX_PATH);
+    s_load_tmp.floatingScores.reserve(MAX_FLOATING_SCORES);
+}
+
+bool snapshot_load(GameState& g, const uint8_t* buf, size_t size)
+{
+    if (size < SNAPSHOT_HEADER || rd32(buf) != SNAPSHOT_MAGIC)
+        return false;
+
+    uint16_t version = buf[4] | (buf[5] << 8);
+    uint32_t len     = rd32(buf + 8);
+    if (version != SNAPSHOT_VERSION) {
+        printf("SNAPSHOT: version %u non supportée (attendue %u)\n",
+               (unsigned)version, (unsigned)SNAPSHOT_VERSION);
+        return false;
+    }
+    if (len > size - SNAPSHOT_HEADER || crc32(buf + SNAPSHOT_HEADER, len) != rd32(buf + 12)) {
+        printf("SNAPSHOT: contenu corrompu\n");
+        return false;
+    }
+
+    // Décodage dans une copie (dimensionnée par rewind_init) : g n'est
+    // modifié que si tout est valide
+    GameState& s_tmp = s_load_tmp;
+    s_tmp = g;
+
+    Reader r;
+    r.p    = buf + SNAPSHOT_HEADER;
+    r.size = len;
+    io_state(r, s_tmp);
+    if (!r.ok || r.n != len || !check_state(s_tmp)) {
+        printf("SNAPSHOT: contenu invalide\n");
+        return false;
+    }
+
+    g = s_tmp;
+    return true;
+}
+
+/*
+============================================================
+  SAVE-STATES (carte SD)
+============================================================
+*/
+static void slot_path(char* out, size_t cap, int slot)
+{
+    snprintf(out, cap, "/sdcard/PAKAMAN/state%d.sav", slot);
+}
+
+bool snapshot_save_slot(const GameState& g, int slot)
+{
+    static uint8_t buf[SNAPSHOT_MAX_BYTES];
+    size_t n = snapshot_save(g, buf, sizeof(buf));
+    if (!n)
+        return false;
+
+    char path[48];
+    slot_path(path, sizeof(path), slot);
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        printf("SNAPSHOT: impossible d'écrire %s\n", path);
+        return false;
+    }
+    bool ok = fwrite(buf, 1, n, f) == n;
+    fclose(f);
+    printf("SNAPSHOT: %s (%u octets)%s\n", path, (unsigned)n, ok ? "" : " ERREUR");
+    return ok;
+}
+
+bool snapshot_load_slot(GameState& g, int slot)
+{
+    static uint8_t buf[SNAPSHOT_MAX_BYTES];
+
+    char path[48];
+    slot_path(path, sizeof(path), slot);
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+    size_t n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+
+    return snapshot_load(g, buf, n);
+}
+
+/*
+============================================================
+  REWIND : anneau de photos delta en PSRAM
+------------------------------------------------------------
+Chaque entrée occupe une plage contiguë de l'anneau d'octets
+(on repart à 0 si la fin ne suffit pas) ; les plus anciennes
+sont évincées par groupe entier (photo complète + deltas qui
+en dépendent).
+Delta : XOR avec la photo précédente puis suite de
+[zéros : varint][littéraux : varint][octets…].
+============================================================
+*/
+struct RewindEntry {
+    uint32_t offset;
+    uint16_t size;       // octets stockés
+    uint16_t raw_size;   // taille de la photo décodée
+    bool     key;
+};
+
+static const int REWIND_MAX_ENTRIES = 1024;
+
+static struct {
+    bool         tried   = false;
+    uint8_t*     data    = nullptr;    // REWIND_RING_BYTES
+    RewindEntry* entries = nullptr;    // REWIND_MAX_ENTRIES
+    uint8_t*     prev    = nullptr;    // dernière photo enregistrée
+    uint8_t*     cur     = nullptr;
+    uint8_t*     enc     = nullptr;    // 2 × SNAPSHOT_MAX_BYTES
+    size_t       prev_size = 0;
+    int          first   = 0;          // plus ancienne entrée
+    int          count   = 0;
+    uint32_t     write   = 0;          // prochaine position d'écriture
+    int          since_key = 0;
+} s_rw;
+
+static void* rewind_alloc(size_t bytes)
+{
+#ifdef ESP_PLATFORM
+    return mem_alloc(MemTag::Snapshot, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    return malloc(bytes);
+#endif
+}
+
+static bool rewind_init()
+{
+    if (s_rw.tried)
+        return s_rw.data != nullptr;
+    s_rw.tried = true;
+    load_tmp_reserve();    // game_init : hors de la frame de jeu
+
+    size_t bytes = REWIND_RING_BYTES + REWIND_MAX_ENTRIES * sizeof(RewindEntry) +
+                   4 * SNAPSHOT_MAX_BYTES;
+    uint8_t* mem = (uint8_t*)rewind_alloc(bytes);
+    if (!mem) {
+        printf("REWIND: pas de PSRAM (%u octets), désactivé\n", (unsigned)bytes);
+        return false;
+    }
+
+    s_rw.entries = (RewindEntry*)mem;
+    s_rw.prev    = mem + REWIND_MAX_ENTRIES * sizeof(RewindEntry);
+    s_rw.cur     = s_rw.prev + SNAPSHOT_MAX_BYTES;
+    s_rw.enc     = s_rw.cur + SNAPSHOT_MAX_BYTES;
+    s_rw.data    = s_rw.enc + 2 * SNAPSHOT_MAX_BYTES;
+    printf("REWIND: %u Ko en PSRAM\n", (unsigned)(bytes / 1024));
+    return true;
+}
+
+void rewind_clear()
+{
+    rewind_init();    // anneau alloué ici (game_init), pas pendant la partie
+
+    s_rw.first     = 0;
+    s_rw.count     = 0;
+    s_rw.write     = 0;
+    s_rw.prev_size = 0;
+    s_rw.since_key = 0;
+}
+
+int rewind_count()
+{
+    return s_rw.count;
+}
+
+static RewindEntry& entry_at(int i)   // 0 = plus ancienne
+{
+    return s_rw.entries[(s_rw.first + i) % REWIND_MAX_ENTRIES];
+}
+
+static void evict_group()
+{
+    do {
+        s_rw.first = (s_rw.first + 1) % REWIND_MAX_ENTRIES;
+        s_rw.count--;
+    } while (s_rw.count > 0 && !entry_at(0).key);
+}
+
+static uint8_t* put_varint(uint8_t* p, uint32_t v)
+{
+    while (v >= 0x80) { *p++ = (uint8_t)(v | 0x80); v >>= 7; }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static const uint8_t* get_varint(const uint8_t* p, uint32_t& v)
+{
+    v = 0;
+    for (int shift = 0; ; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80) || shift >= 28) return p;
+    }
+}
+
+// cur XOR prev (prev complété de zéros) → plages zéros / littéraux
+static size_t delta_encode(const uint8_t* cur, size_t n, const uint8_t* prev, size_t prev_n, uint8_t* out)
+{
+    uint8_t* o = out;
+    size_t i = 0;
+    auto x = [&](size_t k) -> uint8_t { return cur[k] ^ (k < prev_n ? prev[k] : 0); };
+
+    while (i < n)
+    {
+        size_t z = i;
+        while (z < n && x(z) == 0) z++;
+
+        // Littéraux jusqu'à 3 zéros consécutifs (ou la fin)
+        size_t l = z;
+        while (l < n) {
+            if (x(l) == 0 && l + 2 < n && x(l + 1) == 0 && x(l + 2) == 0) break;
+            l++;
+        }
+
+        o = put_varint(o, (uint32_t)(z - i));
+        o = put_varint(o, (uint32_t)(l - z));
+        for (size_t k = z; k < l; k++)
+            *o++ = x(k);
+        i = l;
+    }
+    return o - out;
+}
+
+static void delta_decode(const uint8_t* in, size_t in_n, uint8_t* buf, size_t n, size_t prev_n)
+{
+    // buf contient la photo précédente : on la complète de zéros
+    if (n > prev_n)
+        memset(buf + prev_n, 0, n - prev_n);
+
+    const uint8_t* p   = in;
+    const uint8_t* end = in + in_n;
+    size_t i = 0;
+    while (p < end && i < n)
+    {
+        uint32_t z, l;
+        p = get_varint(p, z);
+        p = get_varint(p, l);
+        i += z;
+        for (uint32_t k = 0; k < l && i < n; k++)
+            buf[i++] ^= *p++;
+    }
+}
+
+void rewind_record(const GameState& g)
+{
+    if (!rewind_init())
+        return;
+
+    size_t n = snapshot_save(g, s_rw.cur, SNAPSHOT_MAX_BYTES);
+    if (!n)
+        return;
+
+    bool key = (s_rw.count == 0 || s_rw.since_key >= REWIND_KEY_INTERVAL - 1);
+    const uint8_t* src = s_rw.cur;
+    size_t         len = n;
+    if (!key) {
+        len = delta_encode(s_rw.cur, n, s_rw.prev, s_rw.prev_size, s_rw.enc);
+        src = s_rw.enc;
+    }
+
+    // Place contiguë dans l'anneau, en évinçant les plus anciennes
+    uint32_t pos = s_rw.write;
+    if (pos + len > REWIND_RING_BYTES)
+        pos = 0;
+    while (s_rw.count > 0)
+    {
+        const RewindEntry& old = entry_at(0);
+        bool overlap = old.offset < pos + len && pos < old.offset + old.size;
+        if (!overlap && s_rw.count < REWIND_MAX_ENTRIES)
+            break;
+        evict_group();
+    }
+    if (s_rw.count == 0 && !key) {
+        // Tout a été évincé : repartir d'une photo complète
+        key = true;
+        src = s_rw.cur;
+        len = n;
+        pos = 0;
+    }
+
+    memcpy(s_rw.data + pos, src, len);
+    RewindEntry& e = s_rw.entries[(s_rw.first + s_rw.count) % REWIND_MAX_ENTRIES];
+    e.offset   = pos;
+    e.size     = (uint16_t)len;
+    e.raw_size = (uint16_t)n;
+    e.key      = key;
+    s_rw.count++;
+    s_rw.write = pos + len;
+    s_rw.since_key = key ? 0 : s_rw.since_key + 1;
+
+    memcpy(s_rw.prev, s_rw.cur, n);
+    s_rw.prev_size = n;
+}
+
+bool rewind_step(GameState& g)
+{
+    if (s_rw.count < 2)
+        return false;
+
+    // La plus récente est l'état courant : on la retire
+    s_rw.count--;
+    int last = s_rw.count - 1;
+
+    // Photo complète du groupe, puis deltas jusqu'à la plus récente
+    int k = last;
+    while (k > 0 && !entry_at(k).key)
+        k--;
+
+    size_t n = 0;
+    for (int i = k; i <= last; i++)
+    {
+        const RewindEntry& e = entry_at(i);
+        if (e.key)
+            memcpy(s_rw.prev, s_rw.data + e.offset, e.size);
+        else
+            delta_decode(s_rw.data + e.offset, e.size, s_rw.prev, e.raw_size, n);
+        n = e.raw_size;
+    }
+    s_rw.prev_size = n;
+    s_rw.since_key = last - k;
+
+    const RewindEntry& e = entry_at(last);
+    s_rw.write = e.offset + e.size;
+
+    return snapshot_load(g, s_rw.prev, n);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+============================================================
+  snapshot.h — Photos de GameState (rewind, save-states)
+------------------------------------------------------------
+Format binaire compact, versionné, little-endian :
+
+    0   "PKSS"
+    4   u16 version (SNAPSHOT_VERSION)
+    6   u16 réservé (0)
+    8   u32 taille du contenu
+    12  u32 CRC-32 du contenu
+    16  contenu : champs de GameState, labyrinthe (cols × rows
+        octets), Pac-Man, fantômes (chemin BFS compris),
+        scores flottants, graine du hasard, fantôme du
+        joueur 2.
+
+Non sauvegardé : rendu (caméra) et entrées de la frame.
+Le code ne dépend pas de la plate-forme : un save-state pris
+sur la console se recharge dans un build Linux de la logique
+(cf. tools/snapshot_tool.cpp).
+
+Rewind : une photo par frame dans un anneau en PSRAM. Une photo
+sur REWIND_KEY_INTERVAL est complète, les autres sont codées
+par XOR avec la précédente puis compressées (plages de zéros) :
+quelques dizaines d'octets par frame.
+============================================================
+*/
+
+struct GameState;
+
+static const uint16_t SNAPSHOT_VERSION   = 3;
+static const size_t   SNAPSHOT_MAX_BYTES = 6144;
+
+// Sérialise g dans buf ; retourne la taille écrite (0 si cap insuffisant)
+size_t snapshot_save(const GameState& g, uint8_t* buf, size_t cap);
+
+// Recharge g depuis buf. false (g inchangé) si en-tête, version,
+// CRC ou bornes invalides (positions hors labyrinthe, id de
+// fantôme, enums hors plage, nombre de fantômes ≠ 4).
+bool snapshot_load(GameState& g, const uint8_t* buf, size_t size);
+
+// Save-states (carte SD : /sdcard/PAKAMAN/state<slot>.sav)
+bool snapshot_save_slot(const GameState& g, int slot);
+bool snapshot_load_slot(GameState& g, int slot);
+
+/*
+============================================================
+  REWIND
+============================================================
+*/
+static const int    REWIND_KEY_INTERVAL = 16;            // photos
+static const size_t REWIND_RING_BYTES   = 192 * 1024;    // PSRAM
+
+// Enregistre l'état courant (à appeler une fois par frame de jeu)
+void rewind_record(const GameState& g);
+
+// Recule d'une photo : g reçoit l'état précédent. false si vide.
+bool rewind_step(GameState& g);
+
+// Oublie tout (nouvelle partie, chargement d'un save-state)
+void rewind_clear();
+
+// Nombre de photos disponibles
+int rewind_count();
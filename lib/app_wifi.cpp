@@ -92,14 +92,37 @@ IRAM_ATTR static void wifi_event_handler_ap(void* arg, esp_event_base_t event_ba
     }
 }
 
-void wifi_init_softap(void)
+// netif, default event loop and wifi driver: once per boot, shared by
+// the softAP and the link play join (a second create/init aborts)
+static void wifi_stack_init(void)
 {
+    static bool done = false;
+    if (done)
+        return;
+    done = true;
+
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_create_default_wifi_ap();
 
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+}
+
+static bool s_softap_started = false;
+static bool s_sta_started = false;
+static void sta_leave(void);
+
+void wifi_init_softap(void)
+{
+    // may be called by telemetry (boot) and link play (title screen)
+    if (s_softap_started)
+        return;
+    s_softap_started = true;
+
+    wifi_stack_init();
+    if (s_sta_started)
+        sta_leave();
+    esp_netif_create_default_wifi_ap();
 
     ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
                                                         ESP_EVENT_ANY_ID,
@@ -162,6 +185,7 @@ void wifi_init_softap(void)
 
 #define EVENT_HANDLER_FLAG_DO_NOT_AUTO_RECONNECT 0x00000001
 static uint32_t wifi_event_handler_flag;
+static volatile bool s_sta_has_ip = false;
 
 static EventGroupHandle_t wifi_events;
 
@@ -189,6 +213,7 @@ IRAM_ATTR static void wifi_event_handler_sta(void* arg, esp_event_base_t event_b
         ESP_LOGI(TAG, "WIFI_EVENT_STA_DISCONNECTED");
         wifi_event_sta_disconnected_t *event = (wifi_event_sta_disconnected_t *)event_data;
         ESP_LOGI(TAG, "disconnect reason: %u", event->reason);
+        s_sta_has_ip = false;
         if (!(EVENT_HANDLER_FLAG_DO_NOT_AUTO_RECONNECT & wifi_event_handler_flag)) {
             ESP_ERROR_CHECK(esp_wifi_connect());
         }
@@ -214,6 +239,7 @@ IRAM_ATTR static void ip_event_handler_sta(void* arg, esp_event_base_t event_bas
         event = (ip_event_got_ip_t*)event_data;
         ESP_LOGI(TAG, "IP_EVENT_STA_GOT_IP");
         ESP_LOGI(TAG, "got ip:" IPSTR, IP2STR(&event->ip_info.ip));
+        s_sta_has_ip = true;
         if (wifi_events) {
             xEventGroupSetBits(wifi_events, GOT_IP_EVENT);
         }
@@ -396,6 +422,53 @@ void test_wifi_download_file()
 
 
 
+// stop retrying the join (timeout, or the console becomes the host)
+static void sta_leave(void)
+{
+    wifi_event_handler_flag |= EVENT_HANDLER_FLAG_DO_NOT_AUTO_RECONNECT;
+    ESP_ERROR_CHECK_WITHOUT_ABORT(esp_wifi_disconnect());
+}
+
+int wifi_join_softap(void)
+{
+    // telemetry or a previous host already runs the softAP on this console
+    if (s_softap_started) {
+        ESP_LOGW(TAG, "join refused: softAP already running");
+        return -1;
+    }
+    if (s_sta_has_ip)
+        return 0;
+
+    wifi_stack_init();
+    if (!s_sta_started) {
+        s_sta_started = true;
+        ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler_sta, NULL));
+        ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, ESP_EVENT_ANY_ID, &ip_event_handler_sta, NULL));
+        s_sta_netif = esp_netif_create_default_wifi_sta();
+        wifi_events = xEventGroupCreate();
+        ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+        ESP_ERROR_CHECK(esp_wifi_start());
+    }
+
+    // each attempt: config, connect, wait (retried by the disconnect handler)
+    wifi_config_t w_config = {};
+    strncpy((char*)w_config.sta.ssid, EXAMPLE_ESP_WIFI_SSID, sizeof(w_config.sta.ssid));
+    strncpy((char*)w_config.sta.password, EXAMPLE_ESP_WIFI_PASS, sizeof(w_config.sta.password));
+
+    xEventGroupClearBits(wifi_events, GOT_IP_EVENT);
+    wifi_event_handler_flag &= ~EVENT_HANDLER_FLAG_DO_NOT_AUTO_RECONNECT;
+    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &w_config));
+    ESP_ERROR_CHECK_WITHOUT_ABORT(esp_wifi_connect());
+    ESP_LOGI(TAG, "join softAP: %s", EXAMPLE_ESP_WIFI_SSID);
+
+    EventBits_t bits = xEventGroupWaitBits(wifi_events, GOT_IP_EVENT, 1, 0, CONNECT_TIMEOUT_MS / portTICK_PERIOD_MS);
+    if (bits & GOT_IP_EVENT)
+        return 0;
+
+    sta_leave();
+    return -1;
+}
+
 void test_wifi_connection_sta(void)
 {
     ESP_ERROR_CHECK(esp_netif_init());
@@ -4,4 +4,6 @@
 void wifi_init_softap(void);
     // connect to wifi network
 //void wifi_init_sta(void);
-void test_wifi_connection_sta(void);
\ No newline at end of file
+void test_wifi_connection_sta(void);
+    // connect to the softAP of another console (link play), 0 on success
+int wifi_join_softap(void);
\ No newline at end of file
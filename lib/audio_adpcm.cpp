@@ -0,0 +1,214 @@
+#include "audio_adpcm.h"
+
+// -------------------------------------------------------------
+// Tables IMA standard
+// -------------------------------------------------------------
+static const int8_t s_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const int16_t s_step_table[89] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+struct AdpcmState {
+    int32_t predictor;
+    int32_t index;
+};
+
+static inline int16_t decode_nibble(AdpcmState& st, uint8_t nibble)
+{
+    int32_t step = s_step_table[st.index];
+
+    int32_t diff = step >> 3;
+    if (nibble & 1) diff += step >> 2;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 4) diff += step;
+    if (nibble & 8) diff = -diff;
+
+    st.predictor += diff;
+    if (st.predictor >  32767) st.predictor =  32767;
+    if (st.predictor < -32768) st.predictor = -32768;
+
+    st.index += s_index_table[nibble];
+    if (st.index < 0)  st.index = 0;
+    if (st.index > 88) st.index = 88;
+
+    return (int16_t)st.predictor;
+}
+
+static inline uint8_t encode_sample(AdpcmState& st, int16_t sample)
+{
+    int32_t step = s_step_table[st.index];
+    int32_t diff = sample - st.predictor;
+
+    uint8_t nibble = 0;
+    if (diff < 0) { nibble = 8; diff = -diff; }
+    if (diff >= step)        { nibble |= 4; diff -= step; }
+    if (diff >= (step >> 1)) { nibble |= 2; diff -= step >> 1; }
+    if (diff >= (step >> 2)) { nibble |= 1; }
+
+    // Même reconstruction que le décodeur pour rester synchronisé
+    decode_nibble(st, nibble);
+    return nibble;
+}
+
+uint32_t adpcm_block_samples(uint32_t block_bytes, uint16_t channels)
+{
+    uint32_t header = 4u * channels;
+    if (channels == 0 || block_bytes < header)
+        return 0;
+
+    return ((block_bytes - header) * 2) / channels + 1;
+}
+
+// -------------------------------------------------------------
+// Décodage d'un bloc
+// -------------------------------------------------------------
+uint32_t adpcm_decode_block(const uint8_t* block, uint32_t block_bytes,
+                            uint16_t channels,
+                            int16_t* out, uint32_t max_samples)
+{
+    uint32_t n = adpcm_block_samples(block_bytes, channels);
+    if (n > max_samples)
+        n = max_samples;
+    if (n == 0)
+        return 0;
+
+    // Cas courant : mono, nibbles consécutifs (poids faible d'abord)
+    if (channels == 1)
+    {
+        AdpcmState st;
+        st.predictor = (int16_t)(block[0] | (block[1] << 8));
+        st.index     = block[2] > 88 ? 88 : block[2];
+        out[0] = (int16_t)st.predictor;
+
+        const uint8_t* p = block + 4;
+        uint32_t i = 1;
+        while (i + 1 < n) {
+            uint8_t b = *p++;
+            out[i++] = decode_nibble(st, b & 0x0F);
+            out[i++] = decode_nibble(st, b >> 4);
+        }
+        if (i < n)
+            out[i] = decode_nibble(st, *p & 0x0F);
+        return n;
+    }
+
+    // Multi-canal : groupes de 4 octets (8 échantillons) par canal,
+    // entrelacés. Un bloc tronqué est limité aux groupes complets.
+    uint32_t groups = (block_bytes - 4u * channels) / (4u * channels);
+    if (n > groups * 8 + 1)
+        n = groups * 8 + 1;
+
+    for (uint32_t i = 0; i < n; i++)
+        out[i] = 0;
+
+    // Chaque canal ajoute sa part (1/channels) : moyenne sans buffer temporaire
+    for (uint16_t c = 0; c < channels; c++)
+    {
+        const uint8_t* h = block + 4 * c;
+        AdpcmState st;
+        st.predictor = (int16_t)(h[0] | (h[1] << 8));
+        st.index     = h[2] > 88 ? 88 : h[2];
+
+        // Échantillon 0 (entête)
+        out[0] = (int16_t)(out[0] + st.predictor / channels);
+
+        const uint8_t* data = block + 4 * channels;
+        uint32_t i = 1;
+        for (uint32_t group = 0; i < n; group++)
+        {
+            const uint8_t* p = data + (group * channels + c) * 4;
+            for (int k = 0; k < 4 && i < n; k++) {
+                uint8_t b = p[k];
+                out[i] = (int16_t)(out[i] + decode_nibble(st, b & 0x0F) / channels); i++;
+                if (i < n) {
+                    out[i] = (int16_t)(out[i] + decode_nibble(st, b >> 4) / channels); i++;
+                }
+            }
+        }
+    }
+
+    return n;
+}
+
+// -------------------------------------------------------------
+// Décodage séquentiel (mono)
+// -------------------------------------------------------------
+uint32_t adpcm_decode_next(const uint8_t* block, uint32_t block_bytes,
+                           adpcm_cursor& cur,
+                           int16_t* out, uint32_t max_samples)
+{
+    uint32_t n = adpcm_block_samples(block_bytes, 1);
+    if (cur.sample >= n || max_samples == 0)
+        return 0;
+    if (max_samples > n - cur.sample)
+        max_samples = n - cur.sample;
+
+    uint32_t k = 0;
+    if (cur.sample == 0) {
+        cur.predictor = (int16_t)(block[0] | (block[1] << 8));
+        cur.index     = block[2] > 88 ? 88 : block[2];
+        out[k++] = (int16_t)cur.predictor;
+    }
+
+    // Échantillon i >= 1 : nibble i - 1 après l'entête (poids faible d'abord)
+    AdpcmState st = { cur.predictor, cur.index };
+    for (; k < max_samples; k++) {
+        uint32_t nib = cur.sample + k - 1;
+        uint8_t b = block[4 + nib / 2];
+        out[k] = decode_nibble(st, (nib & 1) ? (uint8_t)(b >> 4) : (uint8_t)(b & 0x0F));
+    }
+
+    cur.predictor = st.predictor;
+    cur.index     = st.index;
+    cur.sample   += k;
+    return k;
+}
+
+// -------------------------------------------------------------
+// Encodage d'un bloc mono
+// -------------------------------------------------------------
+void adpcm_encode_block(adpcm_encoder& enc, const int16_t* pcm, uint32_t n,
+                        uint8_t* block, uint32_t block_bytes)
+{
+    uint32_t capacity = adpcm_block_samples(block_bytes, 1);
+    if (n > capacity)
+        n = capacity;
+
+    for (uint32_t i = 0; i < block_bytes; i++)
+        block[i] = 0;
+    if (n == 0)
+        return;
+
+    // Entête : premier échantillon en clair + index de pas courant
+    AdpcmState st;
+    st.predictor = pcm[0];
+    st.index     = enc.index;
+    block[0] = (uint8_t)(pcm[0] & 0xFF);
+    block[1] = (uint8_t)((uint16_t)pcm[0] >> 8);
+    block[2] = (uint8_t)st.index;
+
+    uint8_t* p = block + 4;
+    for (uint32_t i = 1; i < n; i++) {
+        uint8_t nibble = encode_sample(st, pcm[i]);
+        if (i & 1)
+            *p = nibble;
+        else
+            *p++ |= (uint8_t)(nibble << 4);
+    }
+
+    // Seuls les n premiers échantillons du bloc sont utilisés au décodage
+    enc.predictor = st.predictor;
+    enc.index     = st.index;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+
+// -------------------------------------------------------------
+// Décodage IMA-ADPCM (format WAV 0x0011, 4 bits / échantillon)
+// -------------------------------------------------------------
+// Un fichier IMA-ADPCM est découpé en blocs indépendants de
+// block_align octets. Chaque bloc commence (par canal) par un
+// entête de 4 octets : premier échantillon 16 bits + index de pas,
+// puis les nibbles des échantillons suivants.
+//
+// Le premier échantillon d'un bloc est stocké en clair : on peut
+// donc décoder n'importe quel bloc sans décoder les précédents.
+// -------------------------------------------------------------
+
+// Taille max d'un bloc accepté pour la lecture "lazy" des SFX
+// (bloc mono de 512 octets, taille standard à 22050 Hz)
+static const uint32_t ADPCM_MAX_BLOCK_SAMPLES = 1017;
+
+// Nombre d'échantillons (par canal) contenus dans un bloc de n octets
+uint32_t adpcm_block_samples(uint32_t block_bytes, uint16_t channels);
+
+// Décode un bloc (éventuellement incomplet en fin de fichier) en
+// PCM 16 bits mono (moyenne des canaux si besoin).
+// Retourne le nombre d'échantillons écrits (<= max_samples).
+uint32_t adpcm_decode_block(const uint8_t* block, uint32_t block_bytes,
+                            uint16_t channels,
+                            int16_t* out, uint32_t max_samples);
+
+// -------------------------------------------------------------
+// Décodage séquentiel d'un bloc mono par petites fenêtres
+// -------------------------------------------------------------
+// L'état du décodeur est conservé entre deux appels : on peut lire
+// un bloc morceau par morceau sans tampon de la taille du bloc.
+// Curseur remis à zéro = reprise depuis l'entête du bloc.
+struct adpcm_cursor {
+    int32_t  predictor = 0;
+    int32_t  index = 0;
+    uint32_t sample = 0;    // échantillons du bloc déjà décodés
+};
+
+// Décode les max_samples échantillons suivants du bloc (au plus).
+// Retourne le nombre d'échantillons écrits (0 = fin du bloc).
+uint32_t adpcm_decode_next(const uint8_t* block, uint32_t block_bytes,
+                           adpcm_cursor& cur,
+                           int16_t* out, uint32_t max_samples);
+
+// -------------------------------------------------------------
+// Encodage IMA-ADPCM mono (rendu en mémoire, ex. musique PMF)
+// -------------------------------------------------------------
+struct adpcm_encoder {
+    int32_t predictor = 0;
+    int32_t index = 0;      // conservé d'un bloc à l'autre
+};
+
+// Encode n échantillons (n <= adpcm_block_samples(block_bytes, 1))
+// dans un bloc de block_bytes octets (complété par du silence).
+void adpcm_encode_block(adpcm_encoder& enc, const int16_t* pcm, uint32_t n,
+                        uint8_t* block, uint32_t block_bytes);
@@ -70,61 +70,47 @@ int16_t audio_track_noise::next_sample()
 // -------------------------------------------------------------
 audio_track_wav::audio_track_wav()
 {
-    file = nullptr;
-    samples_remaining = 0;
+    buffer = nullptr;
     buffer_len = 0;
+    last_block = false;
+    restart = false;
     pos = 0.0f;
     active = false;
 }
 
-void audio_track_wav::start(FILE* f, uint32_t sample_count)
+bool audio_track_wav::init_streaming(UBaseType_t priority, int core)
 {
-    if (file) {
-        fclose(file);
-        file = nullptr;
-    }
+    return stream.start_task(priority, core);
+}
 
-    file = f;
-    samples_remaining = sample_count;
-    buffer_len = 0;
-    pos = 0.0f;
-    active = (file != nullptr && samples_remaining > 0);
+// Appelé côté jeu : l'état du mixeur est remis à zéro dans next_sample()
+void audio_track_wav::start(FILE* f, const wav_info& info)
+{
+    // Ouverture et décodage faits par la tâche de lecture
+    bool ok = stream.open(f, info);
+    restart = true;
+    active = ok;
 }
 
 void audio_track_wav::fill_buffer()
 {
-    if (!file || samples_remaining == 0) {
-        buffer_len = 0;
-        pos = 0.0f;
-        active = false;
-        return;
-    }
-
-    uint32_t to_read = WAV_BUFFER_SAMPLES;
-    if (samples_remaining < to_read)
-        to_read = samples_remaining;
-
-    size_t n = fread(buffer, sizeof(int16_t), to_read, file);
-    buffer_len = (uint32_t)n;
+    // Jamais de fread ici : on prend le bloc suivant s'il est prêt
+    stream.release();
+    buffer = nullptr;
+    buffer_len = 0;
     pos = 0.0f;
 
-    if (n == 0) {
-        fclose(file);
-        file = nullptr;
-        samples_remaining = 0;
+    if (last_block) {
         active = false;
         return;
     }
 
-    samples_remaining -= buffer_len;
-
-    if (samples_remaining == 0) {
-        fclose(file);
-        file = nullptr;
-    }
-
-    if (buffer_len == 0)
+    // Bloc pas encore lu : silence, on réessaie à l'échantillon suivant
+    buffer = stream.acquire(&buffer_len, &last_block);
+    if (buffer && last_block && buffer_len == 0) {
+        stream.release();
         active = false;
+    }
 }
 
 int16_t audio_track_wav::next_sample()
@@ -132,6 +118,15 @@ int16_t audio_track_wav::next_sample()
     if (!active)
         return 0;
 
+    if (restart) {
+        restart = false;
+        stream.release();
+        buffer = nullptr;
+        buffer_len = 0;
+        last_block = false;
+        pos = 0.0f;
+    }
+
     // Pitch glide
     pitch += (target_pitch - pitch) * pitch_smooth;
 
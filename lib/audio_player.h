@@ -2,11 +2,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <cstdio>   // pour FILE*
-
-// -------------------------------------------------------------
-// Taille locale du buffer WAV pour le streaming
-// -------------------------------------------------------------
-static constexpr int WAV_BUFFER_SAMPLES = 512;
+#include "audio_wav.h"
+#include "audio_stream.h"
 
 // -------------------------------------------------------------
 // Classe de base pour toutes les pistes audio
@@ -60,20 +57,28 @@ class audio_track_wav : public audio_track_base {
 public:
     audio_track_wav();
 
-    void start(FILE* f, uint32_t sample_count);
+    // Crée la tâche de lecture SD (à appeler une fois depuis audio_init)
+    bool init_streaming(UBaseType_t priority, int core);
+
+    // Prend possession de f, positionné sur le chunk data (wav_parse_header)
+    void start(FILE* f, const wav_info& info);
 
     int16_t next_sample() override;
     bool is_active() const override { return active; }
 
+    // Blocs pas encore lus par la tâche SD quand le mixeur en avait besoin
+    uint32_t underrun_count() const { return stream.underrun_count(); }
+
     float pitch = 1.0f;         // pitch actuel
     float target_pitch = 1.0f;  // pitch cible (glide)
     float pitch_smooth = 0.15f; // vitesse du glide
 
 private:
-    FILE*      file;
-    uint32_t   samples_remaining;
-    int16_t    buffer[WAV_BUFFER_SAMPLES];
+    audio_wav_stream stream;    // blocs PCM natifs lus en tâche de fond
+    const int16_t* buffer;      // bloc courant (appartient au stream)
     uint32_t   buffer_len;
+    bool       last_block;      // le bloc courant termine le fichier
+    volatile bool restart;      // start() demandé : le mixeur rend son bloc
     float      pos;             // position flottante dans le buffer
     bool       active;
 
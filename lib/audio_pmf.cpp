@@ -23,18 +23,39 @@
 * Pour volume :
   audioPMF.setVolume(128);
 
+* Pour accélérer la musique / couper des canaux (intensité dynamique) :
+  audioPMF.setTempo(256 * 5 / 4);     // +25 %
+  audioPMF.setChannelMask(0x0c);      // canaux 2 et 3 muets
+
+* Pour pré-rendre la musique en boucle (copie au lieu de synthèse) :
+  audioPMF.setPrerender(true);
+  Avec un second tempo joué (ex. accéléré le temps d'un bonus) :
+  audioPMF.setPrerender(true, PMF_PRERENDER_ADPCM, 256 * 115 / 100);
+  Tout autre tempo joue en synthèse live ; le premier setChannelMask
+  y repasse jusqu'au prochain start().
+
 -------------------------------------*/  
 
 
-void AudioPMF::init(const uint8_t* data)
+void AudioPMF::init(const uint8_t* pmf_data)
 {
-    player.load(data);
+    player.load(pmf_data);
+    data = pmf_data;
 }
 
-void AudioPMF::start(uint32_t sample_rate, uint16_t playlist_pos)
+void AudioPMF::start(uint32_t rate, uint16_t playlist_pos)
 {
-    player.start(sample_rate, playlist_pos);
+    player.start(rate, playlist_pos);
     paused = false;
+
+    sample_rate = rate;
+    start_pos = playlist_pos;
+    played = 0;
+    played_tempo = player.tempo_scale();
+    fade_left = 0;
+    // Les caches sont rendus tous canaux actifs
+    prerender_valid = player.channel_mute_mask() == 0;
+    prerender_dirty = true;
 }
 
 void AudioPMF::stop()
@@ -52,6 +73,67 @@ void AudioPMF::setVolume(uint8_t vol)
     volume = vol;
 }
 
+void AudioPMF::setPrerender(bool enable, pmf_prerender_format format, uint16_t alt_tempo)
+{
+    prerender_enabled = enable;
+    prerender_format = format;
+    prerender_alt_tempo = (alt_tempo == 256) ? 0 : alt_tempo;
+    prerender_dirty = true;
+}
+
+// Le cache du nouveau tempo est choisi dans render() (cf. retime)
+void AudioPMF::setTempo(uint16_t scale)
+{
+    player.set_tempo_scale(scale);
+}
+
+void AudioPMF::setChannelMask(uint16_t mute_mask)
+{
+    if (mute_mask == player.channel_mute_mask())
+        return;
+    player.set_channel_mute_mask(mute_mask);
+    invalidatePrerender();
+}
+
+void AudioPMF::invalidatePrerender()
+{
+    prerender_valid = false;
+}
+
+int AudioPMF::cache_index(uint16_t tempo) const
+{
+    if (tempo == 256)
+        return 0;
+    if (prerender_alt_tempo && tempo == prerender_alt_tempo)
+        return 1;
+    return -1;
+}
+
+// Tempo changé : 'played' passe sur l'échelle du nouveau tempo
+void AudioPMF::retime(uint16_t tempo)
+{
+    int from = cache_index(played_tempo);
+    int to   = cache_index(tempo);
+
+    if (from >= 0 && to >= 0 && prerender[from].ready() && prerender[to].ready())
+    {
+        // Les deux caches s'arrêtent au même point de la playlist :
+        // le rapport de leurs longueurs donne la position exacte
+        uint32_t pos = prerender[from].wrap(played);
+        played = (uint64_t)pos * prerender[to].length() / prerender[from].length();
+
+        fade_from   = (int8_t)from;
+        fade_played = pos;
+        fade_left   = prerender_valid ? FADE_SAMPLES : 0;
+    }
+    else
+    {
+        played = played * played_tempo / tempo;
+        fade_left = 0;
+    }
+    played_tempo = tempo;
+}
+
 void AudioPMF::render(int16_t* out, int samples)
 {
     if (paused || volume == 0)
@@ -61,10 +143,62 @@ void AudioPMF::render(int16_t* out, int samples)
     if (samples > 512)
         samples = 512;
 
+    // (Re)lancement ou libération du pré-rendu : fait ici pour que le
+    // cache ne soit jamais libéré pendant une lecture
+    if (prerender_dirty)
+    {
+        prerender_dirty = false;
+        fade_left = 0;
+        if (prerender_enabled && data && sample_rate) {
+            prerender[0].begin(data, sample_rate, start_pos, prerender_format);
+            if (prerender_alt_tempo)
+                prerender[1].begin(data, sample_rate, start_pos, prerender_format,
+                                   prerender_alt_tempo);
+            else
+                prerender[1].release();
+        } else {
+            prerender[0].release();
+            prerender[1].release();
+        }
+    }
+
+    if (!player.is_playing())
+        return;
+
+    uint16_t tempo = player.tempo_scale();
+    if (tempo != played_tempo)
+        retime(tempo);
+
     memset(temp, 0, samples * sizeof(int16_t));
 
-    // mélange PMF → temp
-    player.mix(temp, samples);
+    int cache = prerender_valid ? cache_index(tempo) : -1;
+    if (cache >= 0 && prerender[cache].ready())
+    {
+        // Cache prêt : copie, le lecteur avance sans mixer pour rester synchro
+        prerender[cache].read(temp, played, samples);
+        player.skip(samples);
+
+        // Fondu depuis le cache de l'ancien tempo
+        if (fade_left > 0 && prerender[fade_from].ready())
+        {
+            static int16_t prev[512];
+            int n = samples < fade_left ? samples : fade_left;
+            prerender[fade_from].read(prev, fade_played, n);
+            for (int i = 0; i < n; i++)
+            {
+                int32_t w = fade_left - i;    // poids de l'ancien : FADE_SAMPLES → 0
+                temp[i] = int16_t((prev[i] * w + temp[i] * (FADE_SAMPLES - w)) / FADE_SAMPLES);
+            }
+            fade_left   -= n;
+            fade_played += n;
+        }
+    }
+    else
+    {
+        // mélange PMF → temp
+        player.mix(temp, samples);
+    }
+    played += samples;
 
     // mixage temp → out
     for (int i = 0; i < samples; i++)
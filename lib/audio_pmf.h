@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>   
 #include "pmf_player.h"
+#include "audio_pmf_prerender.h"
 
 class AudioPMF {
 public:
@@ -12,10 +13,51 @@ public:
     void render(int16_t* out, int samples);
 	
 	bool isPlaying() const { return player.is_playing(); }
+	uint8_t activeVoices() const { return player.num_mixed_channels(); }
+
+    // Pré-rendu en PSRAM de la musique en boucle (tâche de fond) :
+    // une fois prêt, render() ne fait plus qu'une copie. Un cache au
+    // tempo du fichier, plus un second à alt_tempo (0 = aucun) : un
+    // setTempo entre les deux passe d'un cache à l'autre (fondu court).
+    // Autre tempo ou canaux muets : synthèse live.
+    void setPrerender(bool enable, pmf_prerender_format format = PMF_PRERENDER_PCM,
+                      uint16_t alt_tempo = 0);
+
+    // Tempo (8.8, 256 = tempo du fichier) et canaux muets (bit n = canal n),
+    // appliqués au prochain tick. Les canaux muets ne sont pas mixés.
+    void setTempo(uint16_t scale);
+    void setChannelMask(uint16_t mute_mask);
+    uint16_t tempo() const { return player.tempo_scale(); }
+    uint16_t channelMask() const { return player.channel_mute_mask(); }
+
+    // Canaux modifiés à l'exécution : le cache ne correspond plus,
+    // retour à la synthèse live jusqu'au prochain start()
+    void invalidatePrerender();
 
-	
 private:
     pmf_player player;
     bool paused = false;
     uint8_t volume = 255;
+
+    // Pré-rendu (géré uniquement depuis render(), donc la tâche audio)
+    const uint8_t* data = nullptr;
+    uint32_t sample_rate = 0;
+    uint16_t start_pos = 0;
+    pmf_prerender prerender[2];              // [0] tempo 256, [1] prerender_alt_tempo
+    bool prerender_enabled = false;
+    pmf_prerender_format prerender_format = PMF_PRERENDER_PCM;
+    uint16_t prerender_alt_tempo = 0;
+    volatile bool prerender_dirty = false;   // paramètres changés : (re)lancer
+    volatile bool prerender_valid = false;   // le live suit encore le cache
+    uint64_t played = 0;                     // position, à l'échelle de played_tempo
+    uint16_t played_tempo = 256;
+
+    // Fondu au changement de cache : les voix n'y sont pas au même point
+    static const uint16_t FADE_SAMPLES = 256;
+    int8_t   fade_from = 0;
+    uint16_t fade_left = 0;
+    uint64_t fade_played = 0;
+
+    int cache_index(uint16_t tempo) const;   // -1 : pas de cache à ce tempo
+    void retime(uint16_t tempo);
 };
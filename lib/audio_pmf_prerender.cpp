@@ -0,0 +1,319 @@
+#include "audio_pmf_prerender.h"
+#include "audio_adpcm.h"
+#include "pmf_player.h"
+#include "core/mem_track.h"
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+// -------------------------------------------------------------
+// Détection du point de boucle
+// -------------------------------------------------------------
+// On rejoue la playlist sans mixer (pmf_player::skip) en notant
+// l'échantillon auquel chaque pattern commence. Le premier pattern
+// rejoué (même position, même ligne d'entrée) ferme la boucle.
+
+static const int MAX_PATTERN_ENTRIES = 256;
+
+struct LoopScan {
+    pmf_player* player;
+    uint32_t    offset;        // échantillons rendus à la fin du tick en cours
+    int         last_pos;
+    uint16_t    entry_key[MAX_PATTERN_ENTRIES];
+    uint32_t    entry_offset[MAX_PATTERN_ENTRIES];
+    int         entry_count;
+    bool        found;
+    uint32_t    loop_start;
+    uint32_t    loop_end;
+};
+
+static void loop_scan_row(void* custom, uint8_t channel_idx,
+                          uint8_t&, uint8_t&, uint8_t&, uint8_t&, uint8_t&)
+{
+    LoopScan& scan = *static_cast<LoopScan*>(custom);
+    if (channel_idx != 0 || scan.found)
+        return;
+
+    int pos = scan.player->playlist_pos();
+    int row = scan.player->pattern_row();
+    if (pos == scan.last_pos && row != 0)
+        return;
+    scan.last_pos = pos;
+
+    uint16_t key = (uint16_t)((pos << 8) | row);
+    for (int i = 0; i < scan.entry_count; i++) {
+        if (scan.entry_key[i] == key) {
+            scan.found      = true;
+            scan.loop_start = scan.entry_offset[i];
+            scan.loop_end   = scan.offset;
+            return;
+        }
+    }
+
+    if (scan.entry_count < MAX_PATTERN_ENTRIES) {
+        scan.entry_key[scan.entry_count]    = key;
+        scan.entry_offset[scan.entry_count] = scan.offset;
+        scan.entry_count++;
+    }
+}
+
+// -------------------------------------------------------------
+// pmf_prerender
+// -------------------------------------------------------------
+// Passage de main job <-> tâche (fin de rendu / détachement)
+static portMUX_TYPE s_job_mux = portMUX_INITIALIZER_UNLOCKED;
+
+pmf_prerender::pmf_prerender()
+{
+    job = nullptr;
+}
+
+pmf_prerender::~pmf_prerender()
+{
+    release();
+}
+
+bool pmf_prerender::begin(const uint8_t* pmf_, uint32_t sample_rate_, uint16_t playlist_pos_,
+                          pmf_prerender_format format_, uint16_t tempo_)
+{
+    // Même musique déjà rendue (ou en cours) : rien à refaire
+    if (job && pmf_ == job->pmf && sample_rate_ == job->sample_rate &&
+        playlist_pos_ == job->playlist_pos && format_ == job->format && tempo_ == job->tempo &&
+        (job->state == STATE_RENDERING || job->state == STATE_READY))
+        return true;
+
+    release();
+
+    Job* j = new (std::nothrow) Job();
+    if (!j)
+        return false;
+    j->pmf          = pmf_;
+    j->sample_rate  = sample_rate_;
+    j->playlist_pos = playlist_pos_;
+    j->format       = format_;
+    j->tempo        = tempo_;
+    j->state        = STATE_RENDERING;
+    j->cancel       = false;
+    j->detached     = false;
+    j->cached_block = -1;
+
+    // Priorité minimale : le rendu n'utilise que le temps libre du core 1
+    if (xTaskCreatePinnedToCore(task_entry, "pmf_prerender", 4096, j,
+                                1, nullptr, 1) != pdPASS) {
+        delete j;
+        return false;
+    }
+    job = j;
+    return true;
+}
+
+void pmf_prerender::release()
+{
+    if (!job)
+        return;
+
+    Job* j = job;
+    job = nullptr;
+
+    // Rendu en cours : on l'abandonne à sa tâche, qui le libère en sortant
+    portENTER_CRITICAL(&s_job_mux);
+    bool running = (j->state == STATE_RENDERING);
+    if (running) {
+        j->cancel   = true;
+        j->detached = true;
+    }
+    portEXIT_CRITICAL(&s_job_mux);
+
+    if (!running)
+        free_job(j);
+}
+
+void pmf_prerender::free_job(Job* j)
+{
+    mem_free(j->data);
+    mem_free(j->block_pcm);
+    delete j;
+}
+
+void pmf_prerender::task_entry(void* arg)
+{
+    {
+        MemScope mem_scope(MemTag::Music);    // LoopScan / pmf_player temporaires
+        run(*static_cast<Job*>(arg));
+    }
+    vTaskDelete(nullptr);
+}
+
+void pmf_prerender::run(Job& j)
+{
+    uint32_t start = 0, end = 0;
+    bool ok = find_loop(j, &start, &end);
+    if (ok) {
+        j.loop_start = start;
+        j.loop_end   = end;
+        ok = render_all(j);
+    }
+
+    if (ok)
+        printf("PMF prerender: %lu samples (loop at %lu), %s, tempo %u\n",
+               j.loop_end, j.loop_start, j.format == PMF_PRERENDER_ADPCM ? "ADPCM" : "PCM",
+               (unsigned)j.tempo);
+    else if (!j.cancel)
+        printf("PMF prerender: failed, live synthesis only\n");
+
+    // Dernière écriture de la tâche : le job appartient ensuite au lecteur,
+    // sauf s'il a été détaché entre-temps
+    portENTER_CRITICAL(&s_job_mux);
+    j.state = ok ? STATE_READY : STATE_FAILED;
+    bool detached = j.detached;
+    portEXIT_CRITICAL(&s_job_mux);
+
+    if (detached)
+        free_job(&j);
+}
+
+bool pmf_prerender::find_loop(Job& j, uint32_t* out_start, uint32_t* out_end)
+{
+    LoopScan* scan = new (std::nothrow) LoopScan();
+    pmf_player* player = new (std::nothrow) pmf_player();
+    if (!scan || !player) {
+        delete scan;
+        delete player;
+        return false;
+    }
+
+    scan->player     = player;
+    scan->last_pos   = -1;
+    player->load(j.pmf);
+    player->set_row_callback(loop_scan_row, scan);
+    player->set_tempo_scale(j.tempo);
+    player->start(j.sample_rate, j.playlist_pos);
+
+    const uint32_t max_samples = MAX_SECONDS * j.sample_rate;
+    while (!scan->found && !j.cancel && scan->offset < max_samples)
+    {
+        uint16_t n = player->samples_until_tick();
+        if (n == 0)
+            break;
+        scan->offset += n;
+        player->skip(n);
+    }
+
+    bool found = scan->found && scan->loop_end > scan->loop_start;
+    *out_start = scan->loop_start;
+    *out_end   = scan->loop_end;
+
+    delete player;
+    delete scan;
+    return found && !j.cancel;
+}
+
+bool pmf_prerender::render_all(Job& j)
+{
+    const uint32_t spb = ADPCM_BLOCK_SAMPLES;
+    uint32_t blocks = (j.loop_end + spb - 1) / spb;
+    uint32_t bytes = (j.format == PMF_PRERENDER_ADPCM)
+                   ? blocks * ADPCM_BLOCK_BYTES
+                   : j.loop_end * sizeof(int16_t);
+
+    j.data = (uint8_t*)mem_alloc(MemTag::Music, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!j.data) {
+        printf("PMF prerender: out of PSRAM (%lu bytes)\n", bytes);
+        return false;
+    }
+    if (j.format == PMF_PRERENDER_ADPCM) {
+        j.block_pcm = (int16_t*)mem_alloc(MemTag::Music, spb * sizeof(int16_t), MALLOC_CAP_8BIT);
+        if (!j.block_pcm)
+            return false;
+    }
+
+    pmf_player* player = new (std::nothrow) pmf_player();
+    if (!player)
+        return false;
+    player->load(j.pmf);
+    player->set_tempo_scale(j.tempo);
+    player->start(j.sample_rate, j.playlist_pos);
+
+    // Rendu par blocs de spb échantillons (= un bloc ADPCM)
+    int16_t chunk[ADPCM_BLOCK_SAMPLES];
+    adpcm_encoder enc;
+    uint32_t done = 0;
+    uint32_t block = 0;
+
+    while (done < j.loop_end && !j.cancel)
+    {
+        uint32_t n = j.loop_end - done;
+        if (n > spb) n = spb;
+
+        memset(chunk, 0, n * sizeof(int16_t));
+        player->mix(chunk, n);
+
+        if (j.format == PMF_PRERENDER_ADPCM)
+            adpcm_encode_block(enc, chunk, n, j.data + block * ADPCM_BLOCK_BYTES, ADPCM_BLOCK_BYTES);
+        else
+            memcpy((int16_t*)j.data + done, chunk, n * sizeof(int16_t));
+
+        done += n;
+        block++;
+    }
+
+    delete player;
+    return done == j.loop_end;
+}
+
+// Bloc ADPCM décodé (un seul bloc en cache : la lecture est séquentielle)
+const int16_t* pmf_prerender::block_samples(uint32_t block)
+{
+    if ((int32_t)block != job->cached_block) {
+        const uint32_t spb = ADPCM_BLOCK_SAMPLES;
+        adpcm_decode_block(job->data + block * ADPCM_BLOCK_BYTES, ADPCM_BLOCK_BYTES, 1,
+                           job->block_pcm, spb);
+        job->cached_block = (int32_t)block;
+    }
+    return job->block_pcm;
+}
+
+uint32_t pmf_prerender::wrap(uint64_t played) const
+{
+    if (!ready())
+        return 0;
+
+    // Intro puis boucle
+    const Job& j = *job;
+    if (played < j.loop_end)
+        return (uint32_t)played;
+    return j.loop_start + (uint32_t)((played - j.loop_start) % (j.loop_end - j.loop_start));
+}
+
+void pmf_prerender::read(int16_t* out, uint64_t played, uint32_t n)
+{
+    if (!ready() || n == 0)
+        return;
+
+    const Job& j = *job;
+    const uint32_t spb = ADPCM_BLOCK_SAMPLES;
+    const uint32_t loop_start = j.loop_start;
+    const uint32_t loop_end   = j.loop_end;
+
+    uint32_t pos = wrap(played);
+
+    while (n > 0)
+    {
+        uint32_t run = loop_end - pos;
+        if (run > n) run = n;
+
+        if (j.format == PMF_PRERENDER_ADPCM) {
+            uint32_t in_block = spb - pos % spb;
+            if (run > in_block) run = in_block;
+            memcpy(out, block_samples(pos / spb) + pos % spb, run * sizeof(int16_t));
+        } else {
+            memcpy(out, (const int16_t*)j.data + pos, run * sizeof(int16_t));
+        }
+
+        out += run;
+        n   -= run;
+        pos += run;
+        if (pos >= loop_end)
+            pos = loop_start;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// -------------------------------------------------------------
+// Pré-rendu d'une musique PMF en boucle
+// -------------------------------------------------------------
+// Une tâche de fond (basse priorité) rend la playlist une fois en
+// PCM 16 bits (ou IMA-ADPCM 4:1) en PSRAM, jusqu'au point de boucle
+// (retour sur une position de playlist déjà jouée).
+//
+// Le rendu part du même état que le lecteur live (même fichier,
+// même fréquence, même position de départ, même tempo) : à tempo
+// constant, l'échantillon N du cache est identique à l'échantillon
+// N joué en live, ce qui permet de basculer dans les deux sens sans
+// raccord audible. Un cache par tempo joué (cf. AudioPMF).
+//
+// Chaque rendu est un 'job' (paramètres + mémoire). release() ne
+// l'attend jamais : un job encore en cours est détaché, et sa
+// tâche le libère elle-même en sortant. La tâche audio n'est donc
+// jamais bloquée par le rendu (priorité 1 sur le core du jeu).
+// -------------------------------------------------------------
+
+enum pmf_prerender_format : uint8_t {
+    PMF_PRERENDER_PCM,
+    PMF_PRERENDER_ADPCM
+};
+
+class pmf_prerender {
+public:
+    static const uint32_t MAX_SECONDS = 120;   // au-delà : pas de cache
+    static const uint32_t ADPCM_BLOCK_BYTES = 256;
+    static const uint32_t ADPCM_BLOCK_SAMPLES = (ADPCM_BLOCK_BYTES - 4) * 2 + 1;
+
+    pmf_prerender();
+    ~pmf_prerender();
+
+    // Lance le rendu en tâche de fond (annule le précédent)
+    bool begin(const uint8_t* pmf, uint32_t sample_rate, uint16_t playlist_pos,
+               pmf_prerender_format format, uint16_t tempo = 256);
+
+    // Libère le cache ; un rendu en cours est annulé et détaché
+    // (sa mémoire est rendue par la tâche). Ne bloque pas.
+    void release();
+
+    bool ready() const { return job && job->state == STATE_READY; }
+
+    // Durée rendue (intro + une boucle), en échantillons ; 0 si pas prêt
+    uint32_t length() const { return ready() ? job->loop_end : 0; }
+
+    // Position 'played' ramenée dans le cache (boucle dépliée)
+    uint32_t wrap(uint64_t played) const;
+
+    // Copie n échantillons à partir de la position 'played' (en
+    // échantillons depuis le start() du lecteur live), boucle comprise.
+    void read(int16_t* out, uint64_t played, uint32_t n);
+
+private:
+    enum State : uint8_t { STATE_RENDERING, STATE_READY, STATE_FAILED };
+
+    struct Job {
+        // Paramètres du rendu
+        const uint8_t*       pmf;
+        uint32_t             sample_rate;
+        uint16_t             playlist_pos;
+        pmf_prerender_format format;
+        uint16_t             tempo;  // 8.8, cf. pmf_player::set_tempo_scale
+
+        volatile State state;
+        volatile bool  cancel;
+        bool           detached;     // release() l'a abandonné : la tâche le libère
+
+        // Données rendues (PSRAM)
+        uint8_t*  data;
+        uint32_t  loop_start;        // en échantillons
+        uint32_t  loop_end;
+
+        // ADPCM : dernier bloc décodé (côté lecture)
+        int32_t   cached_block;
+        int16_t*  block_pcm;
+    };
+
+    Job* job;
+
+    static void task_entry(void* arg);
+    static void run(Job& j);
+    static bool find_loop(Job& j, uint32_t* out_start, uint32_t* out_end);
+    static bool render_all(Job& j);
+    static void free_job(Job* j);
+    const int16_t* block_samples(uint32_t block);
+};
@@ -1,102 +1,411 @@
 #include "audio_sfx_cache.h"
-#include <vector>
-#include <string>
 #include <stdio.h>
 #include <string.h>
-#include <new>   // pour std::nothrow
+#include "core/mem_track.h"
+#include "audio_wav.h"
+#include "audio_adpcm.h"
+#include "core/audio.h"  // pour GB_AUDIO_SAMPLE_RATE
+
+// -------------------------------------------------------------
+// Configuration de la banque
+// -------------------------------------------------------------
+static const int SFX_CACHE_MAX_ENTRIES = 32;
+static const int SFX_HASH_SLOTS        = 64;   // puissance de 2, > 2 × entrées
+static const int SFX_PATH_MAX          = 64;
+
+// Liste de préchargement : l'indice dans ce tableau EST le SfxId
+static const char* const s_preload_paths[SFX_PRELOAD_COUNT] = {
+    "/sdcard/PAKAMAN/Sons/PACGOMME.wav",   // SFX_PACGOMME
+    "/sdcard/PAKAMAN/Sons/BONUS.wav",      // SFX_BONUS
+    "/sdcard/PAKAMAN/Sons/G_EATEN.wav",    // SFX_G_EATEN
+};
 
 struct CacheEntry {
-    std::string path;
-    int16_t* data;
-    uint32_t length;
+    char     path[SFX_PATH_MAX];
+    uint32_t hash;
+    int16_t* data;       // pointe dans l'arena ou sur une allocation dédiée
+    uint8_t* adpcm;      // idem, si stocké compressé (data == nullptr)
+    uint32_t adpcm_bytes;
+    uint16_t block_align;
+    uint16_t samples_per_block;
+    uint32_t length;     // en échantillons natifs
+    bool     in_arena;
 };
 
-static std::vector<CacheEntry> cache;
+static CacheEntry s_entries[SFX_CACHE_MAX_ENTRIES];
+static int        s_entry_count = 0;
 
-bool sfx_cache_load(const char* path, const int16_t** out_data, uint32_t* out_len)
+// Table de hachage : indice d'entrée + 1 (0 = slot libre)
+static uint8_t    s_hash_slots[SFX_HASH_SLOTS];
+
+// Arena unique contenant tous les SFX préchargés (PCM et ADPCM)
+static uint8_t*   s_arena = nullptr;
+static uint32_t   s_arena_bytes = 0;
+
+// Budget PCM : au-delà, les SFX ADPCM restent compressés
+static uint32_t   s_pcm_budget = SFX_PCM_BUDGET_DEFAULT;
+static uint32_t   s_pcm_used   = 0;
+
+// -------------------------------------------------------------
+// Hachage FNV-1a du chemin
+// -------------------------------------------------------------
+static uint32_t path_hash(const char* path)
+{
+    uint32_t h = 2166136261u;
+    while (*path) {
+        h ^= (uint8_t)*path++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int hash_find(const char* path, uint32_t h)
+{
+    for (int i = 0; i < SFX_HASH_SLOTS; i++) {
+        uint8_t slot = s_hash_slots[(h + i) & (SFX_HASH_SLOTS - 1)];
+        if (slot == 0)
+            return -1;
+
+        const CacheEntry& e = s_entries[slot - 1];
+        if (e.hash == h && strcmp(e.path, path) == 0)
+            return slot - 1;
+    }
+    return -1;
+}
+
+static void hash_insert(int index)
 {
-    // 1) Déjà en cache ?
-    for (auto& e : cache) {
-        if (e.path == path) {
-            if (out_data) *out_data = e.data;
-            if (out_len)  *out_len  = e.length;
-            return true;
+    uint32_t h = s_entries[index].hash;
+    for (int i = 0; i < SFX_HASH_SLOTS; i++) {
+        uint8_t& slot = s_hash_slots[(h + i) & (SFX_HASH_SLOTS - 1)];
+        if (slot == 0) {
+            slot = (uint8_t)(index + 1);
+            return;
         }
     }
+}
+
+static int add_entry(const char* path)
+{
+    if (s_entry_count >= SFX_CACHE_MAX_ENTRIES || strlen(path) >= SFX_PATH_MAX) {
+        printf("SFX cache: cannot register %s\n", path);
+        return -1;
+    }
+
+    int index = s_entry_count++;
+    CacheEntry& e = s_entries[index];
+    strcpy(e.path, path);
+    e.hash     = path_hash(path);
+    e.data     = nullptr;
+    e.adpcm    = nullptr;
+    e.adpcm_bytes = 0;
+    e.block_align = 0;
+    e.samples_per_block = 0;
+    e.length   = 0;
+    e.in_arena = false;
+    hash_insert(index);
+    return index;
+}
+
+// Les SfxId fixes occupent toujours les premières entrées
+static void init_index()
+{
+    if (s_entry_count > 0)
+        return;
+
+    for (int i = 0; i < SFX_PRELOAD_COUNT; i++)
+        add_entry(s_preload_paths[i]);
+}
+
+// -------------------------------------------------------------
+// Lecture WAV : parsing RIFF + conversion au format natif
+// (PCM 16 bits mono, GB_AUDIO_SAMPLE_RATE) une seule fois ici
+// -------------------------------------------------------------
+
+struct SfxProbe {
+    uint32_t pcm_samples;    // taille décodée (0 = fichier inutilisable)
+    uint32_t adpcm_bytes;    // > 0 si le fichier peut rester compressé
+    uint16_t block_align;
+    uint16_t samples_per_block;
+};
+
+static bool wav_probe(const char* path, SfxProbe* p)
+{
+    *p = SfxProbe{};
 
-    // 2) Ouvrir le fichier
     FILE* f = fopen(path, "rb");
     if (!f) {
         printf("SFX preload: missing file %s\n", path);
         return false;
     }
 
-    // 3) Taille du fichier
-    if (fseek(f, 0, SEEK_END) != 0) {
-        printf("SFX preload: fseek end failed %s\n", path);
+    wav_info info;
+    if (!wav_parse_header(f, &info, path)) {
+        printf("SFX preload: bad WAV %s\n", path);
         fclose(f);
         return false;
     }
+    fclose(f);
 
-    long file_size = ftell(f);
-    if (file_size < 44) {
-        printf("SFX preload: WAV too small %s\n", path);
-        fclose(f);
-        return false;
+    p->pcm_samples = wav_output_length(info, GB_AUDIO_SAMPLE_RATE);
+
+    // Lecture compressée possible : ADPCM mono, fréquence native, blocs standards
+    if (info.format == WAV_FORMAT_IMA_ADPCM &&
+        info.channels == 1 &&
+        info.sample_rate == GB_AUDIO_SAMPLE_RATE &&
+        info.samples_per_block <= ADPCM_MAX_BLOCK_SAMPLES &&
+        info.samples_per_block == adpcm_block_samples(info.block_align, 1))
+    {
+        p->adpcm_bytes       = info.data_size;
+        p->block_align       = info.block_align;
+        p->samples_per_block = info.samples_per_block;
     }
 
-    long data_size_bytes = file_size - 44;
-    uint32_t sample_count = (uint32_t)(data_size_bytes / sizeof(int16_t));
+    return p->pcm_samples > 0;
+}
 
-    if (sample_count == 0) {
-        printf("SFX preload: no PCM data %s\n", path);
+static bool wav_decode_native(const char* path, int16_t* dst, uint32_t sample_count)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    wav_info info;
+    if (!wav_parse_header(f, &info, path)) {
         fclose(f);
         return false;
     }
 
-    // 4) Allocation unique (sans exceptions)
-    int16_t* data = new (std::nothrow) int16_t[sample_count];
-    if (!data) {
-        printf("SFX preload: out of memory for %s (%lu samples)\n", path, sample_count);
-        fclose(f);
+    wav_decoder dec;
+    if (!dec.begin(f, info, GB_AUDIO_SAMPLE_RATE))   // le décodeur ferme f
         return false;
+
+    uint32_t done = 0;
+    while (done < sample_count) {
+        uint32_t n = dec.read(dst + done, sample_count - done);
+        if (n == 0)
+            break;
+        done += n;
     }
 
-    // 5) Lire les données PCM
-    if (fseek(f, 44, SEEK_SET) != 0) {
-        printf("SFX preload: fseek data failed %s\n", path);
-        fclose(f);
-        delete[] data;
+    if (done != sample_count) {
+        printf("SFX preload: truncated %s (%lu/%lu)\n", path, done, sample_count);
         return false;
     }
+    return true;
+}
 
-    size_t read_count = fread(data, sizeof(int16_t), sample_count, f);
+// Copie brute des blocs ADPCM (chunk data)
+static bool wav_read_adpcm(const char* path, uint8_t* dst, uint32_t bytes)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    wav_info info;
+    bool ok = wav_parse_header(f, &info, path) &&
+              fread(dst, 1, bytes, f) == bytes;
     fclose(f);
 
-    if (read_count != sample_count) {
-        printf("SFX preload: fread truncated %s (%zu/%lu)\n", path, read_count, sample_count);
-        delete[] data;
-        return false;
+    if (!ok)
+        printf("SFX preload: truncated %s\n", path);
+    return ok;
+}
+
+// Décide du stockage puis charge dans dst (size octets réservés)
+static bool load_entry(CacheEntry& e, const SfxProbe& p, bool compressed, uint8_t* dst)
+{
+    if (compressed) {
+        if (!wav_read_adpcm(e.path, dst, p.adpcm_bytes))
+            return false;
+
+        e.data              = nullptr;
+        e.adpcm             = dst;
+        e.adpcm_bytes       = p.adpcm_bytes;
+        e.block_align       = p.block_align;
+        e.samples_per_block = p.samples_per_block;
+        e.length            = p.pcm_samples;
+
+        printf("SFX preload: ok %s (%lu samples, ADPCM %lu bytes)\n",
+               e.path, e.length, e.adpcm_bytes);
+        return true;
     }
 
-    // 6) Ajouter au cache
-    cache.push_back({path, data, sample_count});
+    if (!wav_decode_native(e.path, (int16_t*)dst, p.pcm_samples))
+        return false;
+
+    e.data   = (int16_t*)dst;
+    e.adpcm  = nullptr;
+    e.length = p.pcm_samples;
+    s_pcm_used += p.pcm_samples * sizeof(int16_t);
+
+    printf("SFX preload: ok %s (%lu samples)\n", e.path, e.length);
+    return true;
+}
+
+static uint32_t entry_bytes(const SfxProbe& p, bool compressed)
+{
+    uint32_t n = compressed ? p.adpcm_bytes : p.pcm_samples * sizeof(int16_t);
+    return (n + 3) & ~3u;    // alignement des entrées dans l'arena
+}
+
+static uint8_t* alloc_bank(uint32_t bytes)
+{
+    uint8_t* p = (uint8_t*)mem_alloc(MemTag::Sfx, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!p)
+        p = (uint8_t*)mem_alloc(MemTag::Sfx, bytes, MALLOC_CAP_8BIT);
+    return p;
+}
+
+// Chargement hors arena (SFX non listés dans la liste de preload)
+static bool load_entry_standalone(CacheEntry& e)
+{
+    SfxProbe p;
+    if (!wav_probe(e.path, &p))
+        return false;
+
+    uint32_t pcm_bytes = p.pcm_samples * sizeof(int16_t);
+    bool compressed = p.adpcm_bytes > 0 && s_pcm_used + pcm_bytes > s_pcm_budget;
+
+    uint32_t bytes = entry_bytes(p, compressed);
+    uint8_t* data = alloc_bank(bytes);
+    if (!data) {
+        printf("SFX preload: out of memory for %s (%lu bytes)\n", e.path, bytes);
+        return false;
+    }
 
-    if (out_data) *out_data = data;
-    if (out_len)  *out_len  = sample_count;
+    if (!load_entry(e, p, compressed, data)) {
+        mem_free(data);
+        return false;
+    }
 
-    printf("SFX preload: ok %s (%lu samples)\n", path, sample_count);
+    e.in_arena = false;
     return true;
 }
 
+// -------------------------------------------------------------
+// API
+// -------------------------------------------------------------
+
+void sfx_cache_set_pcm_budget(uint32_t bytes)
+{
+    s_pcm_budget = bytes;
+}
+
 void sfx_cache_preload_all()
 {
-    const char* list[] = {
-        "/sdcard/PAKAMAN/Sons/PACGOMME.wav",
-        "/sdcard/PAKAMAN/Sons/BONUS.wav",
-        "/sdcard/PAKAMAN/Sons/G_EATEN.wav",  
-    };
+    init_index();
+
+    // Déjà fait (audio_init puis hardware_init l'appellent tous les deux)
+    if (s_arena)
+        return;
+
+    // 1) Tailles, puis choix PCM / ADPCM selon le budget
+    SfxProbe probes[SFX_PRELOAD_COUNT];
+    bool     compressed[SFX_PRELOAD_COUNT] = {};
+    uint32_t pcm_total = 0;
+
+    for (int i = 0; i < SFX_PRELOAD_COUNT; i++) {
+        probes[i] = SfxProbe{};
+        if (s_entries[i].data || s_entries[i].adpcm)
+            continue;
+
+        if (wav_probe(s_entries[i].path, &probes[i]))
+            pcm_total += probes[i].pcm_samples * sizeof(int16_t);
+    }
+
+    for (int i = 0; i < SFX_PRELOAD_COUNT && s_pcm_used + pcm_total > s_pcm_budget; i++) {
+        if (probes[i].adpcm_bytes == 0)
+            continue;
+        compressed[i] = true;
+        pcm_total -= probes[i].pcm_samples * sizeof(int16_t);
+    }
+
+    uint32_t total = 0;
+    for (int i = 0; i < SFX_PRELOAD_COUNT; i++)
+        if (probes[i].pcm_samples)
+            total += entry_bytes(probes[i], compressed[i]);
+
+    if (total == 0)
+        return;
+
+    // 2) Allocation unique (PSRAM de préférence)
+    s_arena = alloc_bank(total);
+    if (!s_arena) {
+        printf("SFX preload: out of memory for arena (%lu bytes)\n", total);
+        return;
+    }
+    s_arena_bytes = total;
 
-    for (auto path : list)
-        sfx_cache_load(path, nullptr, nullptr);
+    // 3) Lecture de chaque SFX à la suite dans l'arena
+    uint32_t offset = 0;
+    for (int i = 0; i < SFX_PRELOAD_COUNT; i++) {
+        if (probes[i].pcm_samples == 0)
+            continue;
+
+        CacheEntry& e = s_entries[i];
+        if (!load_entry(e, probes[i], compressed[i], s_arena + offset))
+            continue;
+
+        e.in_arena = true;
+        offset += entry_bytes(probes[i], compressed[i]);
+    }
+
+    printf("SFX preload: arena %lu/%lu bytes, PCM %lu/%lu bytes\n",
+           offset, s_arena_bytes, s_pcm_used, s_pcm_budget);
+}
+
+sfx_handle_t sfx_cache_register(const char* path)
+{
+    init_index();
+
+    int index = hash_find(path, path_hash(path));
+    if (index < 0)
+        index = add_entry(path);
+    if (index < 0)
+        return SFX_INVALID;
+
+    CacheEntry& e = s_entries[index];
+    if (!e.data && !e.adpcm && !load_entry_standalone(e))
+        return SFX_INVALID;
+
+    return (sfx_handle_t)index;
+}
+
+bool sfx_cache_source(sfx_handle_t id, sfx_source* out)
+{
+    if (id < 0 || id >= s_entry_count || !out)
+        return false;
+
+    const CacheEntry& e = s_entries[id];
+    if (!e.data && !e.adpcm)
+        return false;
+
+    *out = sfx_source{};
+    out->pcm               = e.data;
+    out->adpcm             = e.adpcm;
+    out->adpcm_bytes       = e.adpcm_bytes;
+    out->block_align       = e.block_align;
+    out->samples_per_block = e.samples_per_block;
+    out->length            = e.length;
+    return true;
+}
+
+bool sfx_cache_get(sfx_handle_t id, const int16_t** out_data, uint32_t* out_len)
+{
+    if (id < 0 || id >= s_entry_count)
+        return false;
+
+    const CacheEntry& e = s_entries[id];
+    if (!e.data)
+        return false;
+
+    if (out_data) *out_data = e.data;
+    if (out_len)  *out_len  = e.length;
+    return true;
+}
+
+bool sfx_cache_load(const char* path, const int16_t** out_data, uint32_t* out_len)
+{
+    return sfx_cache_get(sfx_cache_register(path), out_data, out_len);
 }
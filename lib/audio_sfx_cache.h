@@ -1,5 +1,62 @@
 #pragma once
 #include <stdint.h>
 
-bool sfx_cache_load(const char* path, const int16_t** out_data, uint32_t* out_len);
+// -------------------------------------------------------------
+// Banque de SFX préchargés
+// -------------------------------------------------------------
+// Les SFX du jeu sont identifiés par un handle entier. Le chemin
+// n'est haché qu'une seule fois (au préchargement ou au premier
+// sfx_cache_register) ; les déclencheurs utilisent ensuite
+// sfx_cache_get(id) qui est un simple accès indexé.
+//
+// sfx_cache_preload_all() regroupe tout le PCM préchargé dans
+// une seule allocation (arena, en PSRAM si disponible).
+//
+// Les WAV IMA-ADPCM (mono, fréquence native) sont décodés en PCM
+// tant que le budget PCM le permet ; au-delà ils restent compressés
+// (4:1) et sont décodés bloc par bloc pendant la lecture.
+// -------------------------------------------------------------
+
+typedef int16_t sfx_handle_t;
+
+static const sfx_handle_t SFX_INVALID = -1;
+
+// Identifiants fixes des SFX préchargés (ordre = liste de preload)
+enum SfxId : sfx_handle_t {
+    SFX_PACGOMME = 0,
+    SFX_BONUS,
+    SFX_G_EATEN,
+    SFX_PRELOAD_COUNT
+};
+
+// Budget PCM par défaut de la banque (octets)
+static const uint32_t SFX_PCM_BUDGET_DEFAULT = 256 * 1024;
+
+// Données d'un SFX : PCM natif, ou blocs IMA-ADPCM mono
+struct sfx_source {
+    const int16_t* pcm = nullptr;
+    const uint8_t* adpcm = nullptr;
+    uint32_t adpcm_bytes = 0;
+    uint16_t block_align = 0;
+    uint16_t samples_per_block = 0;
+    uint32_t length = 0;            // en échantillons natifs
+};
+
+// Budget PCM (à régler avant sfx_cache_preload_all)
+void sfx_cache_set_pcm_budget(uint32_t bytes);
+
+// Précharge la liste des SFX du jeu dans l'arena (idempotent)
 void sfx_cache_preload_all();
+
+// Retourne le handle d'un fichier (charge le fichier si besoin).
+// À appeler hors du chemin critique : hachage du chemin.
+sfx_handle_t sfx_cache_register(const char* path);
+
+// Accès O(1) aux données d'un SFX déjà chargé (PCM ou ADPCM)
+bool sfx_cache_source(sfx_handle_t id, sfx_source* out);
+
+// Accès O(1) au PCM d'un SFX déjà chargé (false si stocké compressé)
+bool sfx_cache_get(sfx_handle_t id, const int16_t** out_data, uint32_t* out_len);
+
+// Compatibilité : recherche par chemin (hachée) puis accès par handle
+bool sfx_cache_load(const char* path, const int16_t** out_data, uint32_t* out_len);
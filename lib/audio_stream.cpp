@@ -0,0 +1,160 @@
+#include "audio_stream.h"
+#include "core/audio.h"  // pour GB_AUDIO_SAMPLE_RATE
+
+audio_wav_stream::audio_wav_stream()
+{
+    write_index = 0;
+    read_index  = 0;
+    current_gen = 0;
+    holding     = false;
+    primed_gen  = 0;
+    starved     = false;
+    underruns   = 0;
+    task        = nullptr;
+    commands    = nullptr;
+}
+
+bool audio_wav_stream::start_task(UBaseType_t priority, int core)
+{
+    if (task)
+        return true;
+
+    commands = xQueueCreate(4, sizeof(Command));
+    if (!commands)
+        return false;
+
+    if (xTaskCreatePinnedToCore(task_entry, "wav_stream", 4096, this,
+                                priority, &task, core) != pdPASS) {
+        task = nullptr;
+        printf("audio_stream: task creation failed\n");
+        return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------
+// Côté jeu
+// -------------------------------------------------------------
+bool audio_wav_stream::open(FILE* f, const wav_info& info)
+{
+    if (!task) {
+        fclose(f);
+        return false;
+    }
+
+    Command cmd;
+    cmd.file = f;
+    cmd.info = info;
+    cmd.gen  = current_gen + 1;
+
+    // Les blocs de l'ancien flux sont ignorés dès maintenant
+    current_gen = cmd.gen;
+
+    if (xQueueSend(commands, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
+        printf("audio_stream: file de commandes pleine\n");
+        fclose(f);
+        return false;
+    }
+    xTaskNotifyGive(task);
+    return true;
+}
+
+// -------------------------------------------------------------
+// Côté mixeur (jamais bloquant)
+// -------------------------------------------------------------
+const int16_t* audio_wav_stream::acquire(uint32_t* out_len, bool* eof)
+{
+    *out_len = 0;
+    *eof = false;
+
+    // Blocs d'un flux précédent : rendus directement à la tâche
+    while (read_index != write_index &&
+           blocks[read_index % BLOCK_COUNT].gen != current_gen) {
+        read_index = read_index + 1;
+        if (task) xTaskNotifyGive(task);
+    }
+
+    if (read_index == write_index) {
+        // Premier bloc pas encore lu (ouverture du fichier) : attente normale
+        if (primed_gen == current_gen && !starved) {
+            starved = true;
+            underruns++;
+        }
+        return nullptr;
+    }
+
+    Block& b = blocks[read_index % BLOCK_COUNT];
+    holding = true;
+    primed_gen = b.gen;
+    starved = false;
+    *out_len = b.len;
+    *eof = b.eof;
+    return b.data;
+}
+
+void audio_wav_stream::release()
+{
+    if (!holding)
+        return;
+
+    holding = false;
+    read_index = read_index + 1;
+    if (task)
+        xTaskNotifyGive(task);
+}
+
+// -------------------------------------------------------------
+// Tâche de lecture
+// -------------------------------------------------------------
+void audio_wav_stream::task_entry(void* arg)
+{
+    static_cast<audio_wav_stream*>(arg)->run();
+}
+
+void audio_wav_stream::run()
+{
+    wav_decoder decoder;
+    uint32_t gen = 0;
+    bool streaming = false;
+
+    for (;;)
+    {
+        // Rien à faire : on dort jusqu'à une commande ou un bloc libéré
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        Command cmd;
+        while (xQueueReceive(commands, &cmd, 0) == pdTRUE) {
+            decoder.close();
+            gen = cmd.gen;
+            // begin() ferme le fichier lui-même en cas d'échec
+            streaming = decoder.begin(cmd.file, cmd.info, GB_AUDIO_SAMPLE_RATE);
+        }
+
+        // Read-ahead : remplir tous les blocs libres
+        while (streaming && write_index - read_index < BLOCK_COUNT)
+        {
+            // Une nouvelle commande est prioritaire sur la suite du flux
+            if (uxQueueMessagesWaiting(commands) > 0) {
+                xTaskNotifyGive(task);
+                break;
+            }
+
+            Block& b = blocks[write_index % BLOCK_COUNT];
+            b.len = 0;
+            while (b.len < BLOCK_SAMPLES) {
+                uint32_t n = decoder.read(b.data + b.len, BLOCK_SAMPLES - b.len);
+                if (n == 0)
+                    break;
+                b.len += n;
+            }
+            b.gen = gen;
+            b.eof = (b.len < BLOCK_SAMPLES) || !decoder.is_open();
+            if (b.eof) {
+                decoder.close();
+                streaming = false;
+            }
+
+            write_index = write_index + 1;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <stdint.h>
+#include <cstdio>   // pour FILE*
+#include "audio_wav.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+// -------------------------------------------------------------
+// Lecture WAV en tâche de fond (prefetch SD)
+// -------------------------------------------------------------
+// Une tâche dédiée lit et décode le fichier (fread FAT + conversion
+// wav_decoder) dans un anneau de blocs PCM natifs. Le mixeur ne fait
+// que consommer des blocs déjà remplis : une latence de la carte SD
+// ne bloque jamais audio_update().
+//
+// Un seul producteur (la tâche) et un seul consommateur (le mixeur) :
+// les index de l'anneau ne sont écrits que par leur propriétaire.
+// -------------------------------------------------------------
+
+class audio_wav_stream {
+public:
+    static const uint32_t BLOCK_SAMPLES = 4096;   // 8 Ko par bloc (~186 ms)
+    static const uint32_t BLOCK_COUNT   = 2;      // double buffer
+
+    audio_wav_stream();
+
+    // Crée la tâche de lecture (une seule fois, à l'init audio)
+    bool start_task(UBaseType_t priority, int core);
+
+    // Côté jeu : lance la lecture. open() prend possession de f, même
+    // en cas d'échec (false : file de commandes pleine ou pas de tâche).
+    bool open(FILE* f, const wav_info& info);
+
+    // Côté mixeur : bloc prêt (nullptr si rien n'est disponible).
+    // *eof passe à true quand le flux courant est terminé.
+    const int16_t* acquire(uint32_t* out_len, bool* eof);
+    void release();
+
+    // Anneau vide alors que le flux avait déjà commencé (SD en retard).
+    // L'attente du premier bloc d'un flux n'est pas comptée, et un trou
+    // n'est compté qu'une fois jusqu'au bloc suivant.
+    uint32_t underrun_count() const { return underruns; }
+
+private:
+    struct Block {
+        int16_t  data[BLOCK_SAMPLES];
+        uint32_t len;
+        uint32_t gen;       // flux auquel appartient le bloc
+        bool     eof;
+    };
+
+    struct Command {
+        FILE*    file;
+        wav_info info;
+        uint32_t gen;
+    };
+
+    Block    blocks[BLOCK_COUNT];
+    volatile uint32_t write_index;   // écrit par la tâche
+    volatile uint32_t read_index;    // écrit par le mixeur
+    volatile uint32_t current_gen;   // flux attendu par le mixeur
+    bool     holding;                // le mixeur lit blocks[read_index]
+    uint32_t primed_gen;             // dernier flux dont un bloc a été servi
+    bool     starved;                // trou en cours, déjà compté
+    uint32_t underruns;
+
+    TaskHandle_t  task;
+    QueueHandle_t commands;
+
+    static void task_entry(void* arg);
+    void run();
+};
@@ -1,17 +1,46 @@
 #include "audio_track_sfx.h"
-#include <algorithm>
+#include "core/audio.h"  // pour GB_AUDIO_SAMPLE_RATE
+
+// Limites par défaut : le waka-waka ne peut jamais occuper plus de
+// 2 voix, même en mangeant une rangée de pac-gommes
+static const SfxCategoryConfig SFX_CATEGORY_DEFAULTS[SFX_CAT_COUNT] = {
+    { 2, SFX_STEAL_OLDEST,   60 },   // SFX_CAT_PELLET
+    { 3, SFX_STEAL_QUIETEST, 30 },   // SFX_CAT_GHOST
+    { 2, SFX_STEAL_OLDEST,   20 },   // SFX_CAT_UI
+    { 2, SFX_STEAL_OLDEST,    0 },   // SFX_CAT_JINGLE
+};
 
 audio_track_sfx::audio_track_sfx()
 {
     for (int i = 0; i < MAX_SFX; i++) {
         sfx[i].active = false;
         sfx[i].data = nullptr;
+        sfx[i].adpcm = nullptr;
+        sfx[i].block_len = 0;
         sfx[i].length = 0;
         sfx[i].pos = 0.0f;
         sfx[i].pitch = 1.0f;
         sfx[i].volume = 1.0f;
         sfx[i].priority = 0;
+        sfx[i].category = SFX_CAT_UI;
+        sfx[i].key = nullptr;
+        sfx[i].seq = 0;
     }
+
+    for (int c = 0; c < SFX_CAT_COUNT; c++)
+        categories[c] = SFX_CATEGORY_DEFAULTS[c];
+
+    next_seq = 0;
+    coalesced = stolen = dropped = 0;
+}
+
+void audio_track_sfx::set_category_config(SfxCategory category, const SfxCategoryConfig& cfg)
+{
+    if (category >= SFX_CAT_COUNT)
+        return;
+    categories[category] = cfg;
+    if (categories[category].max_voices > MAX_SFX)
+        categories[category].max_voices = MAX_SFX;
 }
 
 
@@ -20,29 +49,161 @@ void audio_track_sfx::play(const int16_t* data,
                            int priority,
                            float volume,
                            float pitch)
+{
+    sfx_source src;
+    src.pcm = data;
+    src.length = length;
+    play(src, priority, volume, pitch);
+}
+
+// Voix à couper pour faire de la place : jamais une voix plus prioritaire,
+// d'abord la moins prioritaire, puis selon la politique (plus ancienne ou
+// plus faible). category < 0 : toutes les voix sont candidates.
+int audio_track_sfx::pick_victim(int priority, int category, SfxStealPolicy steal) const
 {
     int best = -1;
-	if (data == nullptr || length == 0)
-		return;
+    for (int i = 0; i < MAX_SFX; i++)
+    {
+        const SFXInstance& v = sfx[i];
+        if (!v.active || v.priority > priority)
+            continue;
+        if (category >= 0 && v.category != category)
+            continue;
 
-    for (int i = 0; i < MAX_SFX; i++) {
-        if (!sfx[i].active) {
+        if (best < 0) {
             best = i;
-            break;
+            continue;
         }
-        if (priority > sfx[i].priority)
+
+        const SFXInstance& b = sfx[best];
+        if (v.priority != b.priority) {
+            if (v.priority < b.priority)
+                best = i;
+            continue;
+        }
+
+        if (steal == SFX_STEAL_QUIETEST && v.volume != b.volume) {
+            if (v.volume < b.volume)
+                best = i;
+            continue;
+        }
+
+        if ((int32_t)(v.seq - b.seq) < 0)   // plus ancienne
             best = i;
     }
+    return best;
+}
+
+void audio_track_sfx::play(const sfx_source& src,
+                           int priority,
+                           float volume,
+                           float pitch,
+                           SfxCategory category)
+{
+	if ((src.pcm == nullptr && src.adpcm == nullptr) || src.length == 0)
+		return;
+    if (category >= SFX_CAT_COUNT)
+        category = SFX_CAT_UI;
+
+    const SfxCategoryConfig& cfg = categories[category];
+    const void* key = src.pcm ? (const void*)src.pcm : (const void*)src.adpcm;
+    const float window = (float)cfg.coalesce_ms * GB_AUDIO_SAMPLE_RATE / 1000.0f;
+
+    // 1) Regroupement : même SFX relancé dans la fenêtre → on garde la voix
+    //    en cours (au volume le plus fort des deux)
+    int in_category = 0;
+    int free_slot = -1;
+    for (int i = 0; i < MAX_SFX; i++)
+    {
+        SFXInstance& v = sfx[i];
+        if (!v.active) {
+            if (free_slot < 0)
+                free_slot = i;
+            continue;
+        }
+        if (v.category != category)
+            continue;
+        in_category++;
+
+        if (v.key == key && v.pitch > 0.0f && v.pos / v.pitch < window) {
+            if (volume > v.volume)
+                v.volume = volume;
+            coalesced++;
+            return;
+        }
+    }
+
+    // 2) Choix de la voix : plafond de la catégorie, puis place libre, puis vol
+    int slot;
+    if (in_category >= cfg.max_voices)
+        slot = cfg.max_voices ? pick_victim(priority, category, cfg.steal) : -1;
+    else if (free_slot >= 0)
+        slot = free_slot;
+    else
+        slot = pick_victim(priority, -1, cfg.steal);
+
+    if (slot < 0) {
+        dropped++;
+        return;
+    }
+    if (sfx[slot].active)
+        stolen++;
+
+    // La voix est coupée pendant sa réécriture (le mixeur tourne sur une autre tâche)
+    SFXInstance& v = sfx[slot];
+    v.active = false;
+    v.data = src.pcm;
+    v.length = src.length;
+    v.adpcm = src.pcm ? nullptr : src.adpcm;
+    v.adpcm_bytes = src.adpcm_bytes;
+    v.block_align = src.block_align;
+    v.samples_per_block = src.samples_per_block;
+    v.block_first = 0;
+    v.cursor = adpcm_cursor();
+    v.block_start = 0;
+    v.block_len = 0;
+    v.pos = 0.0f;
+    v.pitch = pitch;
+    v.volume = volume;
+    v.priority = priority;
+    v.category = category;
+    v.key = key;
+    v.seq = next_seq++;
+    v.active = true;
+}
 
-    if (best < 0) return;
+// Échantillon idx d'un SFX ADPCM : décode la fenêtre correspondante si besoin.
+// La lecture avance (pitch > 0) : on poursuit le décodage du bloc là où il
+// s'est arrêté, et on ne repart de l'entête qu'en changeant de bloc.
+static int16_t adpcm_sample(SFXInstance& s, uint32_t idx)
+{
+    if (idx - s.block_start >= s.block_len)
+    {
+        uint32_t block = idx / s.samples_per_block;
+        uint32_t offset = block * s.block_align;
+        if (offset >= s.adpcm_bytes)
+            return 0;
+        uint32_t bytes = s.adpcm_bytes - offset;
+        if (bytes > s.block_align)
+            bytes = s.block_align;
 
-    sfx[best].data = data;
-    sfx[best].length = length;
-    sfx[best].pos = 0.0f;
-    sfx[best].pitch = pitch;
-    sfx[best].volume = volume;
-    sfx[best].priority = priority;
-    sfx[best].active = true;
+        uint32_t first = block * s.samples_per_block;
+        if (first != s.block_first || idx < s.block_start) {
+            s.block_first = first;
+            s.cursor = adpcm_cursor();
+        }
+
+        // Un pitch élevé peut sauter une fenêtre entière : elle est décodée quand même
+        do {
+            s.block_start = s.block_first + s.cursor.sample;
+            s.block_len = adpcm_decode_next(s.adpcm + offset, bytes, s.cursor,
+                                            s.window, SFX_ADPCM_WINDOW);
+            if (s.block_len == 0)
+                return 0;
+        } while (idx - s.block_start >= s.block_len);
+    }
+
+    return s.window[idx - s.block_start];
 }
 
 bool audio_track_sfx::no_high_priority_active() const
@@ -61,6 +222,15 @@ bool audio_track_sfx::is_active() const
     return false;
 }
 
+int audio_track_sfx::active_count() const
+{
+    int n = 0;
+    for (int i = 0; i < MAX_SFX; i++)
+        if (sfx[i].active)
+            n++;
+    return n;
+}
+
 int16_t audio_track_sfx::next_sample()
 {
     int32_t mix = 0;
@@ -68,7 +238,7 @@ int16_t audio_track_sfx::next_sample()
     for (int c = 0; c < MAX_SFX; c++) {
 
         // Sécurité absolue
-        if (!sfx[c].active || sfx[c].data == nullptr)
+        if (!sfx[c].active || (sfx[c].data == nullptr && sfx[c].adpcm == nullptr))
             continue;
 
         int idx = (int)sfx[c].pos;
@@ -79,7 +249,7 @@ int16_t audio_track_sfx::next_sample()
             continue;
         }
 
-        int32_t s = sfx[c].data[idx];
+        int32_t s = sfx[c].data ? sfx[c].data[idx] : adpcm_sample(sfx[c], (uint32_t)idx);
         s = (int32_t)(s * sfx[c].volume);
         mix += s;
 
@@ -1,16 +1,62 @@
 #pragma once
 #include <stdint.h>
 #include "audio_player.h"
+#include "audio_adpcm.h"
+#include "audio_sfx_cache.h"
+
+// -------------------------------------------------------------
+// Catégories de SFX (ordonnanceur de voix)
+// -------------------------------------------------------------
+// Chaque catégorie a un nombre maximal de voix simultanées, une
+// politique de vol de voix et une fenêtre de regroupement : un même
+// SFX redéclenché moins de coalesce_ms après le précédent ne crée
+// pas de nouvelle voix (la voix en cours est conservée).
+enum SfxCategory : uint8_t {
+    SFX_CAT_PELLET = 0,     // waka-waka, fruits
+    SFX_CAT_GHOST,          // fantômes mangés, sirènes
+    SFX_CAT_UI,             // menus
+    SFX_CAT_JINGLE,         // power pellet, jingles
+    SFX_CAT_COUNT
+};
+
+enum SfxStealPolicy : uint8_t {
+    SFX_STEAL_OLDEST = 0,   // la voix la plus avancée est coupée
+    SFX_STEAL_QUIETEST      // la voix la plus faible est coupée
+};
+
+struct SfxCategoryConfig {
+    uint8_t        max_voices;
+    SfxStealPolicy steal;
+    uint16_t       coalesce_ms;
+};
+
+// Fenêtre de décodage ADPCM par voix (échantillons). Le bloc est
+// décodé séquentiellement par fenêtres : pas de bloc entier en .bss.
+static const uint32_t SFX_ADPCM_WINDOW = 64;
 
 struct SFXInstance {
     const int16_t* data = nullptr;
     uint32_t length = 0;
 
+    // SFX stocké en IMA-ADPCM (data == nullptr) : une fenêtre décodée en cache
+    const uint8_t* adpcm = nullptr;
+    uint32_t adpcm_bytes = 0;
+    uint16_t block_align = 0;
+    uint16_t samples_per_block = 0;
+    uint32_t block_first = 0;      // premier échantillon du bloc en cours
+    adpcm_cursor cursor;           // état du décodeur dans ce bloc
+    uint32_t block_start = 0;      // premier échantillon de la fenêtre
+    uint32_t block_len = 0;        // 0 = aucune fenêtre décodée
+    int16_t  window[SFX_ADPCM_WINDOW];
+
     float pos = 0.0f;      // position flottante pour pitch
     float pitch = 1.0f;    // 1.0 = normal
 
     float volume = 1.0f;   // 0.0–1.0 relatif à track.volume
     int priority = 0;
+    uint8_t category = SFX_CAT_UI;
+    const void* key = nullptr;     // identité du SFX (regroupement)
+    uint32_t seq = 0;              // ordre de déclenchement (âge)
     bool active = false;
 };
 
@@ -25,6 +71,21 @@ public:
               float volume,
               float pitch);
 
+    // Lance un SFX de la banque (PCM ou ADPCM décodé à la volée)
+    void play(const sfx_source& src,
+              int priority,
+              float volume,
+              float pitch,
+              SfxCategory category = SFX_CAT_UI);
+
+    // Limites d'une catégorie (max_voices borné à MAX_SFX, 0 = catégorie muette)
+    void set_category_config(SfxCategory category, const SfxCategoryConfig& cfg);
+
+    // Statistiques de l'ordonnanceur depuis le démarrage
+    uint32_t coalesced_count() const { return coalesced; }
+    uint32_t stolen_count() const { return stolen; }
+    uint32_t dropped_count() const { return dropped; }
+
     // audio_track_base
     int16_t next_sample() override;
     bool is_active() const override;
@@ -32,7 +93,18 @@ public:
     // Pour l’auto-ducking
     bool no_high_priority_active() const;
 
+    // Nombre de voix actives (statistiques)
+    int active_count() const;
+
 private:
     static const int MAX_SFX = 8;
     SFXInstance sfx[MAX_SFX];
+
+    SfxCategoryConfig categories[SFX_CAT_COUNT];
+    uint32_t next_seq;
+    uint32_t coalesced;
+    uint32_t stolen;
+    uint32_t dropped;
+
+    int pick_victim(int priority, int category, SfxStealPolicy steal) const;
 };
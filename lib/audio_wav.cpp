@@ -0,0 +1,371 @@
+#include "audio_wav.h"
+#include "audio_adpcm.h"
+#include "core/mem_track.h"
+#include <stdlib.h>
+#include <string.h>
+
+// -------------------------------------------------------------
+// Helpers little-endian (indépendants de l'alignement)
+// -------------------------------------------------------------
+static inline uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+static const char* log_name(const char* path) { return path ? path : "(wav)"; }
+
+// -------------------------------------------------------------
+// Parsing RIFF
+// -------------------------------------------------------------
+bool wav_parse_header(FILE* f, wav_info* info, const char* path)
+{
+    if (!f || !info)
+        return false;
+
+    *info = wav_info{};
+
+    // Taille réelle du fichier (data_size peut être faux sur certains outils)
+    if (fseek(f, 0, SEEK_END) != 0) return false;
+    long file_size = ftell(f);
+    if (fseek(f, 0, SEEK_SET) != 0) return false;
+
+    uint8_t hdr[12];
+    if (fread(hdr, 1, 12, f) != 12 ||
+        memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0) {
+        printf("WAV: %s n'est pas un fichier RIFF/WAVE\n", log_name(path));
+        return false;
+    }
+
+    bool have_fmt = false;
+    uint32_t fact_samples = 0;
+    long pos = 12;
+
+    while (pos + 8 <= file_size)
+    {
+        uint8_t ck[8];
+        if (fread(ck, 1, 8, f) != 8)
+            break;
+
+        uint32_t ck_size = rd32(ck + 4);
+        long     ck_data = pos + 8;
+
+        if (memcmp(ck, "fmt ", 4) == 0)
+        {
+            uint8_t fmt[40] = {};
+            uint32_t n = ck_size < sizeof(fmt) ? ck_size : sizeof(fmt);
+            if (n < 16 || fread(fmt, 1, n, f) != n) {
+                printf("WAV: chunk fmt invalide (%s)\n", log_name(path));
+                return false;
+            }
+
+            info->format          = rd16(fmt + 0);
+            info->channels        = rd16(fmt + 2);
+            info->sample_rate     = rd32(fmt + 4);
+            info->block_align     = rd16(fmt + 12);
+            info->bits_per_sample = rd16(fmt + 14);
+
+            // WAVE_FORMAT_EXTENSIBLE : le vrai format est dans le SubFormat GUID
+            if (info->format == WAV_FORMAT_EXTENSIBLE && n >= 26)
+                info->format = rd16(fmt + 24);
+
+            // IMA-ADPCM : cbSize puis wSamplesPerBlock
+            if (info->format == WAV_FORMAT_IMA_ADPCM && n >= 20)
+                info->samples_per_block = rd16(fmt + 18);
+
+            have_fmt = true;
+        }
+        else if (memcmp(ck, "fact", 4) == 0 && ck_size >= 4)
+        {
+            // Nombre exact d'échantillons (formats compressés)
+            uint8_t fact[4];
+            if (fread(fact, 1, 4, f) == 4)
+                fact_samples = rd32(fact);
+        }
+        else if (memcmp(ck, "data", 4) == 0)
+        {
+            if (!have_fmt) {
+                printf("WAV: chunk data avant fmt (%s)\n", log_name(path));
+                return false;
+            }
+
+            info->data_offset = (uint32_t)ck_data;
+            info->data_size   = ck_size;
+            if ((long)info->data_size > file_size - ck_data)
+                info->data_size = (uint32_t)(file_size - ck_data);
+            break;
+        }
+        // LIST, cue, smpl... : ignorés
+
+        // Chunks alignés sur 2 octets
+        pos = ck_data + ck_size + (ck_size & 1);
+        if (fseek(f, pos, SEEK_SET) != 0)
+            return false;
+    }
+
+    if (!info->data_offset) {
+        printf("WAV: pas de chunk data (%s)\n", log_name(path));
+        return false;
+    }
+
+    if (info->channels == 0 || info->channels > 8 || info->sample_rate == 0) {
+        printf("WAV: canaux/fréquence invalides (%s)\n", log_name(path));
+        return false;
+    }
+
+    // Formats acceptés
+    if (info->format == WAV_FORMAT_IMA_ADPCM)
+    {
+        if (info->bits_per_sample != 4 || info->block_align < 4 * info->channels) {
+            printf("WAV: ADPCM invalide (%s)\n", log_name(path));
+            return false;
+        }
+
+        uint32_t spb = adpcm_block_samples(info->block_align, info->channels);
+        if (info->samples_per_block == 0 || info->samples_per_block > spb)
+            info->samples_per_block = (uint16_t)spb;
+
+        // Blocs complets + dernier bloc éventuellement tronqué
+        uint32_t blocks = info->data_size / info->block_align;
+        uint32_t rest   = info->data_size % info->block_align;
+        info->frame_count = blocks * info->samples_per_block +
+                            adpcm_block_samples(rest, info->channels);
+
+        if (fact_samples && fact_samples < info->frame_count)
+            info->frame_count = fact_samples;
+    }
+    else if (info->format == WAV_FORMAT_PCM)
+    {
+        if (info->bits_per_sample != 8 && info->bits_per_sample != 16 && info->bits_per_sample != 24) {
+            printf("WAV: %u bits non supporté (%s)\n", (unsigned)info->bits_per_sample, log_name(path));
+            return false;
+        }
+
+        uint16_t min_align = info->channels * (info->bits_per_sample / 8);
+        if (info->block_align < min_align)
+            info->block_align = min_align;
+
+        info->frame_count = info->data_size / info->block_align;
+    }
+    else
+    {
+        printf("WAV: format %u non supporté (%s)\n", (unsigned)info->format, log_name(path));
+        return false;
+    }
+
+    if (fseek(f, info->data_offset, SEEK_SET) != 0)
+        return false;
+
+    return info->frame_count > 0;
+}
+
+static uint32_t resample_step(uint32_t in_rate, uint32_t out_rate)
+{
+    return (uint32_t)(((uint64_t)in_rate << 16) / out_rate);
+}
+
+uint32_t wav_output_length(const wav_info& info, uint32_t out_rate)
+{
+    if (info.frame_count == 0 || out_rate == 0)
+        return 0;
+
+    if (info.sample_rate == out_rate)
+        return info.frame_count;
+
+    // Sorties k telles que k*step <= (frames-1) en 16.16
+    uint32_t step = resample_step(info.sample_rate, out_rate);
+    return (uint32_t)((((uint64_t)(info.frame_count - 1)) << 16) / step) + 1;
+}
+
+// -------------------------------------------------------------
+// wav_decoder
+// -------------------------------------------------------------
+wav_decoder::wav_decoder()
+{
+    file = nullptr;
+    frames_left = 0;
+    out_length = 0;
+    passthrough = false;
+    step = 0x10000;
+    out_pos = 0;
+    in_count = 0;
+    prev = cur = 0;
+    raw_len = raw_pos = 0;
+    adpcm_raw = nullptr;
+    adpcm_pcm = nullptr;
+    adpcm_len = adpcm_pos = 0;
+}
+
+wav_decoder::~wav_decoder()
+{
+    close();
+}
+
+bool wav_decoder::begin(FILE* f, const wav_info& inf, uint32_t out_rate)
+{
+    close();
+
+    if (!f)
+        return false;
+    if (inf.frame_count == 0 || out_rate == 0) {
+        fclose(f);
+        return false;
+    }
+
+    file        = f;
+    info        = inf;
+    frames_left = inf.frame_count;
+    out_length  = wav_output_length(inf, out_rate);
+    passthrough = (inf.channels == 1 && inf.bits_per_sample == 16 &&
+                   inf.block_align == 2 && inf.sample_rate == out_rate);
+
+    step     = resample_step(inf.sample_rate, out_rate);
+    out_pos  = 0;
+    in_count = 0;
+    prev = cur = 0;
+    raw_len = raw_pos = 0;
+
+    if (inf.format == WAV_FORMAT_IMA_ADPCM)
+    {
+        adpcm_raw = (uint8_t*)mem_alloc(MemTag::Audio, inf.block_align, MALLOC_CAP_8BIT);
+        adpcm_pcm = (int16_t*)mem_alloc(MemTag::Audio, inf.samples_per_block * sizeof(int16_t), MALLOC_CAP_8BIT);
+        adpcm_len = adpcm_pos = 0;
+        if (!adpcm_raw || !adpcm_pcm) {
+            printf("WAV: mémoire insuffisante pour le décodeur ADPCM\n");
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void wav_decoder::close()
+{
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    frames_left = 0;
+
+    mem_free(adpcm_raw);
+    mem_free(adpcm_pcm);
+    adpcm_raw = nullptr;
+    adpcm_pcm = nullptr;
+    adpcm_len = adpcm_pos = 0;
+}
+
+// ADPCM : décode un bloc entier puis le sert échantillon par échantillon
+bool wav_decoder::next_adpcm_frame(int16_t& s)
+{
+    if (adpcm_pos >= adpcm_len)
+    {
+        if (!file || frames_left == 0)
+            return false;
+
+        size_t n = fread(adpcm_raw, 1, info.block_align, file);
+        adpcm_len = adpcm_decode_block(adpcm_raw, (uint32_t)n, info.channels,
+                                       adpcm_pcm, info.samples_per_block);
+        adpcm_pos = 0;
+
+        if (adpcm_len > frames_left)
+            adpcm_len = frames_left;
+        frames_left -= adpcm_len;
+
+        if (adpcm_len == 0) {
+            frames_left = 0;
+            return false;
+        }
+    }
+
+    s = adpcm_pcm[adpcm_pos++];
+    return true;
+}
+
+// Lit une frame et la convertit en un échantillon mono 16 bits
+bool wav_decoder::next_frame(int16_t& s)
+{
+    if (info.format == WAV_FORMAT_IMA_ADPCM)
+        return next_adpcm_frame(s);
+
+    if (raw_pos >= raw_len)
+    {
+        if (!file || frames_left == 0)
+            return false;
+
+        uint32_t frames = RAW_BYTES / info.block_align;
+        if (frames > frames_left)
+            frames = frames_left;
+
+        size_t n = fread(raw, info.block_align, frames, file);
+        if (n == 0) {
+            frames_left = 0;
+            return false;
+        }
+
+        frames_left -= (uint32_t)n;
+        raw_len = (uint32_t)n * info.block_align;
+        raw_pos = 0;
+    }
+
+    const uint8_t* p = raw + raw_pos;
+    raw_pos += info.block_align;
+
+    int32_t acc = 0;
+    for (int c = 0; c < info.channels; c++)
+    {
+        switch (info.bits_per_sample)
+        {
+            case 8:  acc += ((int32_t)p[0] - 128) << 8;                  p += 1; break;
+            case 16: acc += (int16_t)rd16(p);                            p += 2; break;
+            default: acc += (int16_t)((p[1] | (p[2] << 8)));             p += 3; break; // 24 bits : 16 MSB
+        }
+    }
+
+    s = (int16_t)(acc / info.channels);
+    return true;
+}
+
+uint32_t wav_decoder::read(int16_t* dst, uint32_t max_samples)
+{
+    if (!dst || max_samples == 0)
+        return 0;
+
+    uint32_t produced = 0;
+
+    // Format natif : copie directe
+    if (passthrough)
+    {
+        if (!file)
+            return 0;
+
+        uint32_t to_read = max_samples < frames_left ? max_samples : frames_left;
+        produced = (uint32_t)fread(dst, sizeof(int16_t), to_read, file);
+        frames_left -= produced;
+        if (produced == 0 || frames_left == 0)
+            close();
+        return produced;
+    }
+
+    // Conversion + rééchantillonnage linéaire
+    while (produced < max_samples)
+    {
+        // Un échantillon de sortie tombe entre prev (in_count-2) et cur (in_count-1)
+        if (in_count > 0 && out_pos <= ((in_count - 1) << 16))
+        {
+            int32_t frac = (int32_t)(out_pos - ((in_count - 2) << 16));
+            dst[produced++] = (int16_t)(prev + (int32_t)(((int64_t)(cur - prev) * frac) >> 16));
+            out_pos += step;
+            continue;
+        }
+
+        int16_t s;
+        if (!next_frame(s))
+            break;
+
+        prev = (in_count == 0) ? s : cur;
+        cur  = s;
+        in_count++;
+    }
+
+    if (produced == 0)
+        close();
+
+    return produced;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+#include <cstdio>   // pour FILE*
+
+// -------------------------------------------------------------
+// Lecture de fichiers WAV (RIFF)
+// -------------------------------------------------------------
+// wav_parse_header() parcourt les chunks RIFF un par un (fmt, data,
+// LIST, fact, ... : les chunks inconnus sont ignorés) au lieu de
+// supposer un entête fixe de 44 octets.
+//
+// wav_decoder convertit ensuite le flux vers le format natif du
+// moteur (PCM 16 bits mono à la fréquence demandée) : 8/16/24 bits,
+// mono/stéréo et toute fréquence d'échantillonnage sont acceptés,
+// ainsi que l'IMA-ADPCM (décodé bloc par bloc, cf. audio_adpcm.h).
+// La conversion se fait par blocs (préchargement ou remplissage du
+// buffer de streaming), jamais dans le mixage échantillon par
+// échantillon.
+// -------------------------------------------------------------
+
+enum : uint16_t {
+    WAV_FORMAT_PCM        = 0x0001,
+    WAV_FORMAT_IMA_ADPCM  = 0x0011,
+    WAV_FORMAT_EXTENSIBLE = 0xFFFE
+};
+
+struct wav_info {
+    uint16_t format          = 0;   // WAV_FORMAT_*
+    uint16_t channels        = 0;
+    uint32_t sample_rate     = 0;
+    uint16_t bits_per_sample = 0;
+    uint16_t block_align     = 0;   // octets par frame (PCM) ou par bloc (ADPCM)
+    uint16_t samples_per_block = 0; // ADPCM uniquement
+    uint32_t data_offset     = 0;   // position du premier octet de données
+    uint32_t data_size       = 0;   // taille des données (octets)
+    uint32_t frame_count     = 0;   // nombre de frames (1 frame = 1 échantillon par canal)
+};
+
+// Lit l'entête RIFF et positionne f au début du chunk "data".
+// Retourne false si le fichier n'est pas un WAV exploitable.
+bool wav_parse_header(FILE* f, wav_info* info, const char* path_for_log = nullptr);
+
+// Nombre d'échantillons natifs produits pour un fichier à out_rate
+uint32_t wav_output_length(const wav_info& info, uint32_t out_rate);
+
+// -------------------------------------------------------------
+// Décodeur incrémental vers PCM 16 bits mono
+// -------------------------------------------------------------
+class wav_decoder {
+public:
+    wav_decoder();
+    ~wav_decoder();
+
+    // Prend possession de f, même en cas d'échec (fermé ici, par close()
+    // ou en fin de fichier) : l'appelant ne le ferme jamais.
+    bool begin(FILE* f, const wav_info& info, uint32_t out_rate);
+    void close();
+
+    // Produit jusqu'à max_samples échantillons natifs. 0 = fin.
+    uint32_t read(int16_t* dst, uint32_t max_samples);
+
+    bool is_open() const { return file != nullptr; }
+    uint32_t output_length() const { return out_length; }
+
+private:
+    static const int RAW_BYTES = 512;
+
+    FILE*    file;
+    wav_info info;
+    uint32_t frames_left;
+    uint32_t out_length;
+    bool     passthrough;    // déjà au format natif : lecture directe
+
+    // Rééchantillonnage linéaire (positions en 16.16)
+    uint32_t step;
+    int64_t  out_pos;
+    int64_t  in_count;
+    int16_t  prev;
+    int16_t  cur;
+
+    uint8_t  raw[RAW_BYTES];
+    uint32_t raw_len;
+    uint32_t raw_pos;
+
+    // ADPCM : un bloc compressé + sa version décodée (alloués dans begin)
+    uint8_t* adpcm_raw;
+    int16_t* adpcm_pcm;
+    uint32_t adpcm_len;
+    uint32_t adpcm_pos;
+
+    bool next_frame(int16_t& s);
+    bool next_adpcm_frame(int16_t& s);
+};
@@ -5,6 +5,9 @@
 #define BOARD_VERSION 4 // CORE V1.4
 
 //#define USE_WIFI
+//#define USE_MEM_TRACK   // debug : per-subsystem allocation counters + no-alloc zones (core/mem_track.h)
+//#define MEM_TRACK_STRICT  // debug : assert on forbidden allocation / budget overrun
+//#define USE_TELEMETRY   // needs USE_WIFI : softAP + UDP metrics every second (core/telemetry.h)
 //#define USE_PSRAM_VIDEO_BUFFER  // alloc 320x240x16 video buffer in PSRAM ( instead or static alloc in DRAM )
 #define DOUBLE_BUFFER_8B  // use 2nd buffer 320x240x8 for anarch in DRAM 
 
@@ -74,6 +77,11 @@ static const gpio_num_t LCD_PIN_DB0 = GPIO_NUM_3;
 #define EXPANDER_I2C_ADDRESS1   0x3F // 7 bits address
 #define AUDIO_AMP_I2C_ADDRESS   0x18 // 7 bits address
 
+// INT output of both key expanders (open drain, wired-OR, active low).
+// -1 : not routed to the MCU on this PCB => input task polls adaptively
+#define EXPANDER_INT_GPIO       -1
+#define EXPANDER_I2C_TIMEOUT_MS 10   // key read timeout (was infinite)
+
 // EXP0 : LOW byte
 #define EXPANDER_OUT_ENA_3V3  0x0001
 #define EXPANDER_KEY_RUN      0x0002
@@ -2,9 +2,9 @@
 #include "common.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "driver/gpio.h"
 #include "soc/soc_caps.h"
 #include "esp_log.h"
-#include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "TAS2505_rehs.h"
@@ -105,22 +105,62 @@ void expander_lcd_rd(uint8_t state)
 }
 #endif
 
-uint16_t expander_read()
+bool expander_read_keys(uint16_t* pu16_keys)
 {
     uint8_t u8_d1 = 0x55;
-    esp_err_t ret1 = i2c_master_receive(dev_handle1, &u8_d1, sizeof(u8_d1), -1);
+    esp_err_t ret1 = i2c_master_receive(dev_handle1, &u8_d1, sizeof(u8_d1), EXPANDER_I2C_TIMEOUT_MS);
     uint8_t u8_d0 = 0x55;
-    esp_err_t ret0 = i2c_master_receive(dev_handle0, &u8_d0, sizeof(u8_d0), -1);
-    uint16_t u16_data = u8_d0 + 256 * (uint16_t)u8_d1;
-    u16_data ^= EXPANDER_KEY_RUN; // Run key active high => active low
-    u16_data ^= EXPANDER_KEY;     // all key active low => active high
+    esp_err_t ret0 = i2c_master_receive(dev_handle0, &u8_d0, sizeof(u8_d0), EXPANDER_I2C_TIMEOUT_MS);
     if (ret0 || ret1) {
         printf("I2C read return %d %d\n", ret0, ret1);
-        return 0;
+        return false;
     }
+    uint16_t u16_data = u8_d0 + 256 * (uint16_t)u8_d1;
+    u16_data ^= EXPANDER_KEY_RUN; // Run key active high => active low
+    u16_data ^= EXPANDER_KEY;     // all key active low => active high
+    *pu16_keys = u16_data;
+    return true;
+}
+
+uint16_t expander_read()
+{
+    uint16_t u16_data = 0;
+    expander_read_keys(&u16_data);
     return u16_data;
 }
 
+int expander_int_enable(void (*handler)(void*), void* arg)
+{
+#if (EXPANDER_INT_GPIO >= 0)
+    gpio_config_t io_conf{};
+    io_conf.pin_bit_mask = 1ULL << EXPANDER_INT_GPIO;
+    io_conf.mode = GPIO_MODE_INPUT;
+    io_conf.pull_up_en = GPIO_PULLUP_ENABLE; // INT is open drain
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.intr_type = GPIO_INTR_NEGEDGE;
+    if (gpio_config(&io_conf) != ESP_OK) return -1;
+
+    esp_err_t ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) return -1; // already installed is fine
+
+    if (gpio_isr_handler_add((gpio_num_t)EXPANDER_INT_GPIO, handler, arg) != ESP_OK) return -1;
+    return 0;
+#else
+    (void)handler;
+    (void)arg;
+    return -1;
+#endif
+}
+
+int expander_int_pending()
+{
+#if (EXPANDER_INT_GPIO >= 0)
+    return gpio_get_level((gpio_num_t)EXPANDER_INT_GPIO) == 0;
+#else
+    return 0;
+#endif
+}
+
 void expander_power_off()
 {
     while (expander_read() & EXPANDER_KEY_RUN) { /* wait user release button */ }
@@ -264,61 +304,121 @@ void lcd_update_pwm(uint8_t u8_duty)
 }
 
 // ---------------- ADC ----------------
-#include "esp_adc/adc_oneshot.h"
+// Continuous mode: the 3 channels are sampled by DMA, frames are
+// averaged and low-pass filtered in the conversion-done callback.
+// adc_read_xxx() are plain memory loads (no conversion, no bus).
+#include "esp_adc/adc_continuous.h"
+#include "esp_attr.h"
+#include "esp_idf_version.h"
+
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_TYPE         ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p_data) ((p_data)->type1.channel)
+#define ADC_GET_DATA(p_data)    ((p_data)->type1.data)
+#else
+#define ADC_OUTPUT_TYPE         ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_GET_CHANNEL(p_data) ((p_data)->type2.channel)
+#define ADC_GET_DATA(p_data)    ((p_data)->type2.data)
+#endif
+
+#define ADC_SAMPLE_FREQ_HZ  6000    // all channels => 2 kHz per channel
+#define ADC_FRAME_RESULTS   24      // 8 results per channel => ~250 frames/s
+#define ADC_FRAME_BYTES     (ADC_FRAME_RESULTS * SOC_ADC_DIGI_RESULT_BYTES)
+#define ADC_FILTER_SHIFT    2       // IIR: y += (x - y) / 4 per frame (~16 ms)
 
-adc_oneshot_unit_handle_t adc1_handle;
+enum { ADC_IDX_BATTERY, ADC_IDX_JOYX, ADC_IDX_JOYY, ADC_IDX_COUNT };
 
-const adc_oneshot_chan_cfg_t config = {
-    .atten = ADC_ATTEN_DB_12,     // plage complète 0..3.3V
-    .bitwidth = ADC_BITWIDTH_12,  // résolution 12 bits (0..4095)
+static const uint8_t adc_channels[ADC_IDX_COUNT] = {
+    ADC1_CHANNEL_BATTERY, ADC1_CHANNEL_JOYX, ADC1_CHANNEL_JOYY
 };
 
+static adc_continuous_handle_t adc_handle = nullptr;
+static volatile int32_t  adc_filtered[ADC_IDX_COUNT]; // raw 12 bits << 4
+static volatile uint32_t adc_frames = 0;
+
+static bool IRAM_ATTR adc_conv_done(adc_continuous_handle_t handle, const adc_continuous_evt_data_t* edata, void* user_data)
+{
+    int32_t sum[ADC_IDX_COUNT] = { 0, 0, 0 };
+    int32_t cnt[ADC_IDX_COUNT] = { 0, 0, 0 };
+
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= edata->size; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* p = (const adc_digi_output_data_t*)&edata->conv_frame_buffer[i];
+        uint32_t chan = ADC_GET_CHANNEL(p);
+        for (int c = 0; c < ADC_IDX_COUNT; c++)
+            if (chan == adc_channels[c]) { sum[c] += ADC_GET_DATA(p); cnt[c]++; break; }
+    }
+
+    for (int c = 0; c < ADC_IDX_COUNT; c++) {
+        if (!cnt[c]) continue;
+        int32_t x = (sum[c] << 4) / cnt[c];
+        int32_t y = adc_filtered[c];
+        adc_filtered[c] = adc_frames ? y + ((x - y) >> ADC_FILTER_SHIFT) : x;
+    }
+    adc_frames = adc_frames + 1;
+    return false; // no task to wake
+}
+
 int adc_init()
 {
-    adc_oneshot_unit_init_cfg_t init_config1{};
-    init_config1.unit_id = ADC_UNIT_1;
-#if defined(ADC_CLK_SRC_DEFAULT)
-    init_config1.clk_src = ADC_CLK_SRC_DEFAULT;
-#endif
-#if defined(ADC_ULP_MODE_DISABLE)
-    init_config1.ulp_mode = ADC_ULP_MODE_DISABLE;
+    adc_continuous_handle_cfg_t handle_cfg{};
+    handle_cfg.max_store_buf_size = ADC_FRAME_BYTES * 2; // frames are consumed in the callback
+    handle_cfg.conv_frame_size = ADC_FRAME_BYTES;
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+    handle_cfg.flags.flush_pool = 1; // never read through adc_continuous_read()
 #endif
+    esp_err_t ret = adc_continuous_new_handle(&handle_cfg, &adc_handle);
+    printf("adc_continuous_new_handle return %d\n", ret);
+    if (ret) return -1;
+
+    adc_digi_pattern_config_t pattern[ADC_IDX_COUNT]{};
+    for (int c = 0; c < ADC_IDX_COUNT; c++) {
+        pattern[c].atten = ADC_ATTEN_DB_12;           // plage complète 0..3.3V
+        pattern[c].channel = adc_channels[c];
+        pattern[c].unit = ADC_UNIT_1;
+        pattern[c].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
 
-    esp_err_t ret = adc_oneshot_new_unit(&init_config1, &adc1_handle);
-    printf("adc_oneshot_new_unit return %d\n", ret);
+    adc_continuous_config_t dig_cfg{};
+    dig_cfg.pattern_num = ADC_IDX_COUNT;
+    dig_cfg.adc_pattern = pattern;
+    dig_cfg.sample_freq_hz = ADC_SAMPLE_FREQ_HZ;
+    dig_cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    dig_cfg.format = ADC_OUTPUT_TYPE;
+    ESP_ERROR_CHECK(adc_continuous_config(adc_handle, &dig_cfg));
 
-    // Configure les 3 canaux (batterie + joystick X/Y)
-    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc1_handle, (adc_channel_t)ADC1_CHANNEL_BATTERY, &config));
-    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc1_handle, (adc_channel_t)ADC1_CHANNEL_JOYX, &config));
-    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc1_handle, (adc_channel_t)ADC1_CHANNEL_JOYY, &config));
+    adc_continuous_evt_cbs_t cbs{};
+    cbs.on_conv_done = adc_conv_done;
+    ESP_ERROR_CHECK(adc_continuous_register_event_callbacks(adc_handle, &cbs, nullptr));
+    ESP_ERROR_CHECK(adc_continuous_start(adc_handle));
 
     return 0;
 }
 
+uint32_t adc_frame_count()
+{
+    return adc_frames;
+}
+
+// filtered raw value (0..4095) => mV (0..JOYX_MAX)
+static int adc_filtered_mv(int idx)
+{
+    return ((adc_filtered[idx] >> 4) * JOYX_MAX) / 4095; // JOYX_MAX = 3300
+}
+
 int adc_read_vbatt()
 {
-    int adc_raw;
-    ESP_ERROR_CHECK(adc_oneshot_read(adc1_handle, (adc_channel_t)ADC1_CHANNEL_BATTERY, &adc_raw));
-    // Conversion brute en mV (0..3300)
-    int voltage = (adc_raw * 3300) / 4095;
-    return 2 * voltage; // batterie divisée par 2 → on multiplie pour retrouver la tension réelle
+    // batterie divisée par 2 → on multiplie pour retrouver la tension réelle
+    return 2 * adc_filtered_mv(ADC_IDX_BATTERY);
 }
 
 int adc_read_joyx()
 {
-    int adc_raw;
-    ESP_ERROR_CHECK(adc_oneshot_read(adc1_handle, (adc_channel_t)ADC1_CHANNEL_JOYX, &adc_raw));
-    // Conversion brute en mV (0..3300)
-    int voltage = (adc_raw * JOYX_MAX) / 4095; // JOYX_MAX = 3300
-    return voltage;
+    return adc_filtered_mv(ADC_IDX_JOYX);
 }
 
 int adc_read_joyy()
 {
-    int adc_raw;
-    ESP_ERROR_CHECK(adc_oneshot_read(adc1_handle, (adc_channel_t)ADC1_CHANNEL_JOYY, &adc_raw));
-    int voltage = (adc_raw * JOYX_MAX) / 4095;
-    return voltage;
+    return adc_filtered_mv(ADC_IDX_JOYY);
 }
 
 
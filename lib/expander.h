@@ -10,9 +10,19 @@ int expander_init();
 //! write 8b low expander (high byte will be never written, keep all bits to 1 for correct key read)
 void expander_write(uint8_t u8_data);
 
-//! return 16b expander inputs (keys, cf EXPANDER_KEY_xxx)
+//! return 16b expander inputs (keys, cf EXPANDER_KEY_xxx), 0 on I2C error
 uint16_t expander_read();
 
+//! read keys into *pu16_keys ; return false (value unchanged) on I2C error
+bool expander_read_keys(uint16_t* pu16_keys);
+
+//! call handler (from ISR) on expander INT falling edge
+//! return -1 if INT is not routed (EXPANDER_INT_GPIO < 0) or on error
+int expander_int_enable(void (*handler)(void*), void* arg);
+
+//! 1 while INT is asserted (inputs changed since last read)
+int expander_int_pending();
+
 //! simple test routine for expander
 void test_expander();
 
@@ -21,9 +31,13 @@ void lcd_init_pwm();
 void lcd_update_pwm(uint8_t u8_duty);
 
 // --- ADC ---
-// initialize 3 channels adc for battery and Joystick
+// initialize 3 channels continuous adc (DMA) for battery and Joystick
+// values below are filtered in the DMA callback : reads are memory loads
 int adc_init();
 
+// number of DMA frames processed since adc_init (0 = no sample yet)
+uint32_t adc_frame_count();
+
 // return Battery voltage in mV
 int adc_read_vbatt();
 
@@ -248,6 +248,10 @@ pmf_player::pmf_player()
   m_sampling_freq=0;
   m_row_callback=0;
   m_tick_callback=0;
+  m_num_mix_channels=0;
+  m_pending_tempo_scale=m_tempo_scale=256;
+  m_pending_mute_mask=m_mute_mask=0;
+  m_tempo=125;
   m_speed=0;
 }
 //----
@@ -347,13 +351,16 @@ void pmf_player::start(uint32_t sampling_freq_, uint16_t playlist_pos_)
   m_speed=pgm_read_byte(m_pmf_file+pmfcfg_offset_init_speed);
   m_note_period_min=pgm_read_word(m_pmf_file+pmfcfg_offset_note_period_min);
   m_note_period_max=pgm_read_word(m_pmf_file+pmfcfg_offset_note_period_max);
-  m_num_batch_samples=(m_sampling_freq*125)/long(pgm_read_byte(m_pmf_file+pmfcfg_offset_init_tempo)*50);
+  m_tempo_scale=m_pending_tempo_scale;
+  m_mute_mask=m_pending_mute_mask;
+  set_tempo(pgm_read_byte(m_pmf_file+pmfcfg_offset_init_tempo));
   m_current_row_tick=m_speed-1;
   m_arpeggio_counter=0;
   m_pattern_delay=1;
 
   // start playback
   m_batch_pos=0;
+  select_mix_kernels();
   start_playback(sampling_freq_);
   PMF_SERIAL_LOG("PMF playback started (%i channels)\r\n", m_num_playback_channels);
 }
@@ -404,6 +411,8 @@ void pmf_player::update()
         evaluate_envelopes();
       if(m_tick_callback)
         (*m_tick_callback)(m_tick_callback_custom_data);
+      apply_runtime_controls();
+      select_mix_kernels();
       m_batch_pos=0;
     }
   } while(subbuffer.num_samples);
@@ -412,6 +421,25 @@ void pmf_player::update()
 //---------------------------------------------------------------------------
 
 void pmf_player::mix(int16_t *out_buffer, unsigned num_samples)
+{
+  process_samples(out_buffer, num_samples);
+}
+//----
+
+void pmf_player::skip(unsigned num_samples)
+{
+  process_samples(0, num_samples);
+}
+//----
+
+uint16_t pmf_player::samples_until_tick() const
+{
+  return m_speed?m_num_batch_samples-m_batch_pos:0;
+}
+//----
+
+// out_buffer == 0 : avance la lecture sans mixer (positions des samples comprises)
+void pmf_player::process_samples(int16_t *out_buffer, unsigned num_samples)
 {
   if (!m_note_slide_speed || !m_pmf_file || !m_speed)
     return;
@@ -430,7 +458,10 @@ void pmf_player::mix(int16_t *out_buffer, unsigned num_samples)
       break;
 
     // appelle le mixeur interne (implémenté via mix_buffer_impl)
-    mix_buffer(subbuffer, chunk);
+    if (out_buffer)
+      mix_buffer(subbuffer, chunk);
+    else
+      mix_buffer_impl<int16_t, false, 16, true>(subbuffer, chunk);
     m_batch_pos += chunk;
 
     // fin de batch → avancer la musique (ticks, rows, effets…)
@@ -456,6 +487,10 @@ void pmf_player::mix(int16_t *out_buffer, unsigned num_samples)
       if (m_tick_callback)
         (*m_tick_callback)(m_tick_callback_custom_data);
 
+      // tempo, muets et mixage des canaux ne changent qu'aux frontières de tick
+      apply_runtime_controls();
+      select_mix_kernels();
+
       m_batch_pos = 0;
     }
   } while (subbuffer.num_samples);
@@ -463,6 +498,114 @@ void pmf_player::mix(int16_t *out_buffer, unsigned num_samples)
 
 //---------------------------------------------------------------------------
 
+void pmf_player::set_tempo_scale(uint16_t scale_)
+{
+  // clamp to 1/4x..4x of the file tempo
+  m_pending_tempo_scale=scale_<64?64:scale_>1024?1024:scale_;
+}
+//----
+
+void pmf_player::set_channel_mute_mask(uint16_t mask_)
+{
+  m_pending_mute_mask=mask_;
+}
+//----
+
+uint16_t pmf_player::tempo_scale() const
+{
+  return m_pending_tempo_scale;
+}
+//----
+
+uint16_t pmf_player::channel_mute_mask() const
+{
+  return m_pending_mute_mask;
+}
+//----
+
+uint8_t pmf_player::num_mixed_channels() const
+{
+  if(!m_speed)
+    return 0;
+  uint8_t num=0;
+  for(uint8_t i=0; i<m_num_mix_channels; ++i)
+  {
+    const audio_channel &chl=m_channels[m_mix_channels[i]];
+    num+=chl.mix_kernel!=mixkernel_silent && !chl.mix_muted;
+  }
+  return num;
+}
+//----
+
+void pmf_player::set_tempo(uint8_t tempo_)
+{
+  // samples per tick for the tempo (BPM) of the file scaled by the runtime
+  // tempo scale (the unscaled path keeps the exact original rounding)
+  m_tempo=tempo_;
+  if(m_tempo_scale==256)
+    m_num_batch_samples=(m_sampling_freq*125)/long(tempo_*50);
+  else
+    m_num_batch_samples=(m_sampling_freq*125L*256)/(long(tempo_*50)*m_tempo_scale);
+  if(!m_num_batch_samples)
+    m_num_batch_samples=1;
+}
+//----
+
+void pmf_player::apply_runtime_controls()
+{
+  // called at tick boundaries only: the batch length never changes mid-tick
+  uint16_t scale=m_pending_tempo_scale;
+  if(scale!=m_tempo_scale)
+  {
+    m_tempo_scale=scale;
+    set_tempo(m_tempo);
+  }
+  m_mute_mask=m_pending_mute_mask;
+}
+//----
+
+void pmf_player::select_mix_kernels()
+{
+  // pick the mixing kernel of each channel and cache its per-tick attributes,
+  // so that mix_buffer_impl() only visits audible channels
+  m_num_mix_channels=0;
+  for(uint8_t ci=0; ci<m_num_playback_channels; ++ci)
+  {
+    audio_channel &chl=m_channels[ci];
+    // note: zero-volume channels are still mixed to keep their sample position
+    uint8_t sample_volume=(chl.sample_volume*(chl.vol_env.value>>8))>>8;
+    if(!chl.sample_speed || !chl.smp_metadata)
+    {
+      chl.mix_kernel=mixkernel_silent;
+      continue;
+    }
+
+    // sample attributes
+    uint32_t loop_len_and_panning=pgm_read_dword(chl.smp_metadata+pmfcfg_offset_smp_loop_length_and_panning);
+    chl.mix_sample_addr=(size_t)(m_pmf_file+pgm_read_dword(chl.smp_metadata+pmfcfg_offset_smp_data));
+    chl.mix_sample_end=uint32_t(pgm_read_dword(chl.smp_metadata+pmfcfg_offset_smp_length))<<8;
+    chl.mix_loop_len=(loop_len_and_panning&0xffffff)<<8;
+    chl.mix_loop_start=chl.mix_sample_end-chl.mix_loop_len;
+    if(!chl.mix_loop_len)
+      chl.mix_kernel=mixkernel_forward;
+    else if(pgm_read_byte(chl.smp_metadata+pmfcfg_offset_smp_flags)&pmfsmpflag_bidi_loop)
+      chl.mix_kernel=mixkernel_bidi;
+    else
+      chl.mix_kernel=mixkernel_loop;
+
+    // volume & panning
+    int8_t panning=chl.sample_panning;
+    chl.mix_phase_shift=panning==-128?0xffff:0;
+    panning&=~int8_t(chl.mix_phase_shift);
+    chl.mix_volume=sample_volume;
+    chl.mix_volume_l=uint8_t((uint16_t(sample_volume)*uint8_t(128-panning))>>8);
+    chl.mix_volume_r=uint8_t((uint16_t(sample_volume)*uint8_t(128+panning))>>8);
+    chl.mix_muted=(m_mute_mask>>ci)&1;
+    m_mix_channels[m_num_mix_channels++]=ci;
+  }
+}
+//----
+
 bool pmf_player::is_playing() const
 {
   return m_speed!=0;
@@ -1070,7 +1213,7 @@ void pmf_player::process_pattern_row()
           if(effect_data<32)
             m_speed=effect_data;
           else
-            m_num_batch_samples=(m_sampling_freq*125)/long(effect_data*50);
+            set_tempo(effect_data);
         } break;
 
         case pmffx_position_jump:
@@ -183,6 +183,15 @@ public:
   void update();
   // custom mixing for external audio pipelines
   void mix(int16_t *out_buffer, unsigned num_samples);
+  // advance playback (ticks, rows, sample positions) without mixing
+  void skip(unsigned num_samples);
+  uint16_t samples_until_tick() const;
+  // runtime control (applied at the next tick boundary)
+  void set_tempo_scale(uint16_t scale_);         // 8.8 fp, 256=tempo of the file
+  void set_channel_mute_mask(uint16_t mask_);    // bit n set = channel n muted (not mixed)
+  uint16_t tempo_scale() const;
+  uint16_t channel_mute_mask() const;
+  uint8_t num_mixed_channels() const;            // audible channels mixed this tick
 
   //-------------------------------------------------------------------------
 
@@ -204,7 +213,13 @@ private:
   void mix_buffer(pmf_mixer_buffer&, unsigned num_samples_);
   pmf_mixer_buffer get_mixer_buffer();
   // platform agnostic reference functions
-  template<typename T, bool stereo=false, unsigned channel_bits=8> void mix_buffer_impl(pmf_mixer_buffer&, unsigned num_samples_);
+  template<typename T, bool stereo=false, unsigned channel_bits=8, bool dry=false> void mix_buffer_impl(pmf_mixer_buffer&, unsigned num_samples_);
+  template<typename T, bool stereo, unsigned channel_bits, bool dry> void mix_channel(audio_channel&, T *buf_, unsigned num_samples_);
+  template<typename T, bool stereo, unsigned channel_bits, bool dry> static void mix_channel_run(T *&buf_, unsigned num_samples_, const audio_channel&, uint32_t &sample_pos_, int16_t sample_speed_);
+  void process_samples(int16_t *out_buffer_, unsigned num_samples_);
+  void select_mix_kernels();
+  void set_tempo(uint8_t tempo_);
+  void apply_runtime_controls();
   // audio effects
   void apply_channel_effect_volume_slide(audio_channel&);
   void apply_channel_effect_note_slide(audio_channel&);
@@ -225,6 +240,19 @@ private:
   void init_pattern(uint8_t playlist_pos_, uint8_t row_=0);
   //-------------------------------------------------------------------------
 
+  //=========================================================================
+  // e_mix_kernel
+  //=========================================================================
+  // per-channel mixing kernel, selected at tick boundaries
+  enum e_mix_kernel
+  {
+    mixkernel_silent,   // channel inactive: not mixed at all
+    mixkernel_forward,  // one-shot sample, constant volume
+    mixkernel_loop,     // forward loop, constant volume
+    mixkernel_bidi,     // ping-pong loop, constant volume
+  };
+  //-------------------------------------------------------------------------
+
   //=========================================================================
   // envelope_state
   //=========================================================================
@@ -280,6 +308,17 @@ private:
     uint16_t vol_fadeout;          // fadeout volume
     envelope_state vol_env;        // volume envelope
     envelope_state pitch_env;      // pitch envelope
+    // mixing state (updated by select_mix_kernels() at tick boundaries)
+    uint8_t mix_kernel;            // e_mix_kernel
+    bool mix_muted;                // muted by the channel mute mask
+    uint8_t mix_volume;            // sample volume incl. envelope (0.8 fp)
+    uint8_t mix_volume_l;          // left volume after panning
+    uint8_t mix_volume_r;          // right volume after panning
+    int16_t mix_phase_shift;       // 0xffff for surround
+    size_t mix_sample_addr;        // sample data address
+    uint32_t mix_sample_end;       // sample end (24.8 fp)
+    uint32_t mix_loop_start;       // loop start (24.8 fp)
+    uint32_t mix_loop_len;         // loop length (24.8 fp)
   };
   //-------------------------------------------------------------------------
 
@@ -301,6 +340,14 @@ private:
   uint8_t m_num_playback_channels;
   uint8_t m_num_processed_pattern_channels;
   audio_channel m_channels[pmfplayer_max_channels];
+  uint8_t m_mix_channels[pmfplayer_max_channels]; // indices of non-silent channels
+  uint8_t m_num_mix_channels;
+  // runtime control state
+  volatile uint16_t m_pending_tempo_scale;
+  volatile uint16_t m_pending_mute_mask;
+  uint16_t m_tempo_scale;
+  uint16_t m_mute_mask;
+  uint8_t m_tempo;
   // audio buffer state
   uint16_t m_num_batch_samples;
   uint16_t m_batch_pos;
@@ -317,85 +364,108 @@ private:
 };
 //---------------------------------------------------------------------------
 
-template<typename T, bool stereo, unsigned channel_bits>
-void pmf_player::mix_buffer_impl(pmf_mixer_buffer &buf_, unsigned num_samples_)
+template<typename T, bool stereo, unsigned channel_bits, bool dry>
+void pmf_player::mix_channel_run(T *&buf_, unsigned num_samples_, const audio_channel &chl_, uint32_t &sample_pos_, int16_t sample_speed_)
 {
-  audio_channel *channel=m_channels, *channel_end=channel+m_num_playback_channels;
-  do
+  // dry run: only advance the sample position
+  if(dry)
+  {
+    sample_pos_+=num_samples_*int32_t(sample_speed_);
+    return;
+  }
+
+  // mix num_samples_ samples without any boundary check (the caller guarantees
+  // the run stays within the sample, the if-branches with compile-time constants
+  // are optimized out)
+  size_t sample_addr=chl_.mix_sample_addr;
+  uint32_t sample_pos=sample_pos_;
+  int32_t sample_speed=sample_speed_;
+  T *buf=buf_, *buffer_end=buf+num_samples_*(stereo?2:1);
+  while(buf<buffer_end)
   {
-    // check for active channel
-    if(!channel->sample_speed)
-      continue;
-
-    // get channel attributes
-    size_t sample_addr=(size_t)(m_pmf_file+pgm_read_dword(channel->smp_metadata+pmfcfg_offset_smp_data));
-    uint32_t sample_pos=channel->sample_pos;
-    int16_t sample_speed=channel->sample_speed;
-    uint32_t sample_end=uint32_t(pgm_read_dword(channel->smp_metadata+pmfcfg_offset_smp_length))<<8;
-    uint32_t sample_loop_len=(pgm_read_dword(channel->smp_metadata+pmfcfg_offset_smp_loop_length_and_panning)&0xffffff)<<8;
-    uint8_t sample_volume=(channel->sample_volume*(channel->vol_env.value>>8))>>8;
-    uint32_t sample_pos_offs=sample_end-sample_loop_len;
-    if(sample_pos<sample_pos_offs)
-      sample_pos_offs=0;
-    sample_addr+=sample_pos_offs>>8;
-    sample_pos-=sample_pos_offs;
-    sample_end-=sample_pos_offs;
-
-    // setup panning
-    int8_t panning=channel->sample_panning;
-    int16_t sample_phase_shift=panning==-128?0xffff:0;
-    panning&=~int8_t(sample_phase_shift);
-    uint8_t sample_volume_l=uint8_t((uint16_t(sample_volume)*uint8_t(128-panning))>>8);
-    uint8_t sample_volume_r=uint8_t((uint16_t(sample_volume)*uint8_t(128+panning))>>8);
-
-    // mix channel to the buffer
-    T *buf=(T*)buf_.begin, *buffer_end=buf+num_samples_*(stereo?2:1);
-    do
-    {
-      // get sample data and adjust volume
 #if PMF_USE_LINEAR_INTERPOLATION==1
-      uint16_t smp_data=((uint16_t)pgm_read_word(sample_addr+(sample_pos>>8)));
-      uint8_t sample_pos_frc=sample_pos&255;
-      int16_t smp=((int16_t(int8_t(smp_data&255))*(256-sample_pos_frc))>>8)+((int16_t(int8_t(smp_data>>8))*sample_pos_frc)>>8);
+    uint16_t smp_data=((uint16_t)pgm_read_word(sample_addr+(sample_pos>>8)));
+    uint8_t sample_pos_frc=sample_pos&255;
+    int16_t smp=((int16_t(int8_t(smp_data&255))*(256-sample_pos_frc))>>8)+((int16_t(int8_t(smp_data>>8))*sample_pos_frc)>>8);
 #else
-      int16_t smp=(int8_t)pgm_read_byte(sample_addr+(sample_pos>>8));
+    int16_t smp=(int8_t)pgm_read_byte(sample_addr+(sample_pos>>8));
 #endif
+    if(stereo)
+    {
+      (*buf++)+=T(chl_.mix_volume_l*smp)>>(16-channel_bits);
+      (*buf++)+=T(chl_.mix_volume_r*(smp^chl_.mix_phase_shift))>>(16-channel_bits);
+    }
+    else
+      (*buf++)+=T(chl_.mix_volume*smp)>>(16-channel_bits);
+    sample_pos+=sample_speed;
+  }
+  buf_=buffer_end;
+  sample_pos_=sample_pos;
+}
+//----
 
-      // mix the result to the audio buffer (the if-branch with compile-time constant will be optimized out)
-      if(stereo)
-      {
-        (*buf++)+=T(sample_volume_l*smp)>>(16-channel_bits);
-        (*buf++)+=T(sample_volume_r*(smp^sample_phase_shift))>>(16-channel_bits);
-      }
-      else
-        (*buf++)+=T(sample_volume*smp)>>(16-channel_bits);
-
-      // advance sample position
-      sample_pos+=sample_speed;
-      if(sample_pos>=sample_end)
-      {
-        // check for loop
-        if(!sample_loop_len)
-        {
-          channel->sample_speed=0;
-          break;
-        }
-
-        // apply normal/bidi loop
-        if(pgm_read_byte(channel->smp_metadata+pmfcfg_offset_smp_flags)&pmfsmpflag_bidi_loop)
-        {
-          sample_pos-=sample_speed*2;
-          channel->sample_speed=sample_speed=-sample_speed;
-        }
-        else
-          sample_pos-=sample_loop_len;
-      }
-    } while(buf<buffer_end);
-    channel->sample_pos=sample_pos+sample_pos_offs;
-  } while(++channel!=channel_end);
+template<typename T, bool stereo, unsigned channel_bits, bool dry>
+void pmf_player::mix_channel(audio_channel &chl_, T *buf_, unsigned num_samples_)
+{
+  uint32_t sample_pos=chl_.sample_pos;
+  int16_t sample_speed=chl_.sample_speed;
+  unsigned samples_left=num_samples_;
+  while(samples_left)
+  {
+    // number of samples until the next sample boundary (loop end, or loop
+    // start when playing a bidi loop backwards)
+    uint32_t num_run;
+    if(sample_speed>0)
+      num_run=sample_pos<chl_.mix_sample_end?(chl_.mix_sample_end-sample_pos+sample_speed-1)/sample_speed:0;
+    else
+      num_run=sample_pos>=chl_.mix_loop_start?(sample_pos-chl_.mix_loop_start)/uint32_t(-sample_speed)+1:0;
+    if(num_run>samples_left)
+    {
+      mix_channel_run<T, stereo, channel_bits, dry>(buf_, samples_left, chl_, sample_pos, sample_speed);
+      break;
+    }
+    mix_channel_run<T, stereo, channel_bits, dry>(buf_, num_run, chl_, sample_pos, sample_speed);
+    samples_left-=num_run;
+
+    // handle the boundary (same rules as the reference mixer)
+    if(chl_.mix_kernel==mixkernel_forward)
+    {
+      sample_speed=0;
+      chl_.mix_kernel=mixkernel_silent;
+      break;
+    }
+    if(chl_.mix_kernel==mixkernel_bidi)
+    {
+      sample_pos-=sample_speed*2;
+      sample_speed=-sample_speed;
+    }
+    else
+      sample_pos-=chl_.mix_loop_len;
+  }
+  chl_.sample_pos=sample_pos;
+  chl_.sample_speed=sample_speed;
+}
+//----
+
+template<typename T, bool stereo, unsigned channel_bits, bool dry>
+void pmf_player::mix_buffer_impl(pmf_mixer_buffer &buf_, unsigned num_samples_)
+{
+  // only channels with a non-silent kernel are visited, muted channels only
+  // advance their sample position (no mixing)
+  for(uint8_t i=0; i<m_num_mix_channels; ++i)
+  {
+    audio_channel &chl=m_channels[m_mix_channels[i]];
+    if(chl.mix_kernel==mixkernel_silent || !chl.sample_speed)
+      continue;
+    if(dry || chl.mix_muted)
+      mix_channel<T, stereo, channel_bits, true>(chl, 0, num_samples_);
+    else
+      mix_channel<T, stereo, channel_bits, false>(chl, (T*)buf_.begin, num_samples_);
+  }
 
   // advance buffer
-  ((T*&)buf_.begin)+=num_samples_*(stereo?2:1);
+  if(!dry)
+    ((T*&)buf_.begin)+=num_samples_*(stereo?2:1);
   buf_.num_samples-=num_samples_;
 }
 //---------------------------------------------------------------------------
@@ -1,40 +1,34 @@
 /*
 ============================================================
-  task_audio.cpp — Tâche audio (1 kHz)
+  task_audio.cpp — Tâche audio (pilotée par le DAC)
 ------------------------------------------------------------
 Cette tâche exécute :
  - audio_update() : mixage, PMF, SFX
 
-Elle tourne à 1 kHz pour garantir une latence minimale
-et une qualité audio stable, indépendamment du framerate.
+Elle dort jusqu'à ce que i2s_callback signale (notification
+de tâche) que la FIFO est passée sous le niveau visé, puis
+produit exactement les buffers manquants. Le rythme suit donc
+l'horloge du DAC et non le tick RTOS.
+
+Remarque : audio_init() crée déjà une tâche équivalente ; ne
+lancer celle-ci qu'à la place de celle d'audio_init().
 ============================================================
 */
 
 #include "task_audio.h"
 #include "core/audio.h"
-#include "esp_timer.h"
-#include "esp_rom_sys.h"
 #include "freertos/FreeRTOS.h" 
 #include "freertos/task.h"
 
 void task_audio(void* param)
 {
-    const int AUDIO_US = 1000; // 1 kHz
-    int64_t last = esp_timer_get_time();
+    // Filet de sécurité si l'I2S ne notifie plus (2 périodes DAC)
+    const uint32_t timeout_ms =
+        2 * (1000 * GB_AUDIO_BUFFER_SAMPLE_COUNT) / GB_AUDIO_SAMPLE_RATE;
 
     while (true)
     {
-        int64_t now = esp_timer_get_time();
-        int64_t dt = now - last;
-
-        if (dt >= AUDIO_US)
-        {
-            last = now;
-            audio_update();
-        }
-        else
-        {
-            vTaskDelay(1); // 1 ms
-        }
+        audio_render_to_target();
+        audio_wait_fifo_space(timeout_ms);
     }
 }
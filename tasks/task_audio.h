@@ -2,13 +2,13 @@
 
 /*
 ============================================================
-  task_audio.h — Tâche audio (1 kHz)
+  task_audio.h — Tâche audio (pilotée par le DAC)
 ------------------------------------------------------------
 Cette tâche exécute :
  - audio_update() : mixage, PMF, SFX
 
-Elle tourne à 1 kHz pour garantir une latence minimale
-et une qualité audio stable, indépendamment du framerate.
+Elle est réveillée par i2s_callback (notification de tâche)
+et remplit la FIFO jusqu'à GB_AUDIO_FIFO_FILL_TARGET buffers.
 ============================================================
 */
 
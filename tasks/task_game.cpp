@@ -21,31 +21,74 @@ Elle contient désormais la machine à états complète du jeu.
 #include "ui/menu.h"
 #include "ui/highscores.h"
 #include "game/level.h"
+#include "game/snapshot.h"
+#include "game/netplay.h"
 #include "assets/assets.h"
 #include "core/audio.h"
 #include "lib/audio_sfx.h"
 #include "core/persist.h"
+#include "core/telemetry.h"
+#include "core/mem_track.h"
 #include "ui/options.h"
+#include "lib/expander.h"
+#ifdef USE_WIFI
+#include "lib/app_wifi.h"
+#endif
 #include "esp_timer.h"
 #include "esp_rom_sys.h"
 #include "freertos/FreeRTOS.h" 
 #include "freertos/task.h"
+#include <stdio.h>
 
 // ------------------------------------------------------------
 // État global du jeu
 // ------------------------------------------------------------
 static GameState g;
 static int options_index = 0;
+static GameState::State audio_debug_return = GameState::State::Options;
+static int audio_debug_frames = 0;
+static const char* snapshot_msg = nullptr;   // retour save-state (écran pause)
 
 
 // ------------------------------------------------------------
 // Fonctions d’états (une par écran)
 // ------------------------------------------------------------
 
+#ifdef USE_WIFI
+// Jeu à 2 en lockstep (cf. game/netplay.h) : l'hôte crée le point
+// d'accès et joue Pac-Man, l'invité s'y connecte et joue Blinky
+static void start_link_play(bool host)
+{
+    gfx_clear(COLOR_BLACK);
+    gfx_text(70, 120, host ? "LINK : HOST..." : "LINK : JOIN...", COLOR_WHITE);
+    gfx_flush();
+
+    // Appels répétables : pile WiFi initialisée une fois (app_wifi.cpp),
+    // rejoindre est refusé si cette console fait déjà point d'accès
+    if (host)
+        wifi_init_softap();
+    else if (wifi_join_softap() != 0)
+        return;
+
+    game_init(g);
+    if (netplay_start(g, host ? 0 : 1, host ? nullptr : "192.168.4.1",
+                      game_update, esp_timer_get_time()))
+        g.state = GameState::State::StartingLevel;
+}
+#endif
+
 static void state_title_screen(const Keys& k)
 {
     title_screen_show();
 
+#ifdef USE_WIFI
+    if (k.C || k.D) {
+        audio_sfx_validate();
+        start_link_play(k.C);
+        return;
+    }
+#endif
+
     if (k.A) {
         audio_sfx_validate();
         game_init(g);
@@ -69,11 +112,28 @@ static void state_starting_level(const Keys& k)
 
 static void state_playing(const Keys& k)
 {
-    game_update(g);
-    game_draw(g);
+    {
+        // Frame de jeu : aucune allocation en régime établi (USE_MEM_TRACK)
+        MemNoAlloc no_alloc("Playing");
+
+        // L1 tenu : rewind (une photo par frame, cf. game/snapshot.h)
+        if (k.L1) {
+            if (rewind_step(g))
+                g.state = GameState::State::Playing;
+            game_draw(g);
+            return;
+        }
+
+        game_update(g);
+        game_draw(g);
+
+        if (g.state == GameState::State::Playing)
+            rewind_record(g);
+    }
 
     if (k.RUN) {
         g.state = GameState::State::Paused;
+        snapshot_msg = nullptr;
     }
 
     if (k.A) {
@@ -86,11 +146,30 @@ static void state_playing(const Keys& k)
     }
 
     if (game_is_over(g)) {
+        mem_track_report();
         highscores_submit(g.score);
         g.state = GameState::State::Highscores;
     }
 }
 
+// Jeu à 2 : la logique avance au tick de netplay, pas de pause ni de rewind
+static void state_netplay(const Keys& k)
+{
+    netplay_update(g, netplay_input_from_keys(k), esp_timer_get_time());
+    game_draw(g);
+
+    if (netplay_delay() >= NETPLAY_ROLLBACK_FRAMES)
+        gfx_text(110, 120, "WAITING...", COLOR_WHITE);
+
+    if (game_is_over(g)) {
+        const NetplayStats& s = netplay_stats();
+        printf("NETPLAY: fin, %u rollbacks (%u frames), %u attentes, %u/%u CRC différents\n",
+               (unsigned)s.rollbacks, (unsigned)s.resim_frames, (unsigned)s.stalls,
+               (unsigned)s.desyncs, (unsigned)s.checks);
+        netplay_stop();
+    }
+}
+
 static void state_pacman_dying(const Keys& k)
 {
     // game_update() gère :
@@ -103,18 +182,34 @@ static void state_pacman_dying(const Keys& k)
 }
 
 
+// Ouvre la page debug audio depuis un écran d'options (touche R1)
+static void open_audio_debug()
+{
+    audio_sfx_click();
+    audio_debug_return = g.state;
+    audio_debug_frames = 0;
+    nav_cooldown = 8;
+    g.state = GameState::State::AudioDebug;
+}
+
 static void state_options(const Keys& k)
 {
     gfx_clear(COLOR_BLACK);
     draw_options_menu(g.state, options_index);
     handle_audio_options_navigation(k, options_index);
 
+    if (k.R1) {
+        open_audio_debug();
+        return;
+    }
+
     if (k.A && options_index == 4) {
         audio_sfx_validate();
         highscores_show();
     }
 
-    if ((k.A && options_index == 5) || k.B) {
+    // Front de B : la pression qui ferme la page debug ne ferme pas aussi ce menu
+    if ((k.A && options_index == 5) || (k.pressed & EXPANDER_KEY_B)) {
         audio_sfx_cancel();
         g.state = GameState::State::TitleScreen;
         audio_settings_save();
@@ -127,24 +222,87 @@ static void state_options_menu(const Keys& k)
     draw_options_menu(g.state, options_index);
     handle_audio_options_navigation(k, options_index);
 
+    if (k.R1) {
+        open_audio_debug();
+        return;
+    }
+
     if (k.A && options_index == 4) {
         audio_sfx_cancel();
         g.state = GameState::State::TitleScreen;
         return;
     }
 
-    if ((k.A && options_index == 5) || k.B) {
+    if ((k.A && options_index == 5) || (k.pressed & EXPANDER_KEY_B)) {
         audio_sfx_validate();
         g.state = GameState::State::Playing;
         audio_settings_save();
     }
 }
 
+static void state_audio_debug(const Keys& k)
+{
+    gfx_clear(COLOR_BLACK);
+    draw_audio_debug_page();
+
+    // Résumé console toutes les 5 s (200 frames) tant que la page est ouverte
+    if (audio_debug_frames++ % 200 == 0)
+        audio_log_stats();
+
+    if (nav_cooldown > 0)
+        nav_cooldown--;
+
+    if (nav_cooldown == 0)
+    {
+        uint32_t target = audio_get_fifo_fill_target();
+        if (k.left && target > 1) {
+            audio_set_fifo_fill_target(target - 1);
+            audio_sfx_click();
+            nav_cooldown = 8;
+        }
+        if (k.right && target < GB_AUDIO_BUFFER_FIFO_COUNT) {
+            audio_set_fifo_fill_target(target + 1);
+            audio_sfx_click();
+            nav_cooldown = 8;
+        }
+        if (k.A) {
+            audio_reset_stats();
+            audio_sfx_validate();
+            nav_cooldown = 8;
+        }
+    }
+
+    if (k.pressed & EXPANDER_KEY_B) {
+        audio_sfx_cancel();
+        nav_cooldown = 8;
+        g.state = audio_debug_return;
+    }
+}
+
 static void state_paused(const Keys& k)
 {
     gfx_text(70, 140, "PRESS A TO PLAY", COLOR_WHITE);
     gfx_text(20, 160, "Pause - Appuyez sur A pour reprendre", COLOR_WHITE);
 
+    // Save-state (slot 0 sur la carte SD) : R1 sauvegarde, L1 recharge
+    if (k.pressed & EXPANDER_KEY_R1) {
+        snapshot_msg = snapshot_save_slot(g, 0) ? "STATE SAVED" : "SAVE FAILED";
+    }
+
+    if (k.pressed & EXPANDER_KEY_L1) {
+        if (snapshot_load_slot(g, 0)) {
+            rewind_clear();
+            g.state = GameState::State::Paused;
+            game_draw(g);
+            snapshot_msg = "STATE LOADED";
+        }
+        else
+            snapshot_msg = "NO STATE";
+    }
+
+    if (snapshot_msg)
+        gfx_text(90, 180, snapshot_msg, COLOR_YELLOW);
+
     if (k.A) {
         audio_sfx_validate();
         g.state = GameState::State::Playing;
@@ -181,7 +339,7 @@ void task_game(void* param)
     // Initialisation du moteur
     game_init(g);
 
-    const int FRAME_US = 25000; // 40 FPS
+    const int FRAME_US = GAME_FRAME_US; // 40 FPS
     int64_t last = esp_timer_get_time();
 
     while (true)
@@ -193,10 +351,26 @@ void task_game(void* param)
 		{
 			last = now;
 
+			// Photo publiée par la tâche input : aucune lecture I2C / ADC ici
 			Keys k;
-			input_poll(k);
-
-			switch (g.state)
+			input_read(k);
+			g.input = k;
+
+			// Étiquette des allocations C++ de la frame (core/mem_track.h)
+			bool in_game = g.state == GameState::State::StartingLevel ||
+			               g.state == GameState::State::Playing ||
+			               g.state == GameState::State::PacmanDying ||
+			               g.state == GameState::State::Paused;
+			MemScope mem_scope(in_game ? MemTag::Game : MemTag::Ui);
+
+			bool link_play = netplay_active() &&
+			                 (g.state == GameState::State::StartingLevel ||
+			                  g.state == GameState::State::Playing ||
+			                  g.state == GameState::State::PacmanDying);
+
+			if (link_play)
+				state_netplay(k);
+			else switch (g.state)
 			{
 				case GameState::State::TitleScreen:   state_title_screen(k);   break;
 				case GameState::State::StartingLevel: state_starting_level(k); break;
@@ -204,6 +378,7 @@ void task_game(void* param)
 				case GameState::State::PacmanDying:   state_pacman_dying(k);   break;
 				case GameState::State::Options:       state_options(k);        break;
 				case GameState::State::OptionsMenu:   state_options_menu(k);   break;
+				case GameState::State::AudioDebug:    state_audio_debug(k);    break;
 				case GameState::State::Paused:        state_paused(k);         break;
 				case GameState::State::Highscores:    state_highscores(k);     break;
 				case GameState::State::GameOver:      state_gameover(k);       break;
@@ -213,6 +388,8 @@ void task_game(void* param)
 			}
 
 			gfx_flush();
+
+			telemetry_frame((uint32_t)dt, (uint32_t)(esp_timer_get_time() - now));
 		}
 		else
 		{
@@ -1,39 +1,128 @@
 /*
 ============================================================
-  task_input.cpp — Tâche input (100 Hz)
+  task_input.cpp — Tâche input (interruption ou scrutation)
 ------------------------------------------------------------
 Cette tâche exécute :
- - input_poll(g_keys)
+ - input_poll(k)      : lecture I2C + ADC
+ - input_publish(k)   : photo + événements horodatés
+                        (cf. core/input.h)
 
-Elle met à jour l’état global des touches 100 fois par seconde,
-ce qui garantit une excellente réactivité même si le jeu tourne
-à 60 FPS.
+C'est le seul endroit où le matériel est lu ; le jeu ne fait
+que lire la dernière photo publiée.
+
+Deux modes, la tâche est toujours bloquée entre deux lectures
+(plus d'attente active sur le cœur 1) :
+ - INT : si la sortie INT des expanders est câblée
+   (EXPANDER_INT_GPIO), la tâche dort jusqu'à l'interruption
+   « entrée modifiée » ; l'I2C n'est lu que sur changement
+   (plus une relecture de sécurité toutes les 100 ms).
+   Les événements portent l'instant de l'interruption.
+ - scrutation adaptative : 5 ms tant qu'une touche est tenue
+   ou vient de changer, 20 ms au repos.
+Le joystick (analogique) suit la même cadence active / repos.
+
+Le tick FreeRTOS est à 100 Hz : une attente de 5 ms en ticks
+durerait 10 ms. La cadence active est donc donnée par un
+esp_timer one-shot (µs) qui réveille la tâche ; l'attente en
+ticks ne sert plus que de garde-fou.
 ============================================================
 */
 
 #include "task_input.h"
 #include "core/input.h"
+#include "lib/expander.h"
 #include "esp_timer.h"
-#include "esp_rom_sys.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+
+static const int64_t ACTIVE_US      = 5000;      // touche tenue / changement récent
+static const int     IDLE_MS        = 20;        // repos
+static const int64_t ACTIVE_HOLD_US = 250000;    // reste « actif » après un changement
+static const int64_t INT_SAFETY_US  = 100000;    // relecture I2C même sans INT
+static const int     JOY_ACTIVE     = 500;       // mV autour du centre
+
+// Bits de notification de la tâche
+static const uint32_t WAKE_IRQ   = 1u << 0;      // INT des expanders
+static const uint32_t WAKE_TIMER = 1u << 1;      // fin de la période active
+
+static TaskHandle_t       s_task        = nullptr;
+static esp_timer_handle_t s_timer       = nullptr;
+static volatile int64_t   s_irq_time_us = 0;
+
+static void IRAM_ATTR expander_isr(void*)
+{
+    s_irq_time_us = esp_timer_get_time();
+
+    BaseType_t woken = pdFALSE;
+    xTaskNotifyFromISR(s_task, WAKE_IRQ, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void active_timer_cb(void*)
+{
+    xTaskNotify(s_task, WAKE_TIMER, eSetBits);
+}
+
+static TickType_t ms_to_ticks(int ms)
+{
+    TickType_t t = pdMS_TO_TICKS(ms);
+    return t ? t : 1;    // tick à 100 Hz : jamais 0 (sinon boucle active)
+}
 
 void task_input(void* param)
 {
-    const int INPUT_US = 10000; // 100 Hz
-    int64_t last = esp_timer_get_time();
+    s_task = xTaskGetCurrentTaskHandle();
+    bool use_int = (expander_int_enable(expander_isr, nullptr) == 0);
+    printf("INPUT: %s\n", use_int ? "interruption INT des expanders"
+                                  : "scrutation adaptative");
+
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = active_timer_cb;
+    timer_args.name     = "input_active";
+    if (esp_timer_create(&timer_args, &s_timer) != ESP_OK) {
+        s_timer = nullptr;
+        printf("INPUT: pas de timer µs, cadence active au tick (10 ms)\n");
+    }
+
+    int64_t last_keys_us   = -INT_SAFETY_US;     // première lecture immédiate
+    int64_t last_change_us = 0;
+    bool    held           = false;
 
     while (true)
     {
-        int64_t now = esp_timer_get_time();
-        int64_t dt = now - last;
-
-        if (dt >= INPUT_US)
-        {
-            last = now;
-            input_poll(g_keys);
-        }
-        else
-        {
-            esp_rom_delay_us(2000);
-        }
+        int64_t now    = esp_timer_get_time();
+        bool    active = held || (now - last_change_us < ACTIVE_HOLD_US);
+
+        // Actif : réveil par le timer µs (IDLE_MS en garde-fou) ; repos : en ticks
+        if (active && s_timer)
+            esp_timer_start_once(s_timer, ACTIVE_US);
+
+        TickType_t timeout = (active && !s_timer) ? 1 : ms_to_ticks(IDLE_MS);
+        uint32_t   bits    = 0;
+        xTaskNotifyWait(0, WAKE_IRQ | WAKE_TIMER, &bits, timeout);
+        if (active && s_timer)
+            esp_timer_stop(s_timer);    // déjà expiré si réveil par le timer
+        bool irq = (bits & WAKE_IRQ) != 0;
+        now = esp_timer_get_time();
+
+        // En mode INT, l'I2C n'est lu que si une entrée a changé
+        bool read_keys = !use_int || irq || expander_int_pending() ||
+                         (now - last_keys_us >= INT_SAFETY_US);
+
+        Keys k;
+        input_poll(k, read_keys);
+        if (read_keys)
+            last_keys_us = now;
+
+        if (k.pressed | k.released)
+            last_change_us = now;
+
+        held = (k.raw != 0) ||
+               (k.joxx < JOYX_MID - JOY_ACTIVE) || (k.joxx > JOYX_MID + JOY_ACTIVE) ||
+               (k.joxy < JOYX_MID - JOY_ACTIVE) || (k.joxy > JOYX_MID + JOY_ACTIVE);
+
+        input_publish(k, irq ? s_irq_time_us : now);
     }
 }
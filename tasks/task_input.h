@@ -3,16 +3,15 @@
 
 /*
 ============================================================
-  task_input.h — Tâche input (100 Hz)
+  task_input.h — Tâche input (interruption ou scrutation)
 ------------------------------------------------------------
 Cette tâche exécute :
- - input_poll(g_keys)
+ - input_poll(k) puis input_publish(k)
 
-Elle met à jour l’état global des touches 100 fois par seconde,
-ce qui garantit une excellente réactivité même si le jeu tourne
-à 60 FPS.
-
-La variable globale g_keys est déclarée ici.
+Elle dort jusqu’à l’interruption INT des expanders (ou
+scrute toutes les 5 / 20 ms selon l’activité) et publie l’état
+des touches ; le jeu le lit avec input_read() /
+input_snapshot() (core/input.h).
 ============================================================
 */
 
@@ -0,0 +1,27 @@
+/*
+============================================================
+  task_telemetry.cpp — Tâche télémétrie (basse priorité)
+------------------------------------------------------------
+Cette tâche exécute :
+ - telemetry_send() : relevé + un paquet UDP
+
+Période fixe (vTaskDelayUntil) ; priorité 1 : elle ne prend
+que le temps laissé libre par le jeu, l'audio et l'input.
+============================================================
+*/
+
+#include "task_telemetry.h"
+#include "core/telemetry.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+void task_telemetry(void* param)
+{
+    TickType_t last = xTaskGetTickCount();
+
+    while (true)
+    {
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(TELEMETRY_PERIOD_MS));
+        telemetry_send();
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+/*
+============================================================
+  task_telemetry.h — Tâche télémétrie (basse priorité)
+------------------------------------------------------------
+Envoie une mesure (core/telemetry.h) toutes les
+TELEMETRY_PERIOD_MS. telemetry_start() doit avoir été appelé.
+============================================================
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void task_telemetry(void* param);
+
+#ifdef __cplusplus
+}
+#endif
@@ -155,7 +155,7 @@ Affiche les valeurs brutes + directions interprétées.
 void test_joystick()
 {
     Keys k{};
-    input_poll(k);
+    input_snapshot(k);
 
     lcd_clear(COLOR_BLACK);
 
@@ -165,11 +165,11 @@ void test_joystick()
     snprintf(buf, sizeof(buf), "Joy X: %4d   Joy Y: %4d", k.joxx, k.joxy);
     gfx_text(10, 40, buf, COLOR_LIGHTBLUE);
 
-    const int DEADZONE = 500;
-    bool joyLeft  = (k.joxx < 2048 - DEADZONE);
-    bool joyRight = (k.joxx > 2048 + DEADZONE);
-    bool joyUp    = (k.joxy > 2048 + DEADZONE);
-    bool joyDown  = (k.joxy < 2048 - DEADZONE);
+    // Directions après zone morte + hystérésis (core/input)
+    bool joyLeft  = (k.joy_x < 0);
+    bool joyRight = (k.joy_x > 0);
+    bool joyUp    = (k.joy_y > 0);
+    bool joyDown  = (k.joy_y < 0);
 
     snprintf(buf, sizeof(buf), "Dir L:%s R:%s U:%s D:%s",
              joyLeft  ? "ON" : "OFF",
@@ -0,0 +1,8 @@
+#pragma once
+// Build hôte (tools/host) : remplace esp_err.h de l'ESP-IDF,
+// codes de retour seulement.
+
+typedef int esp_err_t;
+
+#define ESP_OK   0
+#define ESP_FAIL -1
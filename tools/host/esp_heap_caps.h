@@ -0,0 +1,13 @@
+#pragma once
+// Build hôte (tools/host) : remplace esp_heap_caps.h de l'ESP-IDF,
+// tas unique (malloc), capacités ignorées.
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+inline void* heap_caps_malloc(size_t bytes, uint32_t) { return malloc(bytes); }
+inline void  heap_caps_free(void* p)                  { free(p); }
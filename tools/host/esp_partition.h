@@ -0,0 +1,32 @@
+#pragma once
+// Build hôte (tools/host) : remplace esp_partition.h de l'ESP-IDF,
+// aucune partition : level_pack passe à la carte SD
+// (absente sur l'hôte), donc aux niveaux intégrés.
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef uint32_t esp_partition_mmap_handle_t;
+typedef enum { ESP_PARTITION_TYPE_DATA = 0x01 } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY = 0xff } esp_partition_subtype_t;
+typedef enum { ESP_PARTITION_MMAP_DATA } esp_partition_mmap_memory_t;
+
+typedef struct {
+    uint32_t    address;
+    uint32_t    size;
+    const char* label;
+} esp_partition_t;
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t,
+                                                       const char*)
+{
+    return nullptr;
+}
+
+inline esp_err_t esp_partition_mmap(const esp_partition_t*, size_t, size_t, esp_partition_mmap_memory_t,
+                                    const void**, esp_partition_mmap_handle_t*)
+{
+    return ESP_FAIL;
+}
+
+inline void esp_partition_munmap(esp_partition_mmap_handle_t) {}
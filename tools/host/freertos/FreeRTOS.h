@@ -0,0 +1,11 @@
+#pragma once
+// Build hôte (tools/host) : remplace freertos/FreeRTOS.h de l'ESP-IDF,
+// types seulement (déclarations de lib/audio_*.h,
+// jamais appelées par la logique du jeu).
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void*    TaskHandle_t;
+typedef void*    QueueHandle_t;
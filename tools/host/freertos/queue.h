@@ -0,0 +1,4 @@
+#pragma once
+// Build hôte (tools/host) : remplace freertos/queue.h de l'ESP-IDF,
+// cf. FreeRTOS.h.
+#include "FreeRTOS.h"
@@ -0,0 +1,64 @@
+/*
+============================================================
+  host_stubs.cpp — Matériel factice pour les builds hôte
+------------------------------------------------------------
+Permet de compiler la vraie logique du jeu (dossier game/) sous
+Linux : l'audio et l'écran appelés par game_update /
+game_draw deviennent des fonctions vides, les en-têtes
+ESP-IDF sont remplacés par ceux de tools/host.
+
+ - son : aucun, audio_wav_is_playing() toujours false (les
+   attentes de BEGIN / DEATH durent 0 frame) ;
+ - musique : audioPMF ne joue rien ;
+ - dessin : la draw list est émise puis ignorée.
+
+Utilisé par tools/netplay_loopback.cpp.
+============================================================
+*/
+#include "core/audio.h"
+#include "core/graphics.h"
+#include "core/sprite.h"
+#include "game/maze_view.h"
+#include "lib/audio_pmf.h"
+
+/*
+============================================================
+  AUDIO
+============================================================
+*/
+AudioSettings g_audio_settings;
+AudioPMF      audioPMF;
+
+bool audio_wav_is_playing(void) { return false; }
+
+void audio_play_pacgomme(void) {}
+void audio_play_power(void)    {}
+void audio_play_eatghost(void) {}
+void audio_play_death(void)    {}
+void audio_play_begin(void)    {}
+
+pmf_player::pmf_player() {}
+pmf_player::~pmf_player() {}
+bool pmf_player::is_playing() const { return false; }
+
+pmf_prerender::pmf_prerender() : job(nullptr) {}
+pmf_prerender::~pmf_prerender() {}
+
+void AudioPMF::init(const uint8_t*)      {}
+void AudioPMF::start(uint32_t, uint16_t) {}
+void AudioPMF::stop()                    {}
+void AudioPMF::setTempo(uint16_t)        {}
+void AudioPMF::setPrerender(bool, pmf_prerender_format, uint16_t) {}
+
+/*
+============================================================
+  ÉCRAN
+============================================================
+*/
+void draw_sprite16(int, int, const uint16_t*) {}
+
+void gfx_sprite_clip(int, int, const uint16_t*, int, int, uint16_t, const GfxClip&) {}
+void gfx_fill_rect_clip(int, int, int, int, uint16_t, const GfxClip&)             {}
+void gfx_text_clip(int, int, const char*, uint16_t, const GfxClip&)               {}
+
+void maze_view_draw(const Maze&, int, int) {}
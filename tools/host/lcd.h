@@ -0,0 +1,5 @@
+#pragma once
+// Build hôte (tools/host) : remplace lcd.h de l'ESP-IDF,
+// sensible à la casse : lib/graphics_basic.h inclut
+// "lcd.h", le fichier s'appelle lib/LCD.h.
+#include "lib/LCD.h"
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+make_level_pack.py — Génère le pack binaire de niveaux (cf. game/level_pack.h)
+
+Chaque niveau est un fichier texte ASCII (mêmes caractères que maze_from_ascii) :
+
+    # mur           . pac-gomme        o super pac-gomme
+    H maison        D porte fantôme    P départ Pac-Man
+    T tunnel        E entrée de tunnel F fruit
+
+Les lignes commençant par ';' sont des directives optionnelles :
+
+    ; speed pacman=3 ghost=2.8125 tunnel=1.5 frightened=1.875 eyes=4
+    ; frightened_ticks=360
+
+Les vitesses sont en pixels/frame (décimales acceptées, stockées en 8.8).
+Par défaut : table arcade du niveau 1 (80 / 75 / 40 / 50 % de 3,75 px/frame).
+
+Utilisation :
+    python3 tools/make_level_pack.py levels/*.txt -o levels.pak
+
+Copier ensuite levels.pak sur la carte SD (/sdcard/PAKAMAN/levels.pak)
+ou l'écrire dans la partition flash "levels" :
+    parttool.py write_partition --partition-name levels --input levels.pak
+"""
+
+import argparse
+import struct
+import sys
+
+VERSION = 1
+RECORD_HEADER = 40
+MAX_COLS = 32       # MAZE_MAX_COLS / MAZE_MAX_ROWS (game/maze.h)
+MAX_ROWS = 36
+
+TILES = {
+    ' ': 0, '#': 1, '.': 2, 'o': 3, 'H': 4, 'D': 5,
+    'T': 8, 'E': 9, 'P': 10, 'F': 11,
+}
+
+DEFAULT_SPEEDS = {
+    'pacman': 3, 'ghost': 2.8125, 'tunnel': 1.5, 'frightened': 1.875, 'eyes': 4,
+}
+DEFAULT_FRIGHTENED_TICKS = 360
+
+
+def parse_level(path):
+    rows = []
+    speeds = dict(DEFAULT_SPEEDS)
+    frightened_ticks = DEFAULT_FRIGHTENED_TICKS
+
+    with open(path, encoding='utf-8') as f:
+        for raw in f:
+            line = raw.rstrip('\r\n')
+            if line.startswith(';'):
+                for item in line[1:].split():
+                    if '=' not in item:
+                        continue
+                    key, value = item.split('=', 1)
+                    if key == 'frightened_ticks':
+                        frightened_ticks = int(value)
+                    elif key in speeds:
+                        speeds[key] = float(value)
+                    else:
+                        sys.exit(f'{path}: directive inconnue {key}')
+                continue
+            if line:
+                rows.append(line)
+
+    if not rows:
+        sys.exit(f'{path}: niveau vide')
+    cols = len(rows[0])
+    if any(len(r) != cols for r in rows):
+        sys.exit(f'{path}: lignes de longueurs différentes')
+    if cols > MAX_COLS or len(rows) > MAX_ROWS:
+        sys.exit(f'{path}: niveau trop grand ({cols}x{len(rows)}, max {MAX_COLS}x{MAX_ROWS})')
+
+    # Mêmes règles que maze_from_ascii()
+    tiles = bytearray()
+    pac = (0, 0)
+    fruit = (0xFF, 0xFF)
+    door = (0, 0)
+    house = []
+    tunnels = []
+    pellets = power = 0
+
+    for r, line in enumerate(rows):
+        for c, ch in enumerate(line):
+            if ch not in TILES:
+                ch = ' '
+            tiles.append(TILES[ch])
+            if ch == '.':
+                pellets += 1
+            elif ch == 'o':
+                power += 1
+            elif ch == 'H':
+                house.append((r, c))
+            elif ch == 'D':
+                door = (r, c)
+            elif ch == 'E' and len(tunnels) < 2:
+                tunnels.append((r, c))
+            elif ch == 'P':
+                pac = (r, c)
+            elif ch == 'F':
+                fruit = (r, c)
+
+    if not house:
+        sys.exit(f'{path}: pas de maison fantôme')
+    center = (sum(h[0] for h in house) // len(house),
+              sum(h[1] for h in house) // len(house))
+    spawns = (house + [(0, 0)] * 4)[:4]
+    tun = tunnels + [(0, 0)] * (2 - len(tunnels))
+
+    def fp(v):
+        return max(0, min(0xFFFF, int(round(v * 256))))
+
+    rec = struct.pack('<BBBBBBBBBB', cols, len(rows), pac[0], pac[1],
+                      fruit[0], fruit[1], door[0], door[1], center[0], center[1])
+    rec += bytes(s[0] for s in spawns) + bytes(s[1] for s in spawns)
+    rec += struct.pack('<BBBBBB', len(tunnels), tun[0][0], tun[1][0],
+                       tun[0][1], tun[1][1], 0)
+    rec += struct.pack('<HH', pellets, power)
+    rec += struct.pack('<HHHHHH', fp(speeds['pacman']), fp(speeds['ghost']),
+                       fp(speeds['tunnel']), fp(speeds['frightened']),
+                       fp(speeds['eyes']), frightened_ticks)
+    assert len(rec) == RECORD_HEADER
+    return rec + tiles
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Génère un pack de niveaux pAKAman')
+    ap.add_argument('levels', nargs='+', help='fichiers ASCII, dans l\'ordre de jeu')
+    ap.add_argument('-o', '--output', default='levels.pak')
+    args = ap.parse_args()
+
+    records = [parse_level(p) for p in args.levels]
+
+    header_size = 16
+    index_offset = header_size
+    data_offset = index_offset + 8 * len(records)
+
+    index = bytearray()
+    data = bytearray()
+    for rec in records:
+        index += struct.pack('<II', data_offset + len(data), len(rec))
+        data += rec
+        data += b'\0' * (-len(data) % 4)
+
+    header = b'PKLV' + struct.pack('<HHII', VERSION, len(records), index_offset, 0)
+    with open(args.output, 'wb') as f:
+        f.write(header + index + data)
+
+    print(f'{args.output}: {len(records)} niveaux, {len(header) + len(index) + len(data)} octets')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,138 @@
+/*
+============================================================
+  maze_bench.cpp — Banc d'essai hôte du générateur de labyrinthes
+------------------------------------------------------------
+Génère des milliers de labyrinthes (game/maze_gen.cpp) et
+vérifie chacun avec maze_validate (symétrie, culs-de-sac,
+connexité BFS avec tunnels), puis affiche les temps.
+
+Compilation (depuis la racine du dépôt) :
+    g++ -O2 -std=c++17 -I. -Igame tools/maze_bench.cpp game/maze_gen.cpp -o maze_bench
+
+Utilisation :
+    ./maze_bench [nombre=10000] [graine_initiale=1] [-v] [-s 28x31]
+
+  -v : affiche le premier labyrinthe en ASCII
+  -s : dimensions (colonnes x lignes), 20x21 par défaut
+============================================================
+*/
+#include "game/maze_gen.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char tile_char(TileType t)
+{
+    switch (t)
+    {
+        case TileType::Wall:            return '#';
+        case TileType::Pellet:          return '.';
+        case TileType::PowerPellet:     return 'o';
+        case TileType::GhostHouse:      return 'H';
+        case TileType::GhostDoorClosed:
+        case TileType::GhostDoorOpening:
+        case TileType::GhostDoorOpen:   return 'D';
+        case TileType::Tunnel:          return 'T';
+        case TileType::TunnelEntry:     return 'E';
+        case TileType::PacSpawn:        return 'P';
+        case TileType::FruitSpawn:      return 'F';
+        default:                        return ' ';
+    }
+}
+
+static void print_maze(const Maze& m)
+{
+    for (int r = 0; r < m.rows; r++)
+    {
+        for (int c = 0; c < m.cols; c++)
+            putchar(tile_char(m.tiles[r][c]));
+        putchar('\n');
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int      count   = 10000;
+    uint32_t first   = 1;
+    bool     verbose = false;
+    int      cols    = MAZE_WIDTH;
+    int      rows    = MAZE_HEIGHT;
+
+    int pos = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-v") == 0)
+            verbose = true;
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            sscanf(argv[++i], "%dx%d", &cols, &rows);
+        else if (pos++ == 0)
+            count = atoi(argv[i]);
+        else
+            first = (uint32_t)strtoul(argv[i], nullptr, 0);
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    int    failed_gen = 0;
+    int    failed_val = 0;
+    double total_us   = 0.0;
+    double max_us     = 0.0;
+    long   pellets    = 0;
+    int    min_pellets = 1 << 30, max_pellets = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        MazeGenParams params;
+        params.seed = first + (uint32_t)i;
+        params.cols = cols;
+        params.rows = rows;
+
+        Maze m;
+        memset(m.tiles, 0, sizeof(m.tiles));
+
+        auto t0 = clock::now();
+        bool ok = maze_generate(params, m);
+        auto t1 = clock::now();
+
+        double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        total_us += us;
+        if (us > max_us) max_us = us;
+
+        if (!ok) {
+            failed_gen++;
+            printf("graine %u : génération impossible\n", (unsigned)params.seed);
+            continue;
+        }
+
+        // Re-vérification indépendante
+        const char* reason = nullptr;
+        if (!maze_validate(m, &reason)) {
+            failed_val++;
+            printf("graine %u : invalide (%s)\n", (unsigned)params.seed, reason);
+            print_maze(m);
+            continue;
+        }
+
+        pellets += m.pellet_count;
+        if (m.pellet_count < min_pellets) min_pellets = m.pellet_count;
+        if (m.pellet_count > max_pellets) max_pellets = m.pellet_count;
+
+        if (verbose && i == 0) {
+            printf("graine %u :\n", (unsigned)params.seed);
+            print_maze(m);
+        }
+    }
+
+    int valid = count - failed_gen - failed_val;
+    printf("\n%d labyrinthes %dx%d, %d valides, %d échecs de génération, %d invalides\n",
+           count, cols, rows, valid, failed_gen, failed_val);
+    printf("temps : moyen %.1f us, max %.1f us\n",
+           count ? total_us / count : 0.0, max_us);
+    if (valid > 0)
+        printf("pac-gommes : moyenne %ld, min %d, max %d\n",
+               pellets / valid, min_pellets, max_pellets);
+    printf("mémoire : Maze %u octets\n", (unsigned)sizeof(Maze));
+
+    return (failed_gen || failed_val) ? 1 : 0;
+}
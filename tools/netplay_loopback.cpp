@@ -0,0 +1,158 @@
+/*
+============================================================
+  netplay_loopback.cpp — Essai hôte du jeu à 2 (lockstep)
+------------------------------------------------------------
+Lance deux builds Linux de la logique du jeu (un processus
+par joueur, fork) reliés en UDP sur 127.0.0.1, avec le même
+code réseau que la console (game/netplay.cpp) et les mêmes
+photos (game/snapshot.cpp).
+
+La frame est le vrai game_update (game/game.cpp : IA des
+fantômes, porte et timers, frightened, scores flottants,
+changements de niveau) ; l'audio et l'écran qu'il appelle
+sont remplacés par tools/host (host_stubs.cpp + en-têtes
+ESP-IDF factices).
+
+Chaque joueur suit un script d'entrées pseudo-aléatoire et
+s'endort au hasard (gigue) plus longtemps que le retard
+d'entrée : les entrées du pair arrivent en retard, la
+prédiction se trompe et le rollback recharge une photo puis
+resimule. L'essai échoue si aucun rollback n'a eu lieu, si un
+CRC échangé toutes les NETPLAY_CHECK_INTERVAL frames diffère,
+ou si la partie n'avance pas jusqu'au bout.
+
+Compilation (depuis la racine du dépôt) :
+    g++ -O2 -std=c++17 -I. -Ilib -Itools/host tools/netplay_loopback.cpp \
+        tools/host/host_stubs.cpp game/game.cpp game/level.cpp game/pacman.cpp \
+        game/ghost.cpp game/maze.cpp game/levels_preset.cpp game/level_pack.cpp \
+        game/maze_gen.cpp game/config.cpp game/netplay.cpp game/snapshot.cpp \
+        core/frame_arena.cpp core/draw_list.cpp assets/assets.cpp -o netplay_loopback
+
+Utilisation :
+    ./netplay_loopback [frames=1200] [gigue_ms=150] [-d]
+
+  -d : le joueur 2 diverge volontairement (vérifie la détection)
+============================================================
+*/
+#include "game/game.h"
+#include "game/netplay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+static GameState g;
+static bool      s_diverge = false;
+
+static int64_t now_us()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint32_t xorshift(uint32_t& s)
+{
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Frame de la partie : game_update, plus l'écart volontaire de -d
+static void link_step(GameState& g)
+{
+    game_update(g);
+
+    if (s_diverge && g.elapsed_ticks == 100)
+        g.score++;
+}
+
+/*
+============================================================
+  UN JOUEUR
+============================================================
+*/
+static int run_player(int player, uint32_t frames, int jitter_ms)
+{
+    // Comme start_link_play (tasks/task_game.cpp)
+    game_init(g);
+    g.state = GameState::State::StartingLevel;
+
+    s_diverge = s_diverge && player == 1;
+
+    if (!netplay_start(g, player, "127.0.0.1", link_step, now_us()))
+        return 1;
+
+    uint32_t script = 0x1234567u + player * 977u;
+    uint8_t  input  = 0;
+    uint32_t next_change = 0;
+
+    int64_t end_us = 0;
+    int64_t limit  = now_us() + (int64_t)frames * NETPLAY_TICK_US * 4 + 5000000;
+    while (now_us() < limit)
+    {
+        // Script : une direction (et parfois A) tous les 3 à 20 frames
+        if (netplay_frame() >= next_change) {
+            static const uint8_t dirs[4] = { NET_IN_LEFT, NET_IN_RIGHT, NET_IN_UP, NET_IN_DOWN };
+            input = dirs[xorshift(script) % 4] | ((xorshift(script) % 8 == 0) ? NET_IN_A : 0);
+            next_change = netplay_frame() + 3 + xorshift(script) % 18;
+        }
+
+        netplay_update(g, input, now_us());
+
+        // Fin : on continue d'émettre un moment pour que le pair confirme
+        if (!end_us && netplay_frame() >= frames)
+            end_us = now_us() + 1000000;
+        if (end_us && now_us() > end_us)
+            break;
+
+        // Gigue : sommeils plus longs que le tick, de temps en temps
+        if (jitter_ms > 0 && xorshift(script) % 40 == 0)
+            usleep(1000 * (1 + xorshift(script) % jitter_ms));
+        else
+            usleep(1000);
+    }
+
+    const NetplayStats& s = netplay_stats();
+    printf("joueur %d : frame %u  niveau %d  score %d  vies %d  état %d  envoyés %u  reçus %u\n"
+           "           rollbacks %u (%u frames resimulées)  attentes %u/%u  CRC %u comparés, %u différents\n",
+           player, (unsigned)netplay_frame(), g.level, g.score, g.lives, (int)g.state,
+           (unsigned)s.sent, (unsigned)s.received,
+           (unsigned)s.rollbacks, (unsigned)s.resim_frames,
+           (unsigned)s.stalls, (unsigned)s.waits,
+           (unsigned)s.checks, (unsigned)s.desyncs);
+
+    bool ok = netplay_frame() >= frames && s.checks > 0 && s.desyncs == 0 && s.rollbacks > 0;
+    if (s.rollbacks == 0)
+        printf("joueur %d : aucun rollback, gigue trop faible pour l'essai\n", player);
+    netplay_stop();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames    = 1200;
+    int      jitter_ms = 150;    // > retard d'entrée (NETPLAY_INPUT_DELAY ticks)
+    int      pos       = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-d"))  s_diverge = true;
+        else if (pos++ == 0)         frames    = (uint32_t)atoi(argv[i]);
+        else                         jitter_ms = atoi(argv[i]);
+    }
+
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0)
+        return run_player(1, frames, jitter_ms);
+
+    int rc0 = run_player(0, frames, jitter_ms);
+    int status = 0;
+    waitpid(child, &status, 0);
+    int rc1 = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+
+    printf("%s\n", (rc0 == 0 && rc1 == 0) ? "OK : parties identiques" : "ÉCHEC");
+    return (rc0 == 0 && rc1 == 0) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/*
+============================================================
+  snapshot_tool.cpp — Lecture hôte des save-states
+------------------------------------------------------------
+Recharge un fichier stateN.sav (copié de la carte SD) avec le
+même code que la console (game/snapshot.cpp), vérifie l'en-tête,
+la version et le CRC, puis affiche l'état : niveau, score,
+acteurs et labyrinthe en ASCII.
+
+Compilation (depuis la racine du dépôt) :
+    g++ -O2 -std=c++17 -I. -Igame tools/snapshot_tool.cpp game/snapshot.cpp -o snapshot_tool
+
+Utilisation :
+    ./snapshot_tool state0.sav            résumé + labyrinthe
+    ./snapshot_tool a.sav b.sav           différences entre deux états
+    ./snapshot_tool -r state0.sav         resauvegarde et compare (aller-retour)
+============================================================
+*/
+#include "game/game.h"
+#include "game/snapshot.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Seules les structures sont utilisées : constructeurs minimaux
+// (pacman.cpp / ghost.cpp tirent le rendu et le matériel)
+Pacman::Pacman(int start_col, int start_row)
+    : tile_r(start_row), tile_c(start_col), prev_tile_r(start_row), prev_tile_c(start_col) {}
+
+Ghost::Ghost(int id_, int start_c, int start_r)
+    : Ghost()
+{
+    id = id_;
+    tile_r = start_r;
+    tile_c = start_c;
+    start_row = start_r;
+    start_col = start_c;
+}
+
+static GameState g_a, g_b;
+
+static bool read_file(const char* path, std::vector<uint8_t>& out)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        printf("%s : introuvable\n", path);
+        return false;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+static bool load(const char* path, GameState& g, std::vector<uint8_t>& bytes)
+{
+    if (!read_file(path, bytes))
+        return false;
+    if (!snapshot_load(g, bytes.data(), bytes.size())) {
+        printf("%s : save-state invalide\n", path);
+        return false;
+    }
+    return true;
+}
+
+static char tile_char(TileType t)
+{
+    switch (t)
+    {
+        case TileType::Wall:             return '#';
+        case TileType::Pellet:           return '.';
+        case TileType::PowerPellet:      return 'o';
+        case TileType::GhostHouse:       return 'H';
+        case TileType::GhostDoorClosed:
+        case TileType::GhostDoorOpening:
+        case TileType::GhostDoorOpen:    return '-';
+        case TileType::Tunnel:
+        case TileType::TunnelEntry:      return '=';
+        default:                         return ' ';
+    }
+}
+
+static void print_state(const GameState& g)
+{
+    printf("état %d  niveau %d  score %d  vies %d  frame %d  rng %08X\n",
+           (int)g.state, g.level, g.score, g.lives, g.elapsed_ticks, (unsigned)g.rng);
+    printf("labyrinthe %dx%d  pac-gommes %d  super %d\n",
+           g.maze.cols, g.maze.rows, g.maze.pellet_count, g.maze.power_pellet_count);
+    printf("pacman  (%d,%d) offset %d dir %d\n",
+           g.pacman.tile_r, g.pacman.tile_c, g.pacman.pixel_offset, (int)g.pacman.dir);
+    for (const auto& gh : g.ghosts)
+        printf("fantôme %d (%d,%d) offset %d dir %d mode %d maison %d\n",
+               gh.id, gh.tile_r, gh.tile_c, gh.pixel_offset,
+               (int)gh.dir, (int)gh.mode, (int)gh.houseState);
+
+    for (int r = 0; r < g.maze.rows; r++)
+    {
+        char line[MAZE_MAX_COLS + 1];
+        for (int c = 0; c < g.maze.cols; c++)
+            line[c] = tile_char(g.maze.tiles[r][c]);
+        line[g.maze.cols] = 0;
+
+        for (const auto& gh : g.ghosts)
+            if (gh.tile_r == r)
+                line[gh.tile_c] = (char)('0' + gh.id);
+        if (g.pacman.tile_r == r)
+            line[g.pacman.tile_c] = 'C';
+        printf("  %s\n", line);
+    }
+}
+
+// Deux états : resauvegarde et compare octet par octet
+static int diff_states(const GameState& a, const GameState& b)
+{
+    static uint8_t ba[SNAPSHOT_MAX_BYTES], bb[SNAPSHOT_MAX_BYTES];
+    size_t na = snapshot_save(a, ba, sizeof(ba));
+    size_t nb = snapshot_save(b, bb, sizeof(bb));
+
+    if (a.score != b.score)   printf("score    %d -> %d\n", a.score, b.score);
+    if (a.level != b.level)   printf("niveau   %d -> %d\n", a.level, b.level);
+    if (a.lives != b.lives)   printf("vies     %d -> %d\n", a.lives, b.lives);
+    if (a.elapsed_ticks != b.elapsed_ticks)
+        printf("frame    %d -> %d\n", a.elapsed_ticks, b.elapsed_ticks);
+    if (a.pacman.tile_r != b.pacman.tile_r || a.pacman.tile_c != b.pacman.tile_c)
+        printf("pacman   (%d,%d) -> (%d,%d)\n",
+               a.pacman.tile_r, a.pacman.tile_c, b.pacman.tile_r, b.pacman.tile_c);
+
+    int tiles = 0;
+    for (int r = 0; r < a.maze.rows && r < b.maze.rows; r++)
+        for (int c = 0; c < a.maze.cols && c < b.maze.cols; c++)
+            tiles += a.maze.tiles[r][c] != b.maze.tiles[r][c];
+    if (tiles)
+        printf("cases    %d différente(s)\n", tiles);
+
+    // Contenu seul (l'en-tête contient le CRC)
+    size_t n = na < nb ? na : nb;
+    int bytes = (int)(na > nb ? na - nb : nb - na);
+    for (size_t i = 16; i < n; i++)
+        bytes += ba[i] != bb[i];
+    printf("%d octet(s) différent(s) sur %u\n", bytes, (unsigned)(na > nb ? na : nb));
+    return bytes ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    bool roundtrip = false;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-r")) roundtrip = true;
+        else files.push_back(argv[i]);
+    }
+
+    if (files.empty() || files.size() > 2) {
+        printf("usage : %s [-r] fichier.sav [autre.sav]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> a, b;
+    if (!load(files[0], g_a, a))
+        return 1;
+
+    if (files.size() == 2) {
+        if (!load(files[1], g_b, b))
+            return 1;
+        return diff_states(g_a, g_b);
+    }
+
+    if (roundtrip) {
+        static uint8_t out[SNAPSHOT_MAX_BYTES];
+        size_t n = snapshot_save(g_a, out, sizeof(out));
+        bool same = (n == a.size() && memcmp(out, a.data(), n) == 0);
+        printf("aller-retour : %s (%u octets)\n", same ? "identique" : "DIFFÉRENT", (unsigned)n);
+        return same ? 0 : 1;
+    }
+
+    printf("%s : version %u, %u octets\n", files[0],
+           (unsigned)(a[4] | (a[5] << 8)), (unsigned)a.size());
+    print_state(g_a);
+    return 0;
+}
@@ -0,0 +1,256 @@
+/*
+============================================================
+  telemetry_viewer.cpp — Lecture hôte de la télémétrie UDP
+------------------------------------------------------------
+Écoute le port TELEMETRY_PORT (core/telemetry.h) et affiche
+une ligne par mesure reçue (binaire décodé avec le même code
+que la console, ou JSON tel quel). Signale les mesures
+perdues (trous dans seq) et les nouvelles frames en retard /
+underruns audio.
+
+Compilation (depuis la racine du dépôt) :
+    g++ -O2 -std=c++17 -I. tools/telemetry_viewer.cpp core/telemetry_format.cpp -o telemetry_viewer
+
+Utilisation :
+    ./telemetry_viewer                 écoute (PC connecté au softAP de la console)
+    ./telemetry_viewer -e [n] [-j]     émet n mesures factices vers 127.0.0.1
+    ./telemetry_viewer -t              essai en boucle locale (binaire + JSON)
+============================================================
+*/
+#include "core/telemetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+static int open_socket(uint16_t port)
+{
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    if (s < 0)
+        return -1;
+
+    int yes = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    setsockopt(s, SOL_SOCKET, SO_BROADCAST, &yes, sizeof(yes));
+
+    if (port) {
+        sockaddr_in addr {};
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(s, (const sockaddr*)&addr, sizeof(addr)) < 0) {
+            printf("port %u occupé\n", (unsigned)port);
+            close(s);
+            return -1;
+        }
+    }
+    return s;
+}
+
+// Mesure factice (tâches et chiffres plausibles)
+static void fake_sample(TelemetrySample& s, uint32_t seq)
+{
+    s = TelemetrySample {};
+    s.seq          = seq;
+    s.uptime_ms    = 1000 * seq;
+    s.frames       = 40;
+    s.frame_us_min = 24900;
+    s.frame_us_avg = 25010 + seq % 7;
+    s.frame_us_max = 31000 + 500 * (seq % 3);
+    s.work_us_avg  = 11000;
+    s.work_us_max  = 18000;
+    s.late_frames  = (seq % 5 == 4) ? 1 : 0;
+    s.audio_underruns = seq / 4;
+    s.fifo_used    = 3;
+    s.fifo_count   = 8;
+    s.heap_free    = 180000 - seq;
+    s.heap_min_free = 150000;
+    s.heap_largest = 90000;
+    s.psram_free   = 7000000;
+    s.psram_min_free = 6900000;
+    s.psram_largest = 4000000;
+
+    static const char* names[] = { "GameTask", "InputTask", "audio_task" };
+    static const uint32_t stacks[] = { 2100, 900, 3300 };
+    s.task_count = 3;
+    for (int i = 0; i < 3; i++) {
+        strncpy(s.tasks[i].name, names[i], sizeof(s.tasks[i].name) - 1);
+        s.tasks[i].stack_free = stacks[i];
+    }
+}
+
+static void print_sample(const TelemetrySample& s)
+{
+    printf("#%-5u %7.1fs  frames %2u  %5.1f/%5.1f/%5.1f ms  travail %5.1f/%5.1f ms  retard %u"
+           "  | audio U%u O%u S%u fifo %u/%u"
+           "  | heap %uK (min %uK, bloc %uK)  psram %uK (min %uK)  | pile",
+           (unsigned)s.seq, s.uptime_ms / 1000.0, (unsigned)s.frames,
+           s.frame_us_min / 1000.0, s.frame_us_avg / 1000.0, s.frame_us_max / 1000.0,
+           s.work_us_avg / 1000.0, s.work_us_max / 1000.0, (unsigned)s.late_frames,
+           (unsigned)s.audio_underruns, (unsigned)s.audio_overflows,
+           (unsigned)s.stream_underruns, (unsigned)s.fifo_used, (unsigned)s.fifo_count,
+           (unsigned)(s.heap_free / 1024), (unsigned)(s.heap_min_free / 1024),
+           (unsigned)(s.heap_largest / 1024), (unsigned)(s.psram_free / 1024),
+           (unsigned)(s.psram_min_free / 1024));
+    for (int i = 0; i < s.task_count; i++)
+        printf(" %s %u", s.tasks[i].name, (unsigned)s.tasks[i].stack_free);
+    printf("\n");
+}
+
+/*
+============================================================
+  ÉCOUTE
+============================================================
+*/
+static int listen_loop()
+{
+    int s = open_socket(TELEMETRY_PORT);
+    if (s < 0)
+        return 1;
+    setvbuf(stdout, nullptr, _IOLBF, 0);     // lisible à travers un tube
+    printf("écoute UDP %u\n", (unsigned)TELEMETRY_PORT);
+
+    bool     first = true;
+    uint32_t last_seq = 0, last_underruns = 0;
+    uint8_t  buf[TELEMETRY_MAX_PACKET + 1];
+
+    for (;;)
+    {
+        sockaddr_in from;
+        socklen_t   len = sizeof(from);
+        int n = recvfrom(s, buf, TELEMETRY_MAX_PACKET, 0, (sockaddr*)&from, &len);
+        if (n <= 0)
+            continue;
+
+        if (buf[0] == '{') {
+            buf[n] = 0;
+            printf("%s\n", (const char*)buf);
+            continue;
+        }
+
+        TelemetrySample t;
+        if (!telemetry_decode(t, buf, n)) {
+            printf("paquet invalide (%d octets) de %s\n", n, inet_ntoa(from.sin_addr));
+            continue;
+        }
+
+        if (!first && t.seq != last_seq + 1)
+            printf("  !! %d mesure(s) perdue(s)\n", (int)(t.seq - last_seq - 1));
+        if (!first && t.audio_underruns > last_underruns)
+            printf("  !! %u underrun(s) audio\n", (unsigned)(t.audio_underruns - last_underruns));
+        print_sample(t);
+
+        first          = false;
+        last_seq       = t.seq;
+        last_underruns = t.audio_underruns;
+    }
+}
+
+/*
+============================================================
+  ÉMISSION / ESSAI EN BOUCLE LOCALE
+============================================================
+*/
+static size_t make_packet(const TelemetrySample& t, bool json, uint8_t* buf)
+{
+    return json ? telemetry_to_json(t, (char*)buf, TELEMETRY_MAX_PACKET)
+                : telemetry_encode(t, buf, TELEMETRY_MAX_PACKET);
+}
+
+static int emit(int count, bool json)
+{
+    int s = open_socket(0);
+    if (s < 0)
+        return 1;
+
+    sockaddr_in dest {};
+    dest.sin_family      = AF_INET;
+    dest.sin_port        = htons(TELEMETRY_PORT);
+    dest.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    uint8_t buf[TELEMETRY_MAX_PACKET];
+    for (int i = 0; i < count; i++)
+    {
+        TelemetrySample t;
+        fake_sample(t, i);
+        size_t n = make_packet(t, json, buf);
+        sendto(s, buf, n, 0, (const sockaddr*)&dest, sizeof(dest));
+        usleep(TELEMETRY_PERIOD_MS * 100);    // 10× plus vite que la console
+    }
+    close(s);
+    return 0;
+}
+
+static int self_test()
+{
+    int rx = open_socket(TELEMETRY_PORT);
+    int tx = open_socket(0);
+    if (rx < 0 || tx < 0)
+        return 1;
+
+    timeval tv { 1, 0 };
+    setsockopt(rx, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    sockaddr_in dest {};
+    dest.sin_family      = AF_INET;
+    dest.sin_port        = htons(TELEMETRY_PORT);
+    dest.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    int failures = 0;
+    for (int i = 0; i < 20; i++)
+    {
+        bool json = (i & 1);
+        TelemetrySample t;
+        fake_sample(t, i);
+
+        uint8_t out[TELEMETRY_MAX_PACKET], in[TELEMETRY_MAX_PACKET];
+        size_t n = make_packet(t, json, out);
+        sendto(tx, out, n, 0, (const sockaddr*)&dest, sizeof(dest));
+        int got = recv(rx, in, sizeof(in), 0);
+
+        bool ok = (got == (int)n) && memcmp(in, out, n) == 0;
+        if (ok && !json) {
+            // Décodé puis réencodé : octet pour octet
+            TelemetrySample d;
+            uint8_t again[TELEMETRY_MAX_PACKET];
+            ok = telemetry_decode(d, in, got) &&
+                 telemetry_encode(d, again, sizeof(again)) == n &&
+                 memcmp(again, out, n) == 0;
+        }
+        if (!ok) {
+            printf("mesure %d (%s) : ÉCHEC\n", i, json ? "JSON" : "binaire");
+            failures++;
+        }
+        if (i < 2) {
+            printf("%s, %u octets : ", json ? "JSON" : "binaire", (unsigned)n);
+            if (json) printf("%s\n", (const char*)out);
+            else      print_sample(t);
+        }
+    }
+
+    close(rx);
+    close(tx);
+    printf("%s\n", failures ? "ÉCHEC" : "OK : 20 mesures reçues et décodées");
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && !strcmp(argv[1], "-t"))
+        return self_test();
+
+    if (argc > 1 && !strcmp(argv[1], "-e")) {
+        int  count = 10;
+        bool json  = false;
+        for (int i = 2; i < argc; i++) {
+            if (!strcmp(argv[i], "-j")) json = true;
+            else                        count = atoi(argv[i]);
+        }
+        return emit(count, json);
+    }
+
+    return listen_loop();
+}
@@ -105,7 +105,7 @@ std::string highscores_input_name() {
 
     while (true) {
         Keys k;
-        input_poll(k);
+        input_read(k);
 
         if (k.left) {
             if (--index < 0) index = alphabet.size()-1;
@@ -11,7 +11,7 @@ MenuSel menu_loop(){
         gfx_text(80,100,"2. Editeur",COLOR_WHITE);
         gfx_text(80,120,"3. Scores",COLOR_WHITE);
         gfx_flush();
-        input_poll(k);
+        input_read(k);
         if(k.A){ if(sel==0) return MenuSel::Start; if(sel==1) return MenuSel::Editor; if(sel==2) return MenuSel::HighScores; }
     }
 }
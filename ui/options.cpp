@@ -77,3 +77,64 @@ void draw_options_menu(GameState::State state, int index)
 
     draw_item(210, "Retour", index == 5);
 }
+
+void draw_audio_debug_page()
+{
+    AudioStats st;
+    audio_get_stats(&st);
+
+    char buf[64];
+    uint32_t budget = st.budget_cycles ? st.budget_cycles : 1;
+
+    gfx_text(20, 10, "AUDIO DEBUG", COLOR_WHITE);
+
+    // Charge CPU d'un buffer par rapport au temps réel disponible
+    uint32_t load = (uint32_t)(st.update.avg * 100ULL / budget);
+    snprintf(buf, sizeof(buf), "Update %lu kcyc max %lu (%lu%%)",
+             (unsigned long)(st.update.avg / 1000), (unsigned long)(st.update.max / 1000),
+             (unsigned long)load);
+    gfx_text(20, 30, buf, load > 50 ? COLOR_ORANGE : COLOR_GREEN);
+
+    for (int i = 0; i < AUDIO_STAGE_COUNT; i++) {
+        snprintf(buf, sizeof(buf), " %-4s %lu kcyc max %lu", audio_stage_name(i),
+                 (unsigned long)(st.stage[i].avg / 1000), (unsigned long)(st.stage[i].max / 1000));
+        gfx_text(20, 44 + i * 12, buf, COLOR_WHITE);
+    }
+
+    // Histogramme : niveau de la FIFO vu par l'I2S (en buffers restants)
+    gfx_text(20, 88, "FIFO (buffers restants)", COLOR_WHITE);
+    uint32_t total = 0;
+    for (int i = 0; i <= GB_AUDIO_BUFFER_FIFO_COUNT; i++)
+        total += st.fifo_hist[i];
+    for (int i = 0; i <= GB_AUDIO_BUFFER_FIFO_COUNT; i++) {
+        uint32_t pct = total ? (uint32_t)(st.fifo_hist[i] * 100ULL / total) : 0;
+        char bar[21];
+        int n = (int)(pct / 5);
+        for (int b = 0; b < 20; b++)
+            bar[b] = b < n ? '#' : '.';
+        bar[20] = 0;
+        snprintf(buf, sizeof(buf), "%d %s %3lu%%", i, bar, (unsigned long)pct);
+        gfx_text(20, 102 + i * 12, buf, (i == 0 && pct) ? COLOR_RED : COLOR_LIGHTBLUE);
+    }
+
+    int y = 108 + (GB_AUDIO_BUFFER_FIFO_COUNT + 1) * 12;
+    snprintf(buf, sizeof(buf), "Underruns %lu  Overflows %lu  SD %lu",
+             (unsigned long)st.underruns, (unsigned long)st.overflows,
+             (unsigned long)st.stream_underruns);
+    gfx_text(20, y, buf, (st.underruns || st.stream_underruns) ? COLOR_RED : COLOR_WHITE);
+
+    snprintf(buf, sizeof(buf), "Voix: sfx %u musique %u autres %u",
+             st.voices_sfx, st.voices_music, st.voices_other);
+    gfx_text(20, y + 14, buf, COLOR_WHITE);
+
+    snprintf(buf, sizeof(buf), "SFX: groupes %lu voles %lu refus %lu",
+             (unsigned long)st.sfx_coalesced, (unsigned long)st.sfx_stolen,
+             (unsigned long)st.sfx_dropped);
+    gfx_text(20, y + 28, buf, COLOR_WHITE);
+
+    snprintf(buf, sizeof(buf), "Cible FIFO %lu/%d (gauche/droite)",
+             (unsigned long)audio_get_fifo_fill_target(), GB_AUDIO_BUFFER_FIFO_COUNT);
+    gfx_text(20, y + 42, buf, COLOR_YELLOW);
+
+    gfx_text(20, y + 56, "A: reset  B: retour", COLOR_GRAY);
+}
@@ -7,3 +7,6 @@ extern int nav_cooldown;
 
 void draw_options_menu(GameState::State state, int index);
 void handle_audio_options_navigation(const Keys& k, int& index);
+
+// Page debug audio (coûts CPU, FIFO, underruns, voix), cf. audio_get_stats()
+void draw_audio_debug_page();